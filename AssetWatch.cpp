@@ -0,0 +1,146 @@
+#include "AssetWatch.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+//local (to this file) data used by the watcher:
+namespace {
+	struct Watch {
+		std::string name;
+		std::function< void() > callback;
+	};
+
+	//all registered callbacks, by handle (handles increase, so this is also registration order):
+	std::map< uint32_t, Watch > watches;
+	uint32_t next_handle = 1;
+
+	//handles watching each file name, so a change only visits the relevant callbacks:
+	std::unordered_map< std::string, std::vector< uint32_t > > handles_by_name;
+
+	#if defined(__linux__)
+	int inotify_fd = -1;
+	#endif
+}
+
+void AssetWatch::init(std::string const &directory) {
+	char const *var = std::getenv("ASSET_WATCH");
+	if (var == nullptr || var[0] == '\0' || std::string(var) == "0") return;
+
+	#if defined(__linux__)
+	assert(inotify_fd == -1 && "AssetWatch::init should only be called once");
+	inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify_fd == -1) {
+		std::cerr << "NOTE: couldn't start inotify (" << std::strerror(errno) << "); asset hot-reload disabled." << std::endl;
+		return;
+	}
+	//n.b. exporters often write a temporary file and rename it into place, hence IN_MOVED_TO:
+	if (inotify_add_watch(inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+		std::cerr << "NOTE: couldn't watch '" << directory << "' (" << std::strerror(errno) << "); asset hot-reload disabled." << std::endl;
+		close(inotify_fd);
+		inotify_fd = -1;
+		return;
+	}
+	std::cout << "Watching '" << directory << "' for asset changes." << std::endl;
+	#else
+	(void)directory;
+	#endif
+}
+
+void AssetWatch::shutdown() {
+	#if defined(__linux__)
+	if (inotify_fd != -1) {
+		close(inotify_fd);
+		inotify_fd = -1;
+	}
+	#endif
+}
+
+bool AssetWatch::watching() {
+	#if defined(__linux__)
+	return inotify_fd != -1;
+	#else
+	return false;
+	#endif
+}
+
+uint32_t AssetWatch::watch(std::string const &name, std::function< void() > const &callback) {
+	uint32_t handle = next_handle++;
+	watches.emplace(handle, Watch{name, callback});
+	handles_by_name[name].emplace_back(handle);
+	return handle;
+}
+
+void AssetWatch::unwatch(uint32_t handle) {
+	auto f = watches.find(handle);
+	if (f == watches.end()) return;
+
+	auto &handles = handles_by_name[f->second.name];
+	for (auto hi = handles.begin(); hi != handles.end(); ++hi) {
+		if (*hi == handle) {
+			handles.erase(hi);
+			break;
+		}
+	}
+	if (handles.empty()) handles_by_name.erase(f->second.name);
+
+	watches.erase(f);
+}
+
+void AssetWatch::poll() {
+	//gather names of changed files:
+	// (a single save often produces several events, so collect them into a set)
+	std::set< std::string > changed;
+
+	#if defined(__linux__)
+	if (inotify_fd == -1) return;
+
+	//buffer aligned as recommended by 'man inotify':
+	alignas(alignof(struct inotify_event)) char buffer[4096];
+	for (;;) {
+		ssize_t got = read(inotify_fd, buffer, sizeof(buffer));
+		if (got <= 0) break; //(EAGAIN when no more events are pending)
+		for (char *at = buffer; at < buffer + got; ) {
+			struct inotify_event const *event = reinterpret_cast< struct inotify_event const * >(at);
+			if (event->len > 0) changed.emplace(event->name);
+			at += sizeof(struct inotify_event) + event->len;
+		}
+	}
+	#endif
+
+	for (auto const &name : changed) {
+		auto f = handles_by_name.find(name);
+		if (f == handles_by_name.end()) continue;
+
+		auto before = std::chrono::high_resolution_clock::now();
+
+		//copy handles, since callbacks may watch/unwatch:
+		std::vector< uint32_t > handles = f->second;
+		for (uint32_t handle : handles) {
+			auto w = watches.find(handle);
+			if (w == watches.end()) continue; //unwatched by an earlier callback
+			try {
+				w->second.callback();
+			} catch (std::exception const &e) {
+				std::cerr << "WARNING: failed to reload '" << name << "':\n" << e.what() << std::endl;
+			}
+		}
+
+		auto after = std::chrono::high_resolution_clock::now();
+		std::cout << "Reloaded '" << name << "' in " << std::chrono::duration< double, std::milli >(after - before).count() << " ms." << std::endl;
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+/*
+ * AssetWatch -- notices when asset files change on disk so they can be
+ *  re-loaded while the game is running ("hot reload").
+ *
+ * Uses inotify on Linux; on other platforms, the functions exist but no
+ *  changes are ever reported.
+ *
+ * Watching is off unless the ASSET_WATCH environment variable is set (to
+ *  anything but "0"), since a watched file may be rewritten while it is in use
+ *  and so can't be used in place (see map_wav_in_place in load_wav.hpp).
+ *
+ * //at load time:
+ * Load< MeshBuffer > meshes(LoadTagDefault, []() -> MeshBuffer const * {
+ *     MeshBuffer *ret = new MeshBuffer(data_path("level.pnct"));
+ *     AssetWatch::watch("level.pnct", [ret](){ ret->reload(data_path("level.pnct")); });
+ *     return ret;
+ * });
+ *
+ * Callbacks run (in the order they were registered) from AssetWatch::poll(),
+ *  which main.cpp calls once per frame, so they may freely use OpenGL.
+ * Only callbacks watching a changed file run, so the cost of a reload does
+ *  not depend on how many assets are being watched.
+ *
+ */
+
+#include <functional>
+#include <string>
+#include <cstdint>
+
+namespace AssetWatch {
+
+//start watching a directory (generally data_path("")) for changes, if ASSET_WATCH is set:
+// (call once from main.cpp; prints a note and continues if watching fails)
+void init(std::string const &directory);
+
+//stop watching:
+void shutdown();
+
+//is a directory being watched? (if so, files in it may be rewritten while the game is running)
+bool watching();
+
+//call 'callback' when the file 'name' (relative to the watched directory) changes:
+// returns a handle that can be passed to unwatch()
+// (exceptions thrown by the callback are reported and otherwise ignored)
+uint32_t watch(std::string const &name, std::function< void() > const &callback);
+
+//stop calling a callback registered with watch():
+void unwatch(uint32_t handle);
+
+//run callbacks for any files that changed since the last call to poll():
+// (call once per frame from main.cpp)
+void poll();
+
+} //namespace AssetWatch
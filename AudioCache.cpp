@@ -0,0 +1,151 @@
+#include "AudioCache.hpp"
+#include "data_path.hpp"
+
+#include <opusfile.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//local (to this file) helpers used by the cache:
+namespace {
+	//bump when the way decoded samples are produced (e.g., the downmix in load_opus.cpp) changes:
+	constexpr uint32_t const DECODER_VERSION = 1;
+
+	//each cache file is a header followed by the samples:
+	struct Header {
+		char magic[4] = {'p','c','m','f'}; //48kHz mono float pcm
+		uint32_t version = DECODER_VERSION;
+		uint64_t source_hash = 0; //hash of source contents
+		uint64_t source_size = 0; //size of source contents
+		uint64_t decoder_hash = 0; //hash of the decoder version
+		uint64_t count = 0; //number of samples that follow
+		uint8_t padding[24] = {}; //(keeps samples 64-byte aligned)
+	};
+	static_assert(sizeof(Header) == 64, "Header is packed and a cache line long");
+
+	//64-bit FNV-1a:
+	uint64_t hash_bytes(uint8_t const *data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL) {
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ data[i]) * 0x100000001b3ULL;
+		}
+		return hash;
+	}
+
+	uint64_t decoder_hash() {
+		static uint64_t hash = [](){
+			std::string version = std::string(opus_get_version_string()) + " / decoder " + std::to_string(DECODER_VERSION);
+			return hash_bytes(reinterpret_cast< uint8_t const * >(version.data()), version.size());
+		}();
+		return hash;
+	}
+
+	//cache directory (or "" if the cache is disabled):
+	std::string const &cache_directory() {
+		static std::string directory = [](){
+			std::string dir;
+			if (char const *env = std::getenv("AUDIO_CACHE")) {
+				if (std::string(env) == "0" || std::string(env) == "") return std::string("");
+				dir = env;
+			} else {
+				dir = data_path("audio-cache");
+			}
+			//Make sure directory exists... or at least try to!
+			#if defined(_WIN32)
+			_mkdir(dir.c_str());
+			#else
+			mkdir(dir.c_str(), 0755);
+			#endif
+			return dir;
+		}();
+		return directory;
+	}
+
+	//entries are named by source + decoder hash:
+	std::string entry_path(Header const &header) {
+		char name[40];
+		std::snprintf(name, sizeof(name), "%016llx.pcm", (unsigned long long)(header.source_hash ^ header.decoder_hash));
+		return cache_directory() + "/" + name;
+	}
+
+	Header make_header(ByteSpan const &source, size_t count) {
+		Header header;
+		header.source_hash = hash_bytes(source.data, source.size);
+		header.source_size = source.size;
+		header.decoder_hash = decoder_hash();
+		header.count = count;
+		return header;
+	}
+}
+
+std::shared_ptr< MappedFile const > AudioCache::find(ByteSpan const &source, float const **samples, size_t *count) {
+	if (cache_directory().empty()) return nullptr;
+
+	Header expected = make_header(source, 0);
+	std::string path = entry_path(expected);
+
+	std::shared_ptr< MappedFile const > mapped;
+	try {
+		mapped = std::make_shared< MappedFile >(path);
+	} catch (std::exception &) {
+		return nullptr; //(most likely not cached yet)
+	}
+
+	//check that the entry is really for this source and decoder, and complete:
+	Header header;
+	if (mapped->bytes.size < sizeof(Header)) return nullptr;
+	std::memcpy(&header, mapped->bytes.data, sizeof(Header));
+	if (std::memcmp(header.magic, expected.magic, 4) != 0
+	 || header.version != expected.version
+	 || header.source_hash != expected.source_hash
+	 || header.source_size != expected.source_size
+	 || header.decoder_hash != expected.decoder_hash
+	 || mapped->bytes.size != sizeof(Header) + header.count * sizeof(float)) {
+		std::cerr << "WARNING: ignoring stale or damaged audio cache entry '" << path << "'." << std::endl;
+		return nullptr;
+	}
+
+	*samples = reinterpret_cast< float const * >(mapped->bytes.data + sizeof(Header));
+	*count = size_t(header.count);
+	return mapped;
+}
+
+void AudioCache::store(ByteSpan const &source, float const *samples, size_t count) {
+	if (cache_directory().empty()) return;
+
+	Header header = make_header(source, count);
+	std::string path = entry_path(header);
+
+	//write to a temporary file and rename it into place, so other processes never map a partial entry:
+	#if defined(_WIN32)
+	std::string temp = path + ".tmp" + std::to_string(_getpid());
+	#else
+	std::string temp = path + ".tmp" + std::to_string(getpid());
+	#endif
+	{
+		std::ofstream out(temp, std::ios::binary);
+		out.write(reinterpret_cast< char const * >(&header), sizeof(header));
+		out.write(reinterpret_cast< char const * >(samples), count * sizeof(float));
+		if (!out) {
+			std::cerr << "WARNING: failed to write audio cache entry '" << temp << "'." << std::endl;
+			out.close();
+			std::remove(temp.c_str());
+			return;
+		}
+	}
+	if (std::rename(temp.c_str(), path.c_str()) != 0) {
+		//(on windows, rename fails if another process already stored this entry; that's fine)
+		std::remove(temp.c_str());
+	}
+}
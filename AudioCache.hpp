@@ -0,0 +1,36 @@
+#pragma once
+
+/*
+ * AudioCache -- a disk cache of decoded audio.
+ *
+ * Decoding '.opus' files takes a noticeable amount of CPU at every launch.
+ *  Instead, Sound::Sample stores the decoded 48kHz mono float samples for each
+ *  file in a cache directory and, on later runs, memory-maps them directly
+ *  (so loading costs almost no CPU, and pages are shared between processes).
+ *
+ * Entries are keyed by a hash of the encoded file's contents and of the decoder
+ *  version, so editing an asset or updating libopus simply misses the cache.
+ *
+ * The cache lives in data_path("audio-cache") by default; set the AUDIO_CACHE
+ *  environment variable to use another directory, or to '0' to disable it.
+ *
+ */
+
+#include "ByteSpan.hpp"
+#include "MappedFile.hpp"
+
+#include <memory>
+#include <string>
+
+namespace AudioCache {
+
+//look up decoded samples for 'source' (the contents of an encoded file):
+// on a hit, returns the mapped cache entry and points *samples / *count at the samples inside it;
+// on a miss (or if the cache is disabled), returns nullptr.
+std::shared_ptr< MappedFile const > find(ByteSpan const &source, float const **samples, size_t *count);
+
+//store decoded samples for 'source':
+// (failures -- e.g., a read-only directory -- are reported as warnings, since the cache is only an optimization)
+void store(ByteSpan const &source, float const *samples, size_t count);
+
+} //namespace AudioCache
@@ -0,0 +1,37 @@
+#pragma once
+
+/*
+ * A ByteSpan refers to a contiguous range of (not owned, not modified) bytes
+ *  in memory -- e.g., an asset embedded in the executable (see EmbeddedAssets.hpp).
+ *
+ * ByteSpanStream lets code that parses a std::istream read from a ByteSpan
+ *  without making a copy of the data.
+ *
+ */
+
+#include <istream>
+#include <streambuf>
+#include <cstdint>
+#include <cstddef>
+
+struct ByteSpan {
+	uint8_t const *data = nullptr;
+	size_t size = 0;
+
+	ByteSpan() = default;
+	ByteSpan(uint8_t const *data_, size_t size_) : data(data_), size(size_) { }
+};
+
+//streambuf that exposes a ByteSpan as its (only) get area:
+struct ByteSpanStreamBuf : std::streambuf {
+	ByteSpanStreamBuf(ByteSpan const &span) {
+		//n.b. std::streambuf wants non-const pointers, but never writes through the get area:
+		char *begin = const_cast< char * >(reinterpret_cast< char const * >(span.data));
+		setg(begin, begin, begin + span.size);
+	}
+};
+
+//(ByteSpanStreamBuf is a base class so that it is constructed before std::istream uses it)
+struct ByteSpanStream : private ByteSpanStreamBuf, public std::istream {
+	ByteSpanStream(ByteSpan const &span) : ByteSpanStreamBuf(span), std::istream(static_cast< std::streambuf * >(this)) { }
+};
@@ -1,6 +1,8 @@
 #include "ColorProgram.hpp"
 
+#include "GLState.hpp"
 #include "gl_compile_program.hpp"
+#include "gl_debug_output.hpp"
 #include "gl_errors.hpp"
 
 Load< ColorProgram > color_program(LoadTagEarly);
@@ -30,6 +32,8 @@ ColorProgram::ColorProgram() {
 	//As you can see above, adjacent strings in C/C++ are concatenated.
 	// this is very useful for writing long shader programs inline.
 
+	gl_label(GL_PROGRAM, program, "ColorProgram"); //(names it in debug messages)
+
 	//look up the locations of vertex attributes:
 	Position_vec4 = glGetAttribLocation(program, "Position");
 	Color_vec4 = glGetAttribLocation(program, "Color");
@@ -39,6 +43,7 @@ ColorProgram::ColorProgram() {
 }
 
 ColorProgram::~ColorProgram() {
+	GLState::forget_program(program);
 	glDeleteProgram(program);
 	program = 0;
 }
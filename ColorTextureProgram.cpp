@@ -1,6 +1,8 @@
 #include "ColorTextureProgram.hpp"
 
+#include "GLState.hpp"
 #include "gl_compile_program.hpp"
+#include "gl_debug_output.hpp"
 #include "gl_errors.hpp"
 
 Load< ColorTextureProgram > color_texture_program(LoadTagEarly);
@@ -35,6 +37,8 @@ ColorTextureProgram::ColorTextureProgram() {
 	//As you can see above, adjacent strings in C/C++ are concatenated.
 	// this is very useful for writing long shader programs inline.
 
+	gl_label(GL_PROGRAM, program, "ColorTextureProgram"); //(names it in debug messages)
+
 	//look up the locations of vertex attributes:
 	Position_vec4 = glGetAttribLocation(program, "Position");
 	Color_vec4 = glGetAttribLocation(program, "Color");
@@ -45,14 +49,15 @@ ColorTextureProgram::ColorTextureProgram() {
 	GLuint TEX_sampler2D = glGetUniformLocation(program, "TEX");
 
 	//set TEX to always refer to texture binding zero:
-	glUseProgram(program); //bind program -- glUniform* calls refer to this program now
+	GLState::use_program(program); //bind program -- glUniform* calls refer to this program now
 
 	glUniform1i(TEX_sampler2D, 0); //set TEX to sample from GL_TEXTURE0
 
-	glUseProgram(0); //unbind program -- glUniform* calls refer to ??? now
+	GLState::use_program(0); //unbind program -- glUniform* calls refer to ??? now
 }
 
 ColorTextureProgram::~ColorTextureProgram() {
+	GLState::forget_program(program);
 	glDeleteProgram(program);
 	program = 0;
 }
@@ -2,6 +2,8 @@
 #include "PathFont.hpp"
 #include "ColorProgram.hpp"
 
+#include "GLState.hpp"
+#include "gl_debug_output.hpp"
 #include "gl_errors.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
@@ -25,10 +27,14 @@ static Load< void > setup_buffers(LoadTagDefault, [](){
 		glGenVertexArrays(1, &vertex_buffer_for_color_program);
 
 		//set vertex_buffer_for_color_program as the current vertex array object:
-		glBindVertexArray(vertex_buffer_for_color_program);
+		GLState::bind_vertex_array(vertex_buffer_for_color_program);
 
 		//set vertex_buffer as the source of glVertexAttribPointer() commands:
-		glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+		GLState::bind_array_buffer(vertex_buffer);
+
+		//name both in debug messages (now that they've been bound, and so exist):
+		gl_label(GL_VERTEX_ARRAY, vertex_buffer_for_color_program, "DrawLines vertex array");
+		gl_label(GL_BUFFER, vertex_buffer, "DrawLines vertex buffer");
 
 		//set up the vertex array object to describe arrays of PongMode::Vertex:
 		glVertexAttribPointer(
@@ -53,10 +59,10 @@ static Load< void > setup_buffers(LoadTagDefault, [](){
 		glEnableVertexAttribArray(color_program->Color_vec4);
 
 		//done referring to vertex_buffer, so unbind it:
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GLState::bind_array_buffer(0);
 
 		//done setting up vertex array object, so unbind it:
-		glBindVertexArray(0);
+		GLState::bind_vertex_array(0);
 	}
 
 	GL_ERRORS(); //PARANOIA: make sure nothing strange happened during setup
@@ -137,28 +143,24 @@ DrawLines::~DrawLines() {
 
 	//based on DrawSprites.cpp :
 
+	//(state changes go through GLState, and are left in place afterward, so consecutive DrawLines -- and a Scene::draw
+	// using the same program -- don't re-bind anything)
+
 	//upload vertices to vertex_buffer:
-	glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer); //set vertex_buffer as current
+	GLState::bind_array_buffer(vertex_buffer); //set vertex_buffer as current
 	glBufferData(GL_ARRAY_BUFFER, attribs.size() * sizeof(attribs[0]), attribs.data(), GL_STREAM_DRAW); //upload attribs array
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	//set color_program as current program:
-	glUseProgram(color_program->program);
+	GLState::use_program(color_program->program);
 
 	//upload OBJECT_TO_CLIP to the proper uniform location:
 	glUniformMatrix4fv(color_program->OBJECT_TO_CLIP_mat4, 1, GL_FALSE, glm::value_ptr(world_to_clip));
 
 	//use the mapping vertex_buffer_for_color_program to fetch vertex data:
-	glBindVertexArray(vertex_buffer_for_color_program);
+	GLState::bind_vertex_array(vertex_buffer_for_color_program);
 
 	//run the OpenGL pipeline:
 	glDrawArrays(GL_LINES, 0, GLsizei(attribs.size()));
-
-	//reset vertex array to none:
-	glBindVertexArray(0);
-
-	//reset current program to none:
-	glUseProgram(0);
 }
 
 
@@ -0,0 +1,18 @@
+#include "EmbeddedAssets.hpp"
+
+#include <iostream>
+
+EmbeddedAssets::EmbeddedAssets(uint32_t count_, Asset const *assets_) : count(count_), assets(assets_) {
+	for (uint32_t i = 0; i < count; ++i) {
+		auto res = asset_map.insert(std::make_pair(std::string(assets[i].name), &assets[i].bytes));
+		if (!res.second) {
+			std::cerr << "WARNING: ignoring duplicate embedded asset '" << assets[i].name << "'." << std::endl;
+		}
+	}
+}
+
+ByteSpan const *EmbeddedAssets::find(std::string const &name) const {
+	auto f = asset_map.find(name);
+	if (f == asset_map.end()) return nullptr;
+	return f->second;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+/*
+ * EmbeddedAssets -- asset files compiled directly into the executable.
+ *
+ * The list of files to embed is given in Maekfile.js; at build time,
+ *  make-embedded-assets.py turns them into aligned constexpr byte arrays
+ *  (in a generated 'embedded-assets.cpp', just like make-PathFont-font.py
+ *  does for PathFont-font.cpp).
+ *
+ * Loading an embedded asset requires no file I/O, so critical boot assets
+ *  are available immediately even if the data directory is on slow storage:
+ *
+ * if (ByteSpan const *bytes = EmbeddedAssets::embedded.find("hexapod.scene")) {
+ *     scene.load(*bytes, "hexapod.scene", on_drawable);
+ * } else {
+ *     scene.load(data_path("hexapod.scene"), on_drawable);
+ * }
+ *
+ */
+
+#include "ByteSpan.hpp"
+
+#include <string>
+#include <map>
+
+struct EmbeddedAssets {
+	struct Asset {
+		char const *name; //path of the file relative to dist/
+		ByteSpan bytes; //contents of the file (aligned to 16 bytes)
+	};
+
+	//meant to be initialized with pointers to constant data:
+	EmbeddedAssets(uint32_t count, Asset const *assets);
+	const uint32_t count = 0;
+	Asset const *assets = nullptr;
+
+	//look up an asset by name:
+	// returns nullptr if no asset with that name was embedded.
+	ByteSpan const *find(std::string const &name) const;
+
+	//computed in constructor:
+	std::map< std::string, ByteSpan const * > asset_map;
+
+	//the assets embedded in this executable (defined in the generated embedded-assets.cpp):
+	static EmbeddedAssets embedded;
+};
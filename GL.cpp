@@ -1,3 +1,4 @@
+#define GL_NO_WRAPPERS //(see GL.hpp)
 #include "GL.hpp"
 
 #include <SDL.h>
@@ -584,3 +585,353 @@ void init_GL() {
 	 void (APIENTRYFP glVertexAttribP4ui) (GLuint index, GLenum type, GLboolean normalized, GLuint value);
 	 void (APIENTRYFP glVertexAttribP4uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
 #endif
+
+#ifdef GL_INSTRUMENT
+char const * const GLStats::call_names[GLStats::CallCount] = {
+	"glCullFace",
+	"glFrontFace",
+	"glHint",
+	"glLineWidth",
+	"glPointSize",
+	"glPolygonMode",
+	"glScissor",
+	"glTexParameterf",
+	"glTexParameterfv",
+	"glTexParameteri",
+	"glTexParameteriv",
+	"glTexImage1D",
+	"glTexImage2D",
+	"glDrawBuffer",
+	"glClear",
+	"glClearColor",
+	"glClearStencil",
+	"glClearDepth",
+	"glStencilMask",
+	"glColorMask",
+	"glDepthMask",
+	"glDisable",
+	"glEnable",
+	"glFinish",
+	"glFlush",
+	"glBlendFunc",
+	"glLogicOp",
+	"glStencilFunc",
+	"glStencilOp",
+	"glDepthFunc",
+	"glPixelStoref",
+	"glPixelStorei",
+	"glReadBuffer",
+	"glReadPixels",
+	"glGetBooleanv",
+	"glGetDoublev",
+	"glGetError",
+	"glGetFloatv",
+	"glGetIntegerv",
+	"glGetString",
+	"glGetTexImage",
+	"glGetTexParameterfv",
+	"glGetTexParameteriv",
+	"glGetTexLevelParameterfv",
+	"glGetTexLevelParameteriv",
+	"glIsEnabled",
+	"glDepthRange",
+	"glViewport",
+	"glDrawArrays",
+	"glDrawElements",
+	"glGetPointerv",
+	"glPolygonOffset",
+	"glCopyTexImage1D",
+	"glCopyTexImage2D",
+	"glCopyTexSubImage1D",
+	"glCopyTexSubImage2D",
+	"glTexSubImage1D",
+	"glTexSubImage2D",
+	"glBindTexture",
+	"glDeleteTextures",
+	"glGenTextures",
+	"glIsTexture",
+	"glDrawRangeElements",
+	"glTexImage3D",
+	"glTexSubImage3D",
+	"glCopyTexSubImage3D",
+	"glActiveTexture",
+	"glSampleCoverage",
+	"glCompressedTexImage3D",
+	"glCompressedTexImage2D",
+	"glCompressedTexImage1D",
+	"glCompressedTexSubImage3D",
+	"glCompressedTexSubImage2D",
+	"glCompressedTexSubImage1D",
+	"glGetCompressedTexImage",
+	"glBlendFuncSeparate",
+	"glMultiDrawArrays",
+	"glMultiDrawElements",
+	"glPointParameterf",
+	"glPointParameterfv",
+	"glPointParameteri",
+	"glPointParameteriv",
+	"glBlendColor",
+	"glBlendEquation",
+	"glGenQueries",
+	"glDeleteQueries",
+	"glIsQuery",
+	"glBeginQuery",
+	"glEndQuery",
+	"glGetQueryiv",
+	"glGetQueryObjectiv",
+	"glGetQueryObjectuiv",
+	"glBindBuffer",
+	"glDeleteBuffers",
+	"glGenBuffers",
+	"glIsBuffer",
+	"glBufferData",
+	"glBufferSubData",
+	"glGetBufferSubData",
+	"glMapBuffer",
+	"glUnmapBuffer",
+	"glGetBufferParameteriv",
+	"glGetBufferPointerv",
+	"glBlendEquationSeparate",
+	"glDrawBuffers",
+	"glStencilOpSeparate",
+	"glStencilFuncSeparate",
+	"glStencilMaskSeparate",
+	"glAttachShader",
+	"glBindAttribLocation",
+	"glCompileShader",
+	"glCreateProgram",
+	"glCreateShader",
+	"glDeleteProgram",
+	"glDeleteShader",
+	"glDetachShader",
+	"glDisableVertexAttribArray",
+	"glEnableVertexAttribArray",
+	"glGetActiveAttrib",
+	"glGetActiveUniform",
+	"glGetAttachedShaders",
+	"glGetAttribLocation",
+	"glGetProgramiv",
+	"glGetProgramInfoLog",
+	"glGetShaderiv",
+	"glGetShaderInfoLog",
+	"glGetShaderSource",
+	"glGetUniformLocation",
+	"glGetUniformfv",
+	"glGetUniformiv",
+	"glGetVertexAttribdv",
+	"glGetVertexAttribfv",
+	"glGetVertexAttribiv",
+	"glGetVertexAttribPointerv",
+	"glIsProgram",
+	"glIsShader",
+	"glLinkProgram",
+	"glShaderSource",
+	"glUseProgram",
+	"glUniform1f",
+	"glUniform2f",
+	"glUniform3f",
+	"glUniform4f",
+	"glUniform1i",
+	"glUniform2i",
+	"glUniform3i",
+	"glUniform4i",
+	"glUniform1fv",
+	"glUniform2fv",
+	"glUniform3fv",
+	"glUniform4fv",
+	"glUniform1iv",
+	"glUniform2iv",
+	"glUniform3iv",
+	"glUniform4iv",
+	"glUniformMatrix2fv",
+	"glUniformMatrix3fv",
+	"glUniformMatrix4fv",
+	"glValidateProgram",
+	"glVertexAttrib1d",
+	"glVertexAttrib1dv",
+	"glVertexAttrib1f",
+	"glVertexAttrib1fv",
+	"glVertexAttrib1s",
+	"glVertexAttrib1sv",
+	"glVertexAttrib2d",
+	"glVertexAttrib2dv",
+	"glVertexAttrib2f",
+	"glVertexAttrib2fv",
+	"glVertexAttrib2s",
+	"glVertexAttrib2sv",
+	"glVertexAttrib3d",
+	"glVertexAttrib3dv",
+	"glVertexAttrib3f",
+	"glVertexAttrib3fv",
+	"glVertexAttrib3s",
+	"glVertexAttrib3sv",
+	"glVertexAttrib4Nbv",
+	"glVertexAttrib4Niv",
+	"glVertexAttrib4Nsv",
+	"glVertexAttrib4Nub",
+	"glVertexAttrib4Nubv",
+	"glVertexAttrib4Nuiv",
+	"glVertexAttrib4Nusv",
+	"glVertexAttrib4bv",
+	"glVertexAttrib4d",
+	"glVertexAttrib4dv",
+	"glVertexAttrib4f",
+	"glVertexAttrib4fv",
+	"glVertexAttrib4iv",
+	"glVertexAttrib4s",
+	"glVertexAttrib4sv",
+	"glVertexAttrib4ubv",
+	"glVertexAttrib4uiv",
+	"glVertexAttrib4usv",
+	"glVertexAttribPointer",
+	"glUniformMatrix2x3fv",
+	"glUniformMatrix3x2fv",
+	"glUniformMatrix2x4fv",
+	"glUniformMatrix4x2fv",
+	"glUniformMatrix3x4fv",
+	"glUniformMatrix4x3fv",
+	"glColorMaski",
+	"glGetBooleani_v",
+	"glGetIntegeri_v",
+	"glEnablei",
+	"glDisablei",
+	"glIsEnabledi",
+	"glBeginTransformFeedback",
+	"glEndTransformFeedback",
+	"glBindBufferRange",
+	"glBindBufferBase",
+	"glTransformFeedbackVaryings",
+	"glGetTransformFeedbackVarying",
+	"glClampColor",
+	"glBeginConditionalRender",
+	"glEndConditionalRender",
+	"glVertexAttribIPointer",
+	"glGetVertexAttribIiv",
+	"glGetVertexAttribIuiv",
+	"glVertexAttribI1i",
+	"glVertexAttribI2i",
+	"glVertexAttribI3i",
+	"glVertexAttribI4i",
+	"glVertexAttribI1ui",
+	"glVertexAttribI2ui",
+	"glVertexAttribI3ui",
+	"glVertexAttribI4ui",
+	"glVertexAttribI1iv",
+	"glVertexAttribI2iv",
+	"glVertexAttribI3iv",
+	"glVertexAttribI4iv",
+	"glVertexAttribI1uiv",
+	"glVertexAttribI2uiv",
+	"glVertexAttribI3uiv",
+	"glVertexAttribI4uiv",
+	"glVertexAttribI4bv",
+	"glVertexAttribI4sv",
+	"glVertexAttribI4ubv",
+	"glVertexAttribI4usv",
+	"glGetUniformuiv",
+	"glBindFragDataLocation",
+	"glGetFragDataLocation",
+	"glUniform1ui",
+	"glUniform2ui",
+	"glUniform3ui",
+	"glUniform4ui",
+	"glUniform1uiv",
+	"glUniform2uiv",
+	"glUniform3uiv",
+	"glUniform4uiv",
+	"glTexParameterIiv",
+	"glTexParameterIuiv",
+	"glGetTexParameterIiv",
+	"glGetTexParameterIuiv",
+	"glClearBufferiv",
+	"glClearBufferuiv",
+	"glClearBufferfv",
+	"glClearBufferfi",
+	"glGetStringi",
+	"glIsRenderbuffer",
+	"glBindRenderbuffer",
+	"glDeleteRenderbuffers",
+	"glGenRenderbuffers",
+	"glRenderbufferStorage",
+	"glGetRenderbufferParameteriv",
+	"glIsFramebuffer",
+	"glBindFramebuffer",
+	"glDeleteFramebuffers",
+	"glGenFramebuffers",
+	"glCheckFramebufferStatus",
+	"glFramebufferTexture1D",
+	"glFramebufferTexture2D",
+	"glFramebufferTexture3D",
+	"glFramebufferRenderbuffer",
+	"glGetFramebufferAttachmentParameteriv",
+	"glGenerateMipmap",
+	"glBlitFramebuffer",
+	"glRenderbufferStorageMultisample",
+	"glFramebufferTextureLayer",
+	"glMapBufferRange",
+	"glFlushMappedBufferRange",
+	"glBindVertexArray",
+	"glDeleteVertexArrays",
+	"glGenVertexArrays",
+	"glIsVertexArray",
+	"glDrawArraysInstanced",
+	"glDrawElementsInstanced",
+	"glTexBuffer",
+	"glPrimitiveRestartIndex",
+	"glCopyBufferSubData",
+	"glGetUniformIndices",
+	"glGetActiveUniformsiv",
+	"glGetActiveUniformName",
+	"glGetUniformBlockIndex",
+	"glGetActiveUniformBlockiv",
+	"glGetActiveUniformBlockName",
+	"glUniformBlockBinding",
+	"glDrawElementsBaseVertex",
+	"glDrawRangeElementsBaseVertex",
+	"glDrawElementsInstancedBaseVertex",
+	"glMultiDrawElementsBaseVertex",
+	"glProvokingVertex",
+	"glFenceSync",
+	"glIsSync",
+	"glDeleteSync",
+	"glClientWaitSync",
+	"glWaitSync",
+	"glGetInteger64v",
+	"glGetSynciv",
+	"glGetInteger64i_v",
+	"glGetBufferParameteri64v",
+	"glFramebufferTexture",
+	"glTexImage2DMultisample",
+	"glTexImage3DMultisample",
+	"glGetMultisamplefv",
+	"glSampleMaski",
+	"glBindFragDataLocationIndexed",
+	"glGetFragDataIndex",
+	"glGenSamplers",
+	"glDeleteSamplers",
+	"glIsSampler",
+	"glBindSampler",
+	"glSamplerParameteri",
+	"glSamplerParameteriv",
+	"glSamplerParameterf",
+	"glSamplerParameterfv",
+	"glSamplerParameterIiv",
+	"glSamplerParameterIuiv",
+	"glGetSamplerParameteriv",
+	"glGetSamplerParameterIiv",
+	"glGetSamplerParameterfv",
+	"glGetSamplerParameterIuiv",
+	"glQueryCounter",
+	"glGetQueryObjecti64v",
+	"glGetQueryObjectui64v",
+	"glVertexAttribDivisor",
+	"glVertexAttribP1ui",
+	"glVertexAttribP1uiv",
+	"glVertexAttribP2ui",
+	"glVertexAttribP2uiv",
+	"glVertexAttribP3ui",
+	"glVertexAttribP3uiv",
+	"glVertexAttribP4ui",
+	"glVertexAttribP4uiv",
+};
+#endif
@@ -1277,3 +1277,1068 @@ GLAPI void (APIENTRYFP glVertexAttribP4ui) (GLuint index, GLenum type, GLboolean
 GLAPI void (APIENTRYFP glVertexAttribP4uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
 
 }
+
+//------------------------------------------------
+//Call instrumentation, compiled in only when GL_INSTRUMENT is defined (see GLStats.hpp):
+// each gl* name above is redirected to an inline wrapper that counts the call
+// (and notes bytes uploaded and primitives drawn) before calling through.
+
+#ifdef GL_INSTRUMENT
+
+#include <stddef.h>
+
+namespace GLStats {
+	//one counter per entry point:
+	enum Call : uint32_t {
+		Call_glCullFace,
+		Call_glFrontFace,
+		Call_glHint,
+		Call_glLineWidth,
+		Call_glPointSize,
+		Call_glPolygonMode,
+		Call_glScissor,
+		Call_glTexParameterf,
+		Call_glTexParameterfv,
+		Call_glTexParameteri,
+		Call_glTexParameteriv,
+		Call_glTexImage1D,
+		Call_glTexImage2D,
+		Call_glDrawBuffer,
+		Call_glClear,
+		Call_glClearColor,
+		Call_glClearStencil,
+		Call_glClearDepth,
+		Call_glStencilMask,
+		Call_glColorMask,
+		Call_glDepthMask,
+		Call_glDisable,
+		Call_glEnable,
+		Call_glFinish,
+		Call_glFlush,
+		Call_glBlendFunc,
+		Call_glLogicOp,
+		Call_glStencilFunc,
+		Call_glStencilOp,
+		Call_glDepthFunc,
+		Call_glPixelStoref,
+		Call_glPixelStorei,
+		Call_glReadBuffer,
+		Call_glReadPixels,
+		Call_glGetBooleanv,
+		Call_glGetDoublev,
+		Call_glGetError,
+		Call_glGetFloatv,
+		Call_glGetIntegerv,
+		Call_glGetString,
+		Call_glGetTexImage,
+		Call_glGetTexParameterfv,
+		Call_glGetTexParameteriv,
+		Call_glGetTexLevelParameterfv,
+		Call_glGetTexLevelParameteriv,
+		Call_glIsEnabled,
+		Call_glDepthRange,
+		Call_glViewport,
+		Call_glDrawArrays,
+		Call_glDrawElements,
+		Call_glGetPointerv,
+		Call_glPolygonOffset,
+		Call_glCopyTexImage1D,
+		Call_glCopyTexImage2D,
+		Call_glCopyTexSubImage1D,
+		Call_glCopyTexSubImage2D,
+		Call_glTexSubImage1D,
+		Call_glTexSubImage2D,
+		Call_glBindTexture,
+		Call_glDeleteTextures,
+		Call_glGenTextures,
+		Call_glIsTexture,
+		Call_glDrawRangeElements,
+		Call_glTexImage3D,
+		Call_glTexSubImage3D,
+		Call_glCopyTexSubImage3D,
+		Call_glActiveTexture,
+		Call_glSampleCoverage,
+		Call_glCompressedTexImage3D,
+		Call_glCompressedTexImage2D,
+		Call_glCompressedTexImage1D,
+		Call_glCompressedTexSubImage3D,
+		Call_glCompressedTexSubImage2D,
+		Call_glCompressedTexSubImage1D,
+		Call_glGetCompressedTexImage,
+		Call_glBlendFuncSeparate,
+		Call_glMultiDrawArrays,
+		Call_glMultiDrawElements,
+		Call_glPointParameterf,
+		Call_glPointParameterfv,
+		Call_glPointParameteri,
+		Call_glPointParameteriv,
+		Call_glBlendColor,
+		Call_glBlendEquation,
+		Call_glGenQueries,
+		Call_glDeleteQueries,
+		Call_glIsQuery,
+		Call_glBeginQuery,
+		Call_glEndQuery,
+		Call_glGetQueryiv,
+		Call_glGetQueryObjectiv,
+		Call_glGetQueryObjectuiv,
+		Call_glBindBuffer,
+		Call_glDeleteBuffers,
+		Call_glGenBuffers,
+		Call_glIsBuffer,
+		Call_glBufferData,
+		Call_glBufferSubData,
+		Call_glGetBufferSubData,
+		Call_glMapBuffer,
+		Call_glUnmapBuffer,
+		Call_glGetBufferParameteriv,
+		Call_glGetBufferPointerv,
+		Call_glBlendEquationSeparate,
+		Call_glDrawBuffers,
+		Call_glStencilOpSeparate,
+		Call_glStencilFuncSeparate,
+		Call_glStencilMaskSeparate,
+		Call_glAttachShader,
+		Call_glBindAttribLocation,
+		Call_glCompileShader,
+		Call_glCreateProgram,
+		Call_glCreateShader,
+		Call_glDeleteProgram,
+		Call_glDeleteShader,
+		Call_glDetachShader,
+		Call_glDisableVertexAttribArray,
+		Call_glEnableVertexAttribArray,
+		Call_glGetActiveAttrib,
+		Call_glGetActiveUniform,
+		Call_glGetAttachedShaders,
+		Call_glGetAttribLocation,
+		Call_glGetProgramiv,
+		Call_glGetProgramInfoLog,
+		Call_glGetShaderiv,
+		Call_glGetShaderInfoLog,
+		Call_glGetShaderSource,
+		Call_glGetUniformLocation,
+		Call_glGetUniformfv,
+		Call_glGetUniformiv,
+		Call_glGetVertexAttribdv,
+		Call_glGetVertexAttribfv,
+		Call_glGetVertexAttribiv,
+		Call_glGetVertexAttribPointerv,
+		Call_glIsProgram,
+		Call_glIsShader,
+		Call_glLinkProgram,
+		Call_glShaderSource,
+		Call_glUseProgram,
+		Call_glUniform1f,
+		Call_glUniform2f,
+		Call_glUniform3f,
+		Call_glUniform4f,
+		Call_glUniform1i,
+		Call_glUniform2i,
+		Call_glUniform3i,
+		Call_glUniform4i,
+		Call_glUniform1fv,
+		Call_glUniform2fv,
+		Call_glUniform3fv,
+		Call_glUniform4fv,
+		Call_glUniform1iv,
+		Call_glUniform2iv,
+		Call_glUniform3iv,
+		Call_glUniform4iv,
+		Call_glUniformMatrix2fv,
+		Call_glUniformMatrix3fv,
+		Call_glUniformMatrix4fv,
+		Call_glValidateProgram,
+		Call_glVertexAttrib1d,
+		Call_glVertexAttrib1dv,
+		Call_glVertexAttrib1f,
+		Call_glVertexAttrib1fv,
+		Call_glVertexAttrib1s,
+		Call_glVertexAttrib1sv,
+		Call_glVertexAttrib2d,
+		Call_glVertexAttrib2dv,
+		Call_glVertexAttrib2f,
+		Call_glVertexAttrib2fv,
+		Call_glVertexAttrib2s,
+		Call_glVertexAttrib2sv,
+		Call_glVertexAttrib3d,
+		Call_glVertexAttrib3dv,
+		Call_glVertexAttrib3f,
+		Call_glVertexAttrib3fv,
+		Call_glVertexAttrib3s,
+		Call_glVertexAttrib3sv,
+		Call_glVertexAttrib4Nbv,
+		Call_glVertexAttrib4Niv,
+		Call_glVertexAttrib4Nsv,
+		Call_glVertexAttrib4Nub,
+		Call_glVertexAttrib4Nubv,
+		Call_glVertexAttrib4Nuiv,
+		Call_glVertexAttrib4Nusv,
+		Call_glVertexAttrib4bv,
+		Call_glVertexAttrib4d,
+		Call_glVertexAttrib4dv,
+		Call_glVertexAttrib4f,
+		Call_glVertexAttrib4fv,
+		Call_glVertexAttrib4iv,
+		Call_glVertexAttrib4s,
+		Call_glVertexAttrib4sv,
+		Call_glVertexAttrib4ubv,
+		Call_glVertexAttrib4uiv,
+		Call_glVertexAttrib4usv,
+		Call_glVertexAttribPointer,
+		Call_glUniformMatrix2x3fv,
+		Call_glUniformMatrix3x2fv,
+		Call_glUniformMatrix2x4fv,
+		Call_glUniformMatrix4x2fv,
+		Call_glUniformMatrix3x4fv,
+		Call_glUniformMatrix4x3fv,
+		Call_glColorMaski,
+		Call_glGetBooleani_v,
+		Call_glGetIntegeri_v,
+		Call_glEnablei,
+		Call_glDisablei,
+		Call_glIsEnabledi,
+		Call_glBeginTransformFeedback,
+		Call_glEndTransformFeedback,
+		Call_glBindBufferRange,
+		Call_glBindBufferBase,
+		Call_glTransformFeedbackVaryings,
+		Call_glGetTransformFeedbackVarying,
+		Call_glClampColor,
+		Call_glBeginConditionalRender,
+		Call_glEndConditionalRender,
+		Call_glVertexAttribIPointer,
+		Call_glGetVertexAttribIiv,
+		Call_glGetVertexAttribIuiv,
+		Call_glVertexAttribI1i,
+		Call_glVertexAttribI2i,
+		Call_glVertexAttribI3i,
+		Call_glVertexAttribI4i,
+		Call_glVertexAttribI1ui,
+		Call_glVertexAttribI2ui,
+		Call_glVertexAttribI3ui,
+		Call_glVertexAttribI4ui,
+		Call_glVertexAttribI1iv,
+		Call_glVertexAttribI2iv,
+		Call_glVertexAttribI3iv,
+		Call_glVertexAttribI4iv,
+		Call_glVertexAttribI1uiv,
+		Call_glVertexAttribI2uiv,
+		Call_glVertexAttribI3uiv,
+		Call_glVertexAttribI4uiv,
+		Call_glVertexAttribI4bv,
+		Call_glVertexAttribI4sv,
+		Call_glVertexAttribI4ubv,
+		Call_glVertexAttribI4usv,
+		Call_glGetUniformuiv,
+		Call_glBindFragDataLocation,
+		Call_glGetFragDataLocation,
+		Call_glUniform1ui,
+		Call_glUniform2ui,
+		Call_glUniform3ui,
+		Call_glUniform4ui,
+		Call_glUniform1uiv,
+		Call_glUniform2uiv,
+		Call_glUniform3uiv,
+		Call_glUniform4uiv,
+		Call_glTexParameterIiv,
+		Call_glTexParameterIuiv,
+		Call_glGetTexParameterIiv,
+		Call_glGetTexParameterIuiv,
+		Call_glClearBufferiv,
+		Call_glClearBufferuiv,
+		Call_glClearBufferfv,
+		Call_glClearBufferfi,
+		Call_glGetStringi,
+		Call_glIsRenderbuffer,
+		Call_glBindRenderbuffer,
+		Call_glDeleteRenderbuffers,
+		Call_glGenRenderbuffers,
+		Call_glRenderbufferStorage,
+		Call_glGetRenderbufferParameteriv,
+		Call_glIsFramebuffer,
+		Call_glBindFramebuffer,
+		Call_glDeleteFramebuffers,
+		Call_glGenFramebuffers,
+		Call_glCheckFramebufferStatus,
+		Call_glFramebufferTexture1D,
+		Call_glFramebufferTexture2D,
+		Call_glFramebufferTexture3D,
+		Call_glFramebufferRenderbuffer,
+		Call_glGetFramebufferAttachmentParameteriv,
+		Call_glGenerateMipmap,
+		Call_glBlitFramebuffer,
+		Call_glRenderbufferStorageMultisample,
+		Call_glFramebufferTextureLayer,
+		Call_glMapBufferRange,
+		Call_glFlushMappedBufferRange,
+		Call_glBindVertexArray,
+		Call_glDeleteVertexArrays,
+		Call_glGenVertexArrays,
+		Call_glIsVertexArray,
+		Call_glDrawArraysInstanced,
+		Call_glDrawElementsInstanced,
+		Call_glTexBuffer,
+		Call_glPrimitiveRestartIndex,
+		Call_glCopyBufferSubData,
+		Call_glGetUniformIndices,
+		Call_glGetActiveUniformsiv,
+		Call_glGetActiveUniformName,
+		Call_glGetUniformBlockIndex,
+		Call_glGetActiveUniformBlockiv,
+		Call_glGetActiveUniformBlockName,
+		Call_glUniformBlockBinding,
+		Call_glDrawElementsBaseVertex,
+		Call_glDrawRangeElementsBaseVertex,
+		Call_glDrawElementsInstancedBaseVertex,
+		Call_glMultiDrawElementsBaseVertex,
+		Call_glProvokingVertex,
+		Call_glFenceSync,
+		Call_glIsSync,
+		Call_glDeleteSync,
+		Call_glClientWaitSync,
+		Call_glWaitSync,
+		Call_glGetInteger64v,
+		Call_glGetSynciv,
+		Call_glGetInteger64i_v,
+		Call_glGetBufferParameteri64v,
+		Call_glFramebufferTexture,
+		Call_glTexImage2DMultisample,
+		Call_glTexImage3DMultisample,
+		Call_glGetMultisamplefv,
+		Call_glSampleMaski,
+		Call_glBindFragDataLocationIndexed,
+		Call_glGetFragDataIndex,
+		Call_glGenSamplers,
+		Call_glDeleteSamplers,
+		Call_glIsSampler,
+		Call_glBindSampler,
+		Call_glSamplerParameteri,
+		Call_glSamplerParameteriv,
+		Call_glSamplerParameterf,
+		Call_glSamplerParameterfv,
+		Call_glSamplerParameterIiv,
+		Call_glSamplerParameterIuiv,
+		Call_glGetSamplerParameteriv,
+		Call_glGetSamplerParameterIiv,
+		Call_glGetSamplerParameterfv,
+		Call_glGetSamplerParameterIuiv,
+		Call_glQueryCounter,
+		Call_glGetQueryObjecti64v,
+		Call_glGetQueryObjectui64v,
+		Call_glVertexAttribDivisor,
+		Call_glVertexAttribP1ui,
+		Call_glVertexAttribP1uiv,
+		Call_glVertexAttribP2ui,
+		Call_glVertexAttribP2uiv,
+		Call_glVertexAttribP3ui,
+		Call_glVertexAttribP3uiv,
+		Call_glVertexAttribP4ui,
+		Call_glVertexAttribP4uiv,
+		CallCount
+	};
+	extern char const * const call_names[CallCount];
+
+	//counts for the frame in progress (see GLStats.cpp):
+	extern uint32_t calls[CallCount];
+	void note_upload(size_t bytes);
+	void note_image_upload(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels);
+	void note_draw(GLenum mode, GLsizei count, GLsizei instances);
+}
+
+inline void instrumented_glCullFace (GLenum mode) { GLStats::calls[GLStats::Call_glCullFace] += 1; glCullFace(mode); }
+inline void instrumented_glFrontFace (GLenum mode) { GLStats::calls[GLStats::Call_glFrontFace] += 1; glFrontFace(mode); }
+inline void instrumented_glHint (GLenum target, GLenum mode) { GLStats::calls[GLStats::Call_glHint] += 1; glHint(target, mode); }
+inline void instrumented_glLineWidth (GLfloat width) { GLStats::calls[GLStats::Call_glLineWidth] += 1; glLineWidth(width); }
+inline void instrumented_glPointSize (GLfloat size) { GLStats::calls[GLStats::Call_glPointSize] += 1; glPointSize(size); }
+inline void instrumented_glPolygonMode (GLenum face, GLenum mode) { GLStats::calls[GLStats::Call_glPolygonMode] += 1; glPolygonMode(face, mode); }
+inline void instrumented_glScissor (GLint x, GLint y, GLsizei width, GLsizei height) { GLStats::calls[GLStats::Call_glScissor] += 1; glScissor(x, y, width, height); }
+inline void instrumented_glTexParameterf (GLenum target, GLenum pname, GLfloat param) { GLStats::calls[GLStats::Call_glTexParameterf] += 1; glTexParameterf(target, pname, param); }
+inline void instrumented_glTexParameterfv (GLenum target, GLenum pname, const GLfloat *params) { GLStats::calls[GLStats::Call_glTexParameterfv] += 1; glTexParameterfv(target, pname, params); }
+inline void instrumented_glTexParameteri (GLenum target, GLenum pname, GLint param) { GLStats::calls[GLStats::Call_glTexParameteri] += 1; glTexParameteri(target, pname, param); }
+inline void instrumented_glTexParameteriv (GLenum target, GLenum pname, const GLint *params) { GLStats::calls[GLStats::Call_glTexParameteriv] += 1; glTexParameteriv(target, pname, params); }
+inline void instrumented_glTexImage1D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void *pixels) { GLStats::calls[GLStats::Call_glTexImage1D] += 1; GLStats::note_image_upload(width, 1, 1, format, type, pixels); glTexImage1D(target, level, internalformat, width, border, format, type, pixels); }
+inline void instrumented_glTexImage2D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels) { GLStats::calls[GLStats::Call_glTexImage2D] += 1; GLStats::note_image_upload(width, height, 1, format, type, pixels); glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels); }
+inline void instrumented_glDrawBuffer (GLenum buf) { GLStats::calls[GLStats::Call_glDrawBuffer] += 1; glDrawBuffer(buf); }
+inline void instrumented_glClear (GLbitfield mask) { GLStats::calls[GLStats::Call_glClear] += 1; glClear(mask); }
+inline void instrumented_glClearColor (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) { GLStats::calls[GLStats::Call_glClearColor] += 1; glClearColor(red, green, blue, alpha); }
+inline void instrumented_glClearStencil (GLint s) { GLStats::calls[GLStats::Call_glClearStencil] += 1; glClearStencil(s); }
+inline void instrumented_glClearDepth (GLdouble depth) { GLStats::calls[GLStats::Call_glClearDepth] += 1; glClearDepth(depth); }
+inline void instrumented_glStencilMask (GLuint mask) { GLStats::calls[GLStats::Call_glStencilMask] += 1; glStencilMask(mask); }
+inline void instrumented_glColorMask (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) { GLStats::calls[GLStats::Call_glColorMask] += 1; glColorMask(red, green, blue, alpha); }
+inline void instrumented_glDepthMask (GLboolean flag) { GLStats::calls[GLStats::Call_glDepthMask] += 1; glDepthMask(flag); }
+inline void instrumented_glDisable (GLenum cap) { GLStats::calls[GLStats::Call_glDisable] += 1; glDisable(cap); }
+inline void instrumented_glEnable (GLenum cap) { GLStats::calls[GLStats::Call_glEnable] += 1; glEnable(cap); }
+inline void instrumented_glFinish (void) { GLStats::calls[GLStats::Call_glFinish] += 1; glFinish(); }
+inline void instrumented_glFlush (void) { GLStats::calls[GLStats::Call_glFlush] += 1; glFlush(); }
+inline void instrumented_glBlendFunc (GLenum sfactor, GLenum dfactor) { GLStats::calls[GLStats::Call_glBlendFunc] += 1; glBlendFunc(sfactor, dfactor); }
+inline void instrumented_glLogicOp (GLenum opcode) { GLStats::calls[GLStats::Call_glLogicOp] += 1; glLogicOp(opcode); }
+inline void instrumented_glStencilFunc (GLenum func, GLint ref, GLuint mask) { GLStats::calls[GLStats::Call_glStencilFunc] += 1; glStencilFunc(func, ref, mask); }
+inline void instrumented_glStencilOp (GLenum fail, GLenum zfail, GLenum zpass) { GLStats::calls[GLStats::Call_glStencilOp] += 1; glStencilOp(fail, zfail, zpass); }
+inline void instrumented_glDepthFunc (GLenum func) { GLStats::calls[GLStats::Call_glDepthFunc] += 1; glDepthFunc(func); }
+inline void instrumented_glPixelStoref (GLenum pname, GLfloat param) { GLStats::calls[GLStats::Call_glPixelStoref] += 1; glPixelStoref(pname, param); }
+inline void instrumented_glPixelStorei (GLenum pname, GLint param) { GLStats::calls[GLStats::Call_glPixelStorei] += 1; glPixelStorei(pname, param); }
+inline void instrumented_glReadBuffer (GLenum src) { GLStats::calls[GLStats::Call_glReadBuffer] += 1; glReadBuffer(src); }
+inline void instrumented_glReadPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels) { GLStats::calls[GLStats::Call_glReadPixels] += 1; glReadPixels(x, y, width, height, format, type, pixels); }
+inline void instrumented_glGetBooleanv (GLenum pname, GLboolean *data) { GLStats::calls[GLStats::Call_glGetBooleanv] += 1; glGetBooleanv(pname, data); }
+inline void instrumented_glGetDoublev (GLenum pname, GLdouble *data) { GLStats::calls[GLStats::Call_glGetDoublev] += 1; glGetDoublev(pname, data); }
+inline GLenum instrumented_glGetError (void) { GLStats::calls[GLStats::Call_glGetError] += 1; return glGetError(); }
+inline void instrumented_glGetFloatv (GLenum pname, GLfloat *data) { GLStats::calls[GLStats::Call_glGetFloatv] += 1; glGetFloatv(pname, data); }
+inline void instrumented_glGetIntegerv (GLenum pname, GLint *data) { GLStats::calls[GLStats::Call_glGetIntegerv] += 1; glGetIntegerv(pname, data); }
+inline const GLubyte * instrumented_glGetString (GLenum name) { GLStats::calls[GLStats::Call_glGetString] += 1; return glGetString(name); }
+inline void instrumented_glGetTexImage (GLenum target, GLint level, GLenum format, GLenum type, void *pixels) { GLStats::calls[GLStats::Call_glGetTexImage] += 1; glGetTexImage(target, level, format, type, pixels); }
+inline void instrumented_glGetTexParameterfv (GLenum target, GLenum pname, GLfloat *params) { GLStats::calls[GLStats::Call_glGetTexParameterfv] += 1; glGetTexParameterfv(target, pname, params); }
+inline void instrumented_glGetTexParameteriv (GLenum target, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetTexParameteriv] += 1; glGetTexParameteriv(target, pname, params); }
+inline void instrumented_glGetTexLevelParameterfv (GLenum target, GLint level, GLenum pname, GLfloat *params) { GLStats::calls[GLStats::Call_glGetTexLevelParameterfv] += 1; glGetTexLevelParameterfv(target, level, pname, params); }
+inline void instrumented_glGetTexLevelParameteriv (GLenum target, GLint level, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetTexLevelParameteriv] += 1; glGetTexLevelParameteriv(target, level, pname, params); }
+inline GLboolean instrumented_glIsEnabled (GLenum cap) { GLStats::calls[GLStats::Call_glIsEnabled] += 1; return glIsEnabled(cap); }
+inline void instrumented_glDepthRange (GLdouble n, GLdouble f) { GLStats::calls[GLStats::Call_glDepthRange] += 1; glDepthRange(n, f); }
+inline void instrumented_glViewport (GLint x, GLint y, GLsizei width, GLsizei height) { GLStats::calls[GLStats::Call_glViewport] += 1; glViewport(x, y, width, height); }
+inline void instrumented_glDrawArrays (GLenum mode, GLint first, GLsizei count) { GLStats::calls[GLStats::Call_glDrawArrays] += 1; GLStats::note_draw(mode, count, 1); glDrawArrays(mode, first, count); }
+inline void instrumented_glDrawElements (GLenum mode, GLsizei count, GLenum type, const void *indices) { GLStats::calls[GLStats::Call_glDrawElements] += 1; GLStats::note_draw(mode, count, 1); glDrawElements(mode, count, type, indices); }
+inline void instrumented_glGetPointerv (GLenum pname, void **params) { GLStats::calls[GLStats::Call_glGetPointerv] += 1; glGetPointerv(pname, params); }
+inline void instrumented_glPolygonOffset (GLfloat factor, GLfloat units) { GLStats::calls[GLStats::Call_glPolygonOffset] += 1; glPolygonOffset(factor, units); }
+inline void instrumented_glCopyTexImage1D (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border) { GLStats::calls[GLStats::Call_glCopyTexImage1D] += 1; glCopyTexImage1D(target, level, internalformat, x, y, width, border); }
+inline void instrumented_glCopyTexImage2D (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) { GLStats::calls[GLStats::Call_glCopyTexImage2D] += 1; glCopyTexImage2D(target, level, internalformat, x, y, width, height, border); }
+inline void instrumented_glCopyTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width) { GLStats::calls[GLStats::Call_glCopyTexSubImage1D] += 1; glCopyTexSubImage1D(target, level, xoffset, x, y, width); }
+inline void instrumented_glCopyTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) { GLStats::calls[GLStats::Call_glCopyTexSubImage2D] += 1; glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height); }
+inline void instrumented_glTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels) { GLStats::calls[GLStats::Call_glTexSubImage1D] += 1; GLStats::note_image_upload(width, 1, 1, format, type, pixels); glTexSubImage1D(target, level, xoffset, width, format, type, pixels); }
+inline void instrumented_glTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels) { GLStats::calls[GLStats::Call_glTexSubImage2D] += 1; GLStats::note_image_upload(width, height, 1, format, type, pixels); glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels); }
+inline void instrumented_glBindTexture (GLenum target, GLuint texture) { GLStats::calls[GLStats::Call_glBindTexture] += 1; glBindTexture(target, texture); }
+inline void instrumented_glDeleteTextures (GLsizei n, const GLuint *textures) { GLStats::calls[GLStats::Call_glDeleteTextures] += 1; glDeleteTextures(n, textures); }
+inline void instrumented_glGenTextures (GLsizei n, GLuint *textures) { GLStats::calls[GLStats::Call_glGenTextures] += 1; glGenTextures(n, textures); }
+inline GLboolean instrumented_glIsTexture (GLuint texture) { GLStats::calls[GLStats::Call_glIsTexture] += 1; return glIsTexture(texture); }
+inline void instrumented_glDrawRangeElements (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices) { GLStats::calls[GLStats::Call_glDrawRangeElements] += 1; GLStats::note_draw(mode, count, 1); glDrawRangeElements(mode, start, end, count, type, indices); }
+inline void instrumented_glTexImage3D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels) { GLStats::calls[GLStats::Call_glTexImage3D] += 1; GLStats::note_image_upload(width, height, depth, format, type, pixels); glTexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels); }
+inline void instrumented_glTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels) { GLStats::calls[GLStats::Call_glTexSubImage3D] += 1; GLStats::note_image_upload(width, height, depth, format, type, pixels); glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels); }
+inline void instrumented_glCopyTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height) { GLStats::calls[GLStats::Call_glCopyTexSubImage3D] += 1; glCopyTexSubImage3D(target, level, xoffset, yoffset, zoffset, x, y, width, height); }
+inline void instrumented_glActiveTexture (GLenum texture) { GLStats::calls[GLStats::Call_glActiveTexture] += 1; glActiveTexture(texture); }
+inline void instrumented_glSampleCoverage (GLfloat value, GLboolean invert) { GLStats::calls[GLStats::Call_glSampleCoverage] += 1; glSampleCoverage(value, invert); }
+inline void instrumented_glCompressedTexImage3D (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void *data) { GLStats::calls[GLStats::Call_glCompressedTexImage3D] += 1; if (data) GLStats::note_upload(size_t(imageSize)); glCompressedTexImage3D(target, level, internalformat, width, height, depth, border, imageSize, data); }
+inline void instrumented_glCompressedTexImage2D (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data) { GLStats::calls[GLStats::Call_glCompressedTexImage2D] += 1; if (data) GLStats::note_upload(size_t(imageSize)); glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data); }
+inline void instrumented_glCompressedTexImage1D (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void *data) { GLStats::calls[GLStats::Call_glCompressedTexImage1D] += 1; if (data) GLStats::note_upload(size_t(imageSize)); glCompressedTexImage1D(target, level, internalformat, width, border, imageSize, data); }
+inline void instrumented_glCompressedTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data) { GLStats::calls[GLStats::Call_glCompressedTexSubImage3D] += 1; if (data) GLStats::note_upload(size_t(imageSize)); glCompressedTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data); }
+inline void instrumented_glCompressedTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data) { GLStats::calls[GLStats::Call_glCompressedTexSubImage2D] += 1; if (data) GLStats::note_upload(size_t(imageSize)); glCompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data); }
+inline void instrumented_glCompressedTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data) { GLStats::calls[GLStats::Call_glCompressedTexSubImage1D] += 1; if (data) GLStats::note_upload(size_t(imageSize)); glCompressedTexSubImage1D(target, level, xoffset, width, format, imageSize, data); }
+inline void instrumented_glGetCompressedTexImage (GLenum target, GLint level, void *img) { GLStats::calls[GLStats::Call_glGetCompressedTexImage] += 1; glGetCompressedTexImage(target, level, img); }
+inline void instrumented_glBlendFuncSeparate (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) { GLStats::calls[GLStats::Call_glBlendFuncSeparate] += 1; glBlendFuncSeparate(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha); }
+inline void instrumented_glMultiDrawArrays (GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount) { GLStats::calls[GLStats::Call_glMultiDrawArrays] += 1; for (GLsizei i = 0; i < drawcount; ++i) GLStats::note_draw(mode, count[i], 1); glMultiDrawArrays(mode, first, count, drawcount); }
+inline void instrumented_glMultiDrawElements (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount) { GLStats::calls[GLStats::Call_glMultiDrawElements] += 1; for (GLsizei i = 0; i < drawcount; ++i) GLStats::note_draw(mode, count[i], 1); glMultiDrawElements(mode, count, type, indices, drawcount); }
+inline void instrumented_glPointParameterf (GLenum pname, GLfloat param) { GLStats::calls[GLStats::Call_glPointParameterf] += 1; glPointParameterf(pname, param); }
+inline void instrumented_glPointParameterfv (GLenum pname, const GLfloat *params) { GLStats::calls[GLStats::Call_glPointParameterfv] += 1; glPointParameterfv(pname, params); }
+inline void instrumented_glPointParameteri (GLenum pname, GLint param) { GLStats::calls[GLStats::Call_glPointParameteri] += 1; glPointParameteri(pname, param); }
+inline void instrumented_glPointParameteriv (GLenum pname, const GLint *params) { GLStats::calls[GLStats::Call_glPointParameteriv] += 1; glPointParameteriv(pname, params); }
+inline void instrumented_glBlendColor (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) { GLStats::calls[GLStats::Call_glBlendColor] += 1; glBlendColor(red, green, blue, alpha); }
+inline void instrumented_glBlendEquation (GLenum mode) { GLStats::calls[GLStats::Call_glBlendEquation] += 1; glBlendEquation(mode); }
+inline void instrumented_glGenQueries (GLsizei n, GLuint *ids) { GLStats::calls[GLStats::Call_glGenQueries] += 1; glGenQueries(n, ids); }
+inline void instrumented_glDeleteQueries (GLsizei n, const GLuint *ids) { GLStats::calls[GLStats::Call_glDeleteQueries] += 1; glDeleteQueries(n, ids); }
+inline GLboolean instrumented_glIsQuery (GLuint id) { GLStats::calls[GLStats::Call_glIsQuery] += 1; return glIsQuery(id); }
+inline void instrumented_glBeginQuery (GLenum target, GLuint id) { GLStats::calls[GLStats::Call_glBeginQuery] += 1; glBeginQuery(target, id); }
+inline void instrumented_glEndQuery (GLenum target) { GLStats::calls[GLStats::Call_glEndQuery] += 1; glEndQuery(target); }
+inline void instrumented_glGetQueryiv (GLenum target, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetQueryiv] += 1; glGetQueryiv(target, pname, params); }
+inline void instrumented_glGetQueryObjectiv (GLuint id, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetQueryObjectiv] += 1; glGetQueryObjectiv(id, pname, params); }
+inline void instrumented_glGetQueryObjectuiv (GLuint id, GLenum pname, GLuint *params) { GLStats::calls[GLStats::Call_glGetQueryObjectuiv] += 1; glGetQueryObjectuiv(id, pname, params); }
+inline void instrumented_glBindBuffer (GLenum target, GLuint buffer) { GLStats::calls[GLStats::Call_glBindBuffer] += 1; glBindBuffer(target, buffer); }
+inline void instrumented_glDeleteBuffers (GLsizei n, const GLuint *buffers) { GLStats::calls[GLStats::Call_glDeleteBuffers] += 1; glDeleteBuffers(n, buffers); }
+inline void instrumented_glGenBuffers (GLsizei n, GLuint *buffers) { GLStats::calls[GLStats::Call_glGenBuffers] += 1; glGenBuffers(n, buffers); }
+inline GLboolean instrumented_glIsBuffer (GLuint buffer) { GLStats::calls[GLStats::Call_glIsBuffer] += 1; return glIsBuffer(buffer); }
+inline void instrumented_glBufferData (GLenum target, GLsizeiptr size, const void *data, GLenum usage) { GLStats::calls[GLStats::Call_glBufferData] += 1; if (data) GLStats::note_upload(size_t(size)); glBufferData(target, size, data, usage); }
+inline void instrumented_glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void *data) { GLStats::calls[GLStats::Call_glBufferSubData] += 1; GLStats::note_upload(size_t(size)); glBufferSubData(target, offset, size, data); }
+inline void instrumented_glGetBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, void *data) { GLStats::calls[GLStats::Call_glGetBufferSubData] += 1; glGetBufferSubData(target, offset, size, data); }
+inline void * instrumented_glMapBuffer (GLenum target, GLenum access) { GLStats::calls[GLStats::Call_glMapBuffer] += 1; return glMapBuffer(target, access); }
+inline GLboolean instrumented_glUnmapBuffer (GLenum target) { GLStats::calls[GLStats::Call_glUnmapBuffer] += 1; return glUnmapBuffer(target); }
+inline void instrumented_glGetBufferParameteriv (GLenum target, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetBufferParameteriv] += 1; glGetBufferParameteriv(target, pname, params); }
+inline void instrumented_glGetBufferPointerv (GLenum target, GLenum pname, void **params) { GLStats::calls[GLStats::Call_glGetBufferPointerv] += 1; glGetBufferPointerv(target, pname, params); }
+inline void instrumented_glBlendEquationSeparate (GLenum modeRGB, GLenum modeAlpha) { GLStats::calls[GLStats::Call_glBlendEquationSeparate] += 1; glBlendEquationSeparate(modeRGB, modeAlpha); }
+inline void instrumented_glDrawBuffers (GLsizei n, const GLenum *bufs) { GLStats::calls[GLStats::Call_glDrawBuffers] += 1; glDrawBuffers(n, bufs); }
+inline void instrumented_glStencilOpSeparate (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) { GLStats::calls[GLStats::Call_glStencilOpSeparate] += 1; glStencilOpSeparate(face, sfail, dpfail, dppass); }
+inline void instrumented_glStencilFuncSeparate (GLenum face, GLenum func, GLint ref, GLuint mask) { GLStats::calls[GLStats::Call_glStencilFuncSeparate] += 1; glStencilFuncSeparate(face, func, ref, mask); }
+inline void instrumented_glStencilMaskSeparate (GLenum face, GLuint mask) { GLStats::calls[GLStats::Call_glStencilMaskSeparate] += 1; glStencilMaskSeparate(face, mask); }
+inline void instrumented_glAttachShader (GLuint program, GLuint shader) { GLStats::calls[GLStats::Call_glAttachShader] += 1; glAttachShader(program, shader); }
+inline void instrumented_glBindAttribLocation (GLuint program, GLuint index, const GLchar *name) { GLStats::calls[GLStats::Call_glBindAttribLocation] += 1; glBindAttribLocation(program, index, name); }
+inline void instrumented_glCompileShader (GLuint shader) { GLStats::calls[GLStats::Call_glCompileShader] += 1; glCompileShader(shader); }
+inline GLuint instrumented_glCreateProgram (void) { GLStats::calls[GLStats::Call_glCreateProgram] += 1; return glCreateProgram(); }
+inline GLuint instrumented_glCreateShader (GLenum type) { GLStats::calls[GLStats::Call_glCreateShader] += 1; return glCreateShader(type); }
+inline void instrumented_glDeleteProgram (GLuint program) { GLStats::calls[GLStats::Call_glDeleteProgram] += 1; glDeleteProgram(program); }
+inline void instrumented_glDeleteShader (GLuint shader) { GLStats::calls[GLStats::Call_glDeleteShader] += 1; glDeleteShader(shader); }
+inline void instrumented_glDetachShader (GLuint program, GLuint shader) { GLStats::calls[GLStats::Call_glDetachShader] += 1; glDetachShader(program, shader); }
+inline void instrumented_glDisableVertexAttribArray (GLuint index) { GLStats::calls[GLStats::Call_glDisableVertexAttribArray] += 1; glDisableVertexAttribArray(index); }
+inline void instrumented_glEnableVertexAttribArray (GLuint index) { GLStats::calls[GLStats::Call_glEnableVertexAttribArray] += 1; glEnableVertexAttribArray(index); }
+inline void instrumented_glGetActiveAttrib (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) { GLStats::calls[GLStats::Call_glGetActiveAttrib] += 1; glGetActiveAttrib(program, index, bufSize, length, size, type, name); }
+inline void instrumented_glGetActiveUniform (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) { GLStats::calls[GLStats::Call_glGetActiveUniform] += 1; glGetActiveUniform(program, index, bufSize, length, size, type, name); }
+inline void instrumented_glGetAttachedShaders (GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders) { GLStats::calls[GLStats::Call_glGetAttachedShaders] += 1; glGetAttachedShaders(program, maxCount, count, shaders); }
+inline GLint instrumented_glGetAttribLocation (GLuint program, const GLchar *name) { GLStats::calls[GLStats::Call_glGetAttribLocation] += 1; return glGetAttribLocation(program, name); }
+inline void instrumented_glGetProgramiv (GLuint program, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetProgramiv] += 1; glGetProgramiv(program, pname, params); }
+inline void instrumented_glGetProgramInfoLog (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog) { GLStats::calls[GLStats::Call_glGetProgramInfoLog] += 1; glGetProgramInfoLog(program, bufSize, length, infoLog); }
+inline void instrumented_glGetShaderiv (GLuint shader, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetShaderiv] += 1; glGetShaderiv(shader, pname, params); }
+inline void instrumented_glGetShaderInfoLog (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog) { GLStats::calls[GLStats::Call_glGetShaderInfoLog] += 1; glGetShaderInfoLog(shader, bufSize, length, infoLog); }
+inline void instrumented_glGetShaderSource (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source) { GLStats::calls[GLStats::Call_glGetShaderSource] += 1; glGetShaderSource(shader, bufSize, length, source); }
+inline GLint instrumented_glGetUniformLocation (GLuint program, const GLchar *name) { GLStats::calls[GLStats::Call_glGetUniformLocation] += 1; return glGetUniformLocation(program, name); }
+inline void instrumented_glGetUniformfv (GLuint program, GLint location, GLfloat *params) { GLStats::calls[GLStats::Call_glGetUniformfv] += 1; glGetUniformfv(program, location, params); }
+inline void instrumented_glGetUniformiv (GLuint program, GLint location, GLint *params) { GLStats::calls[GLStats::Call_glGetUniformiv] += 1; glGetUniformiv(program, location, params); }
+inline void instrumented_glGetVertexAttribdv (GLuint index, GLenum pname, GLdouble *params) { GLStats::calls[GLStats::Call_glGetVertexAttribdv] += 1; glGetVertexAttribdv(index, pname, params); }
+inline void instrumented_glGetVertexAttribfv (GLuint index, GLenum pname, GLfloat *params) { GLStats::calls[GLStats::Call_glGetVertexAttribfv] += 1; glGetVertexAttribfv(index, pname, params); }
+inline void instrumented_glGetVertexAttribiv (GLuint index, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetVertexAttribiv] += 1; glGetVertexAttribiv(index, pname, params); }
+inline void instrumented_glGetVertexAttribPointerv (GLuint index, GLenum pname, void **pointer) { GLStats::calls[GLStats::Call_glGetVertexAttribPointerv] += 1; glGetVertexAttribPointerv(index, pname, pointer); }
+inline GLboolean instrumented_glIsProgram (GLuint program) { GLStats::calls[GLStats::Call_glIsProgram] += 1; return glIsProgram(program); }
+inline GLboolean instrumented_glIsShader (GLuint shader) { GLStats::calls[GLStats::Call_glIsShader] += 1; return glIsShader(shader); }
+inline void instrumented_glLinkProgram (GLuint program) { GLStats::calls[GLStats::Call_glLinkProgram] += 1; glLinkProgram(program); }
+inline void instrumented_glShaderSource (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length) { GLStats::calls[GLStats::Call_glShaderSource] += 1; glShaderSource(shader, count, string, length); }
+inline void instrumented_glUseProgram (GLuint program) { GLStats::calls[GLStats::Call_glUseProgram] += 1; glUseProgram(program); }
+inline void instrumented_glUniform1f (GLint location, GLfloat v0) { GLStats::calls[GLStats::Call_glUniform1f] += 1; glUniform1f(location, v0); }
+inline void instrumented_glUniform2f (GLint location, GLfloat v0, GLfloat v1) { GLStats::calls[GLStats::Call_glUniform2f] += 1; glUniform2f(location, v0, v1); }
+inline void instrumented_glUniform3f (GLint location, GLfloat v0, GLfloat v1, GLfloat v2) { GLStats::calls[GLStats::Call_glUniform3f] += 1; glUniform3f(location, v0, v1, v2); }
+inline void instrumented_glUniform4f (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) { GLStats::calls[GLStats::Call_glUniform4f] += 1; glUniform4f(location, v0, v1, v2, v3); }
+inline void instrumented_glUniform1i (GLint location, GLint v0) { GLStats::calls[GLStats::Call_glUniform1i] += 1; glUniform1i(location, v0); }
+inline void instrumented_glUniform2i (GLint location, GLint v0, GLint v1) { GLStats::calls[GLStats::Call_glUniform2i] += 1; glUniform2i(location, v0, v1); }
+inline void instrumented_glUniform3i (GLint location, GLint v0, GLint v1, GLint v2) { GLStats::calls[GLStats::Call_glUniform3i] += 1; glUniform3i(location, v0, v1, v2); }
+inline void instrumented_glUniform4i (GLint location, GLint v0, GLint v1, GLint v2, GLint v3) { GLStats::calls[GLStats::Call_glUniform4i] += 1; glUniform4i(location, v0, v1, v2, v3); }
+inline void instrumented_glUniform1fv (GLint location, GLsizei count, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniform1fv] += 1; glUniform1fv(location, count, value); }
+inline void instrumented_glUniform2fv (GLint location, GLsizei count, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniform2fv] += 1; glUniform2fv(location, count, value); }
+inline void instrumented_glUniform3fv (GLint location, GLsizei count, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniform3fv] += 1; glUniform3fv(location, count, value); }
+inline void instrumented_glUniform4fv (GLint location, GLsizei count, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniform4fv] += 1; glUniform4fv(location, count, value); }
+inline void instrumented_glUniform1iv (GLint location, GLsizei count, const GLint *value) { GLStats::calls[GLStats::Call_glUniform1iv] += 1; glUniform1iv(location, count, value); }
+inline void instrumented_glUniform2iv (GLint location, GLsizei count, const GLint *value) { GLStats::calls[GLStats::Call_glUniform2iv] += 1; glUniform2iv(location, count, value); }
+inline void instrumented_glUniform3iv (GLint location, GLsizei count, const GLint *value) { GLStats::calls[GLStats::Call_glUniform3iv] += 1; glUniform3iv(location, count, value); }
+inline void instrumented_glUniform4iv (GLint location, GLsizei count, const GLint *value) { GLStats::calls[GLStats::Call_glUniform4iv] += 1; glUniform4iv(location, count, value); }
+inline void instrumented_glUniformMatrix2fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix2fv] += 1; glUniformMatrix2fv(location, count, transpose, value); }
+inline void instrumented_glUniformMatrix3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix3fv] += 1; glUniformMatrix3fv(location, count, transpose, value); }
+inline void instrumented_glUniformMatrix4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix4fv] += 1; glUniformMatrix4fv(location, count, transpose, value); }
+inline void instrumented_glValidateProgram (GLuint program) { GLStats::calls[GLStats::Call_glValidateProgram] += 1; glValidateProgram(program); }
+inline void instrumented_glVertexAttrib1d (GLuint index, GLdouble x) { GLStats::calls[GLStats::Call_glVertexAttrib1d] += 1; glVertexAttrib1d(index, x); }
+inline void instrumented_glVertexAttrib1dv (GLuint index, const GLdouble *v) { GLStats::calls[GLStats::Call_glVertexAttrib1dv] += 1; glVertexAttrib1dv(index, v); }
+inline void instrumented_glVertexAttrib1f (GLuint index, GLfloat x) { GLStats::calls[GLStats::Call_glVertexAttrib1f] += 1; glVertexAttrib1f(index, x); }
+inline void instrumented_glVertexAttrib1fv (GLuint index, const GLfloat *v) { GLStats::calls[GLStats::Call_glVertexAttrib1fv] += 1; glVertexAttrib1fv(index, v); }
+inline void instrumented_glVertexAttrib1s (GLuint index, GLshort x) { GLStats::calls[GLStats::Call_glVertexAttrib1s] += 1; glVertexAttrib1s(index, x); }
+inline void instrumented_glVertexAttrib1sv (GLuint index, const GLshort *v) { GLStats::calls[GLStats::Call_glVertexAttrib1sv] += 1; glVertexAttrib1sv(index, v); }
+inline void instrumented_glVertexAttrib2d (GLuint index, GLdouble x, GLdouble y) { GLStats::calls[GLStats::Call_glVertexAttrib2d] += 1; glVertexAttrib2d(index, x, y); }
+inline void instrumented_glVertexAttrib2dv (GLuint index, const GLdouble *v) { GLStats::calls[GLStats::Call_glVertexAttrib2dv] += 1; glVertexAttrib2dv(index, v); }
+inline void instrumented_glVertexAttrib2f (GLuint index, GLfloat x, GLfloat y) { GLStats::calls[GLStats::Call_glVertexAttrib2f] += 1; glVertexAttrib2f(index, x, y); }
+inline void instrumented_glVertexAttrib2fv (GLuint index, const GLfloat *v) { GLStats::calls[GLStats::Call_glVertexAttrib2fv] += 1; glVertexAttrib2fv(index, v); }
+inline void instrumented_glVertexAttrib2s (GLuint index, GLshort x, GLshort y) { GLStats::calls[GLStats::Call_glVertexAttrib2s] += 1; glVertexAttrib2s(index, x, y); }
+inline void instrumented_glVertexAttrib2sv (GLuint index, const GLshort *v) { GLStats::calls[GLStats::Call_glVertexAttrib2sv] += 1; glVertexAttrib2sv(index, v); }
+inline void instrumented_glVertexAttrib3d (GLuint index, GLdouble x, GLdouble y, GLdouble z) { GLStats::calls[GLStats::Call_glVertexAttrib3d] += 1; glVertexAttrib3d(index, x, y, z); }
+inline void instrumented_glVertexAttrib3dv (GLuint index, const GLdouble *v) { GLStats::calls[GLStats::Call_glVertexAttrib3dv] += 1; glVertexAttrib3dv(index, v); }
+inline void instrumented_glVertexAttrib3f (GLuint index, GLfloat x, GLfloat y, GLfloat z) { GLStats::calls[GLStats::Call_glVertexAttrib3f] += 1; glVertexAttrib3f(index, x, y, z); }
+inline void instrumented_glVertexAttrib3fv (GLuint index, const GLfloat *v) { GLStats::calls[GLStats::Call_glVertexAttrib3fv] += 1; glVertexAttrib3fv(index, v); }
+inline void instrumented_glVertexAttrib3s (GLuint index, GLshort x, GLshort y, GLshort z) { GLStats::calls[GLStats::Call_glVertexAttrib3s] += 1; glVertexAttrib3s(index, x, y, z); }
+inline void instrumented_glVertexAttrib3sv (GLuint index, const GLshort *v) { GLStats::calls[GLStats::Call_glVertexAttrib3sv] += 1; glVertexAttrib3sv(index, v); }
+inline void instrumented_glVertexAttrib4Nbv (GLuint index, const GLbyte *v) { GLStats::calls[GLStats::Call_glVertexAttrib4Nbv] += 1; glVertexAttrib4Nbv(index, v); }
+inline void instrumented_glVertexAttrib4Niv (GLuint index, const GLint *v) { GLStats::calls[GLStats::Call_glVertexAttrib4Niv] += 1; glVertexAttrib4Niv(index, v); }
+inline void instrumented_glVertexAttrib4Nsv (GLuint index, const GLshort *v) { GLStats::calls[GLStats::Call_glVertexAttrib4Nsv] += 1; glVertexAttrib4Nsv(index, v); }
+inline void instrumented_glVertexAttrib4Nub (GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w) { GLStats::calls[GLStats::Call_glVertexAttrib4Nub] += 1; glVertexAttrib4Nub(index, x, y, z, w); }
+inline void instrumented_glVertexAttrib4Nubv (GLuint index, const GLubyte *v) { GLStats::calls[GLStats::Call_glVertexAttrib4Nubv] += 1; glVertexAttrib4Nubv(index, v); }
+inline void instrumented_glVertexAttrib4Nuiv (GLuint index, const GLuint *v) { GLStats::calls[GLStats::Call_glVertexAttrib4Nuiv] += 1; glVertexAttrib4Nuiv(index, v); }
+inline void instrumented_glVertexAttrib4Nusv (GLuint index, const GLushort *v) { GLStats::calls[GLStats::Call_glVertexAttrib4Nusv] += 1; glVertexAttrib4Nusv(index, v); }
+inline void instrumented_glVertexAttrib4bv (GLuint index, const GLbyte *v) { GLStats::calls[GLStats::Call_glVertexAttrib4bv] += 1; glVertexAttrib4bv(index, v); }
+inline void instrumented_glVertexAttrib4d (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w) { GLStats::calls[GLStats::Call_glVertexAttrib4d] += 1; glVertexAttrib4d(index, x, y, z, w); }
+inline void instrumented_glVertexAttrib4dv (GLuint index, const GLdouble *v) { GLStats::calls[GLStats::Call_glVertexAttrib4dv] += 1; glVertexAttrib4dv(index, v); }
+inline void instrumented_glVertexAttrib4f (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w) { GLStats::calls[GLStats::Call_glVertexAttrib4f] += 1; glVertexAttrib4f(index, x, y, z, w); }
+inline void instrumented_glVertexAttrib4fv (GLuint index, const GLfloat *v) { GLStats::calls[GLStats::Call_glVertexAttrib4fv] += 1; glVertexAttrib4fv(index, v); }
+inline void instrumented_glVertexAttrib4iv (GLuint index, const GLint *v) { GLStats::calls[GLStats::Call_glVertexAttrib4iv] += 1; glVertexAttrib4iv(index, v); }
+inline void instrumented_glVertexAttrib4s (GLuint index, GLshort x, GLshort y, GLshort z, GLshort w) { GLStats::calls[GLStats::Call_glVertexAttrib4s] += 1; glVertexAttrib4s(index, x, y, z, w); }
+inline void instrumented_glVertexAttrib4sv (GLuint index, const GLshort *v) { GLStats::calls[GLStats::Call_glVertexAttrib4sv] += 1; glVertexAttrib4sv(index, v); }
+inline void instrumented_glVertexAttrib4ubv (GLuint index, const GLubyte *v) { GLStats::calls[GLStats::Call_glVertexAttrib4ubv] += 1; glVertexAttrib4ubv(index, v); }
+inline void instrumented_glVertexAttrib4uiv (GLuint index, const GLuint *v) { GLStats::calls[GLStats::Call_glVertexAttrib4uiv] += 1; glVertexAttrib4uiv(index, v); }
+inline void instrumented_glVertexAttrib4usv (GLuint index, const GLushort *v) { GLStats::calls[GLStats::Call_glVertexAttrib4usv] += 1; glVertexAttrib4usv(index, v); }
+inline void instrumented_glVertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) { GLStats::calls[GLStats::Call_glVertexAttribPointer] += 1; glVertexAttribPointer(index, size, type, normalized, stride, pointer); }
+inline void instrumented_glUniformMatrix2x3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix2x3fv] += 1; glUniformMatrix2x3fv(location, count, transpose, value); }
+inline void instrumented_glUniformMatrix3x2fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix3x2fv] += 1; glUniformMatrix3x2fv(location, count, transpose, value); }
+inline void instrumented_glUniformMatrix2x4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix2x4fv] += 1; glUniformMatrix2x4fv(location, count, transpose, value); }
+inline void instrumented_glUniformMatrix4x2fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix4x2fv] += 1; glUniformMatrix4x2fv(location, count, transpose, value); }
+inline void instrumented_glUniformMatrix3x4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix3x4fv] += 1; glUniformMatrix3x4fv(location, count, transpose, value); }
+inline void instrumented_glUniformMatrix4x3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLStats::calls[GLStats::Call_glUniformMatrix4x3fv] += 1; glUniformMatrix4x3fv(location, count, transpose, value); }
+inline void instrumented_glColorMaski (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a) { GLStats::calls[GLStats::Call_glColorMaski] += 1; glColorMaski(index, r, g, b, a); }
+inline void instrumented_glGetBooleani_v (GLenum target, GLuint index, GLboolean *data) { GLStats::calls[GLStats::Call_glGetBooleani_v] += 1; glGetBooleani_v(target, index, data); }
+inline void instrumented_glGetIntegeri_v (GLenum target, GLuint index, GLint *data) { GLStats::calls[GLStats::Call_glGetIntegeri_v] += 1; glGetIntegeri_v(target, index, data); }
+inline void instrumented_glEnablei (GLenum target, GLuint index) { GLStats::calls[GLStats::Call_glEnablei] += 1; glEnablei(target, index); }
+inline void instrumented_glDisablei (GLenum target, GLuint index) { GLStats::calls[GLStats::Call_glDisablei] += 1; glDisablei(target, index); }
+inline GLboolean instrumented_glIsEnabledi (GLenum target, GLuint index) { GLStats::calls[GLStats::Call_glIsEnabledi] += 1; return glIsEnabledi(target, index); }
+inline void instrumented_glBeginTransformFeedback (GLenum primitiveMode) { GLStats::calls[GLStats::Call_glBeginTransformFeedback] += 1; glBeginTransformFeedback(primitiveMode); }
+inline void instrumented_glEndTransformFeedback (void) { GLStats::calls[GLStats::Call_glEndTransformFeedback] += 1; glEndTransformFeedback(); }
+inline void instrumented_glBindBufferRange (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) { GLStats::calls[GLStats::Call_glBindBufferRange] += 1; glBindBufferRange(target, index, buffer, offset, size); }
+inline void instrumented_glBindBufferBase (GLenum target, GLuint index, GLuint buffer) { GLStats::calls[GLStats::Call_glBindBufferBase] += 1; glBindBufferBase(target, index, buffer); }
+inline void instrumented_glTransformFeedbackVaryings (GLuint program, GLsizei count, const GLchar *const*varyings, GLenum bufferMode) { GLStats::calls[GLStats::Call_glTransformFeedbackVaryings] += 1; glTransformFeedbackVaryings(program, count, varyings, bufferMode); }
+inline void instrumented_glGetTransformFeedbackVarying (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name) { GLStats::calls[GLStats::Call_glGetTransformFeedbackVarying] += 1; glGetTransformFeedbackVarying(program, index, bufSize, length, size, type, name); }
+inline void instrumented_glClampColor (GLenum target, GLenum clamp) { GLStats::calls[GLStats::Call_glClampColor] += 1; glClampColor(target, clamp); }
+inline void instrumented_glBeginConditionalRender (GLuint id, GLenum mode) { GLStats::calls[GLStats::Call_glBeginConditionalRender] += 1; glBeginConditionalRender(id, mode); }
+inline void instrumented_glEndConditionalRender (void) { GLStats::calls[GLStats::Call_glEndConditionalRender] += 1; glEndConditionalRender(); }
+inline void instrumented_glVertexAttribIPointer (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer) { GLStats::calls[GLStats::Call_glVertexAttribIPointer] += 1; glVertexAttribIPointer(index, size, type, stride, pointer); }
+inline void instrumented_glGetVertexAttribIiv (GLuint index, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetVertexAttribIiv] += 1; glGetVertexAttribIiv(index, pname, params); }
+inline void instrumented_glGetVertexAttribIuiv (GLuint index, GLenum pname, GLuint *params) { GLStats::calls[GLStats::Call_glGetVertexAttribIuiv] += 1; glGetVertexAttribIuiv(index, pname, params); }
+inline void instrumented_glVertexAttribI1i (GLuint index, GLint x) { GLStats::calls[GLStats::Call_glVertexAttribI1i] += 1; glVertexAttribI1i(index, x); }
+inline void instrumented_glVertexAttribI2i (GLuint index, GLint x, GLint y) { GLStats::calls[GLStats::Call_glVertexAttribI2i] += 1; glVertexAttribI2i(index, x, y); }
+inline void instrumented_glVertexAttribI3i (GLuint index, GLint x, GLint y, GLint z) { GLStats::calls[GLStats::Call_glVertexAttribI3i] += 1; glVertexAttribI3i(index, x, y, z); }
+inline void instrumented_glVertexAttribI4i (GLuint index, GLint x, GLint y, GLint z, GLint w) { GLStats::calls[GLStats::Call_glVertexAttribI4i] += 1; glVertexAttribI4i(index, x, y, z, w); }
+inline void instrumented_glVertexAttribI1ui (GLuint index, GLuint x) { GLStats::calls[GLStats::Call_glVertexAttribI1ui] += 1; glVertexAttribI1ui(index, x); }
+inline void instrumented_glVertexAttribI2ui (GLuint index, GLuint x, GLuint y) { GLStats::calls[GLStats::Call_glVertexAttribI2ui] += 1; glVertexAttribI2ui(index, x, y); }
+inline void instrumented_glVertexAttribI3ui (GLuint index, GLuint x, GLuint y, GLuint z) { GLStats::calls[GLStats::Call_glVertexAttribI3ui] += 1; glVertexAttribI3ui(index, x, y, z); }
+inline void instrumented_glVertexAttribI4ui (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w) { GLStats::calls[GLStats::Call_glVertexAttribI4ui] += 1; glVertexAttribI4ui(index, x, y, z, w); }
+inline void instrumented_glVertexAttribI1iv (GLuint index, const GLint *v) { GLStats::calls[GLStats::Call_glVertexAttribI1iv] += 1; glVertexAttribI1iv(index, v); }
+inline void instrumented_glVertexAttribI2iv (GLuint index, const GLint *v) { GLStats::calls[GLStats::Call_glVertexAttribI2iv] += 1; glVertexAttribI2iv(index, v); }
+inline void instrumented_glVertexAttribI3iv (GLuint index, const GLint *v) { GLStats::calls[GLStats::Call_glVertexAttribI3iv] += 1; glVertexAttribI3iv(index, v); }
+inline void instrumented_glVertexAttribI4iv (GLuint index, const GLint *v) { GLStats::calls[GLStats::Call_glVertexAttribI4iv] += 1; glVertexAttribI4iv(index, v); }
+inline void instrumented_glVertexAttribI1uiv (GLuint index, const GLuint *v) { GLStats::calls[GLStats::Call_glVertexAttribI1uiv] += 1; glVertexAttribI1uiv(index, v); }
+inline void instrumented_glVertexAttribI2uiv (GLuint index, const GLuint *v) { GLStats::calls[GLStats::Call_glVertexAttribI2uiv] += 1; glVertexAttribI2uiv(index, v); }
+inline void instrumented_glVertexAttribI3uiv (GLuint index, const GLuint *v) { GLStats::calls[GLStats::Call_glVertexAttribI3uiv] += 1; glVertexAttribI3uiv(index, v); }
+inline void instrumented_glVertexAttribI4uiv (GLuint index, const GLuint *v) { GLStats::calls[GLStats::Call_glVertexAttribI4uiv] += 1; glVertexAttribI4uiv(index, v); }
+inline void instrumented_glVertexAttribI4bv (GLuint index, const GLbyte *v) { GLStats::calls[GLStats::Call_glVertexAttribI4bv] += 1; glVertexAttribI4bv(index, v); }
+inline void instrumented_glVertexAttribI4sv (GLuint index, const GLshort *v) { GLStats::calls[GLStats::Call_glVertexAttribI4sv] += 1; glVertexAttribI4sv(index, v); }
+inline void instrumented_glVertexAttribI4ubv (GLuint index, const GLubyte *v) { GLStats::calls[GLStats::Call_glVertexAttribI4ubv] += 1; glVertexAttribI4ubv(index, v); }
+inline void instrumented_glVertexAttribI4usv (GLuint index, const GLushort *v) { GLStats::calls[GLStats::Call_glVertexAttribI4usv] += 1; glVertexAttribI4usv(index, v); }
+inline void instrumented_glGetUniformuiv (GLuint program, GLint location, GLuint *params) { GLStats::calls[GLStats::Call_glGetUniformuiv] += 1; glGetUniformuiv(program, location, params); }
+inline void instrumented_glBindFragDataLocation (GLuint program, GLuint color, const GLchar *name) { GLStats::calls[GLStats::Call_glBindFragDataLocation] += 1; glBindFragDataLocation(program, color, name); }
+inline GLint instrumented_glGetFragDataLocation (GLuint program, const GLchar *name) { GLStats::calls[GLStats::Call_glGetFragDataLocation] += 1; return glGetFragDataLocation(program, name); }
+inline void instrumented_glUniform1ui (GLint location, GLuint v0) { GLStats::calls[GLStats::Call_glUniform1ui] += 1; glUniform1ui(location, v0); }
+inline void instrumented_glUniform2ui (GLint location, GLuint v0, GLuint v1) { GLStats::calls[GLStats::Call_glUniform2ui] += 1; glUniform2ui(location, v0, v1); }
+inline void instrumented_glUniform3ui (GLint location, GLuint v0, GLuint v1, GLuint v2) { GLStats::calls[GLStats::Call_glUniform3ui] += 1; glUniform3ui(location, v0, v1, v2); }
+inline void instrumented_glUniform4ui (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3) { GLStats::calls[GLStats::Call_glUniform4ui] += 1; glUniform4ui(location, v0, v1, v2, v3); }
+inline void instrumented_glUniform1uiv (GLint location, GLsizei count, const GLuint *value) { GLStats::calls[GLStats::Call_glUniform1uiv] += 1; glUniform1uiv(location, count, value); }
+inline void instrumented_glUniform2uiv (GLint location, GLsizei count, const GLuint *value) { GLStats::calls[GLStats::Call_glUniform2uiv] += 1; glUniform2uiv(location, count, value); }
+inline void instrumented_glUniform3uiv (GLint location, GLsizei count, const GLuint *value) { GLStats::calls[GLStats::Call_glUniform3uiv] += 1; glUniform3uiv(location, count, value); }
+inline void instrumented_glUniform4uiv (GLint location, GLsizei count, const GLuint *value) { GLStats::calls[GLStats::Call_glUniform4uiv] += 1; glUniform4uiv(location, count, value); }
+inline void instrumented_glTexParameterIiv (GLenum target, GLenum pname, const GLint *params) { GLStats::calls[GLStats::Call_glTexParameterIiv] += 1; glTexParameterIiv(target, pname, params); }
+inline void instrumented_glTexParameterIuiv (GLenum target, GLenum pname, const GLuint *params) { GLStats::calls[GLStats::Call_glTexParameterIuiv] += 1; glTexParameterIuiv(target, pname, params); }
+inline void instrumented_glGetTexParameterIiv (GLenum target, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetTexParameterIiv] += 1; glGetTexParameterIiv(target, pname, params); }
+inline void instrumented_glGetTexParameterIuiv (GLenum target, GLenum pname, GLuint *params) { GLStats::calls[GLStats::Call_glGetTexParameterIuiv] += 1; glGetTexParameterIuiv(target, pname, params); }
+inline void instrumented_glClearBufferiv (GLenum buffer, GLint drawbuffer, const GLint *value) { GLStats::calls[GLStats::Call_glClearBufferiv] += 1; glClearBufferiv(buffer, drawbuffer, value); }
+inline void instrumented_glClearBufferuiv (GLenum buffer, GLint drawbuffer, const GLuint *value) { GLStats::calls[GLStats::Call_glClearBufferuiv] += 1; glClearBufferuiv(buffer, drawbuffer, value); }
+inline void instrumented_glClearBufferfv (GLenum buffer, GLint drawbuffer, const GLfloat *value) { GLStats::calls[GLStats::Call_glClearBufferfv] += 1; glClearBufferfv(buffer, drawbuffer, value); }
+inline void instrumented_glClearBufferfi (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil) { GLStats::calls[GLStats::Call_glClearBufferfi] += 1; glClearBufferfi(buffer, drawbuffer, depth, stencil); }
+inline const GLubyte * instrumented_glGetStringi (GLenum name, GLuint index) { GLStats::calls[GLStats::Call_glGetStringi] += 1; return glGetStringi(name, index); }
+inline GLboolean instrumented_glIsRenderbuffer (GLuint renderbuffer) { GLStats::calls[GLStats::Call_glIsRenderbuffer] += 1; return glIsRenderbuffer(renderbuffer); }
+inline void instrumented_glBindRenderbuffer (GLenum target, GLuint renderbuffer) { GLStats::calls[GLStats::Call_glBindRenderbuffer] += 1; glBindRenderbuffer(target, renderbuffer); }
+inline void instrumented_glDeleteRenderbuffers (GLsizei n, const GLuint *renderbuffers) { GLStats::calls[GLStats::Call_glDeleteRenderbuffers] += 1; glDeleteRenderbuffers(n, renderbuffers); }
+inline void instrumented_glGenRenderbuffers (GLsizei n, GLuint *renderbuffers) { GLStats::calls[GLStats::Call_glGenRenderbuffers] += 1; glGenRenderbuffers(n, renderbuffers); }
+inline void instrumented_glRenderbufferStorage (GLenum target, GLenum internalformat, GLsizei width, GLsizei height) { GLStats::calls[GLStats::Call_glRenderbufferStorage] += 1; glRenderbufferStorage(target, internalformat, width, height); }
+inline void instrumented_glGetRenderbufferParameteriv (GLenum target, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetRenderbufferParameteriv] += 1; glGetRenderbufferParameteriv(target, pname, params); }
+inline GLboolean instrumented_glIsFramebuffer (GLuint framebuffer) { GLStats::calls[GLStats::Call_glIsFramebuffer] += 1; return glIsFramebuffer(framebuffer); }
+inline void instrumented_glBindFramebuffer (GLenum target, GLuint framebuffer) { GLStats::calls[GLStats::Call_glBindFramebuffer] += 1; glBindFramebuffer(target, framebuffer); }
+inline void instrumented_glDeleteFramebuffers (GLsizei n, const GLuint *framebuffers) { GLStats::calls[GLStats::Call_glDeleteFramebuffers] += 1; glDeleteFramebuffers(n, framebuffers); }
+inline void instrumented_glGenFramebuffers (GLsizei n, GLuint *framebuffers) { GLStats::calls[GLStats::Call_glGenFramebuffers] += 1; glGenFramebuffers(n, framebuffers); }
+inline GLenum instrumented_glCheckFramebufferStatus (GLenum target) { GLStats::calls[GLStats::Call_glCheckFramebufferStatus] += 1; return glCheckFramebufferStatus(target); }
+inline void instrumented_glFramebufferTexture1D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) { GLStats::calls[GLStats::Call_glFramebufferTexture1D] += 1; glFramebufferTexture1D(target, attachment, textarget, texture, level); }
+inline void instrumented_glFramebufferTexture2D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) { GLStats::calls[GLStats::Call_glFramebufferTexture2D] += 1; glFramebufferTexture2D(target, attachment, textarget, texture, level); }
+inline void instrumented_glFramebufferTexture3D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset) { GLStats::calls[GLStats::Call_glFramebufferTexture3D] += 1; glFramebufferTexture3D(target, attachment, textarget, texture, level, zoffset); }
+inline void instrumented_glFramebufferRenderbuffer (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) { GLStats::calls[GLStats::Call_glFramebufferRenderbuffer] += 1; glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer); }
+inline void instrumented_glGetFramebufferAttachmentParameteriv (GLenum target, GLenum attachment, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetFramebufferAttachmentParameteriv] += 1; glGetFramebufferAttachmentParameteriv(target, attachment, pname, params); }
+inline void instrumented_glGenerateMipmap (GLenum target) { GLStats::calls[GLStats::Call_glGenerateMipmap] += 1; glGenerateMipmap(target); }
+inline void instrumented_glBlitFramebuffer (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) { GLStats::calls[GLStats::Call_glBlitFramebuffer] += 1; glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter); }
+inline void instrumented_glRenderbufferStorageMultisample (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height) { GLStats::calls[GLStats::Call_glRenderbufferStorageMultisample] += 1; glRenderbufferStorageMultisample(target, samples, internalformat, width, height); }
+inline void instrumented_glFramebufferTextureLayer (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer) { GLStats::calls[GLStats::Call_glFramebufferTextureLayer] += 1; glFramebufferTextureLayer(target, attachment, texture, level, layer); }
+inline void * instrumented_glMapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) { GLStats::calls[GLStats::Call_glMapBufferRange] += 1; return glMapBufferRange(target, offset, length, access); }
+inline void instrumented_glFlushMappedBufferRange (GLenum target, GLintptr offset, GLsizeiptr length) { GLStats::calls[GLStats::Call_glFlushMappedBufferRange] += 1; glFlushMappedBufferRange(target, offset, length); }
+inline void instrumented_glBindVertexArray (GLuint array) { GLStats::calls[GLStats::Call_glBindVertexArray] += 1; glBindVertexArray(array); }
+inline void instrumented_glDeleteVertexArrays (GLsizei n, const GLuint *arrays) { GLStats::calls[GLStats::Call_glDeleteVertexArrays] += 1; glDeleteVertexArrays(n, arrays); }
+inline void instrumented_glGenVertexArrays (GLsizei n, GLuint *arrays) { GLStats::calls[GLStats::Call_glGenVertexArrays] += 1; glGenVertexArrays(n, arrays); }
+inline GLboolean instrumented_glIsVertexArray (GLuint array) { GLStats::calls[GLStats::Call_glIsVertexArray] += 1; return glIsVertexArray(array); }
+inline void instrumented_glDrawArraysInstanced (GLenum mode, GLint first, GLsizei count, GLsizei instancecount) { GLStats::calls[GLStats::Call_glDrawArraysInstanced] += 1; GLStats::note_draw(mode, count, instancecount); glDrawArraysInstanced(mode, first, count, instancecount); }
+inline void instrumented_glDrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount) { GLStats::calls[GLStats::Call_glDrawElementsInstanced] += 1; GLStats::note_draw(mode, count, instancecount); glDrawElementsInstanced(mode, count, type, indices, instancecount); }
+inline void instrumented_glTexBuffer (GLenum target, GLenum internalformat, GLuint buffer) { GLStats::calls[GLStats::Call_glTexBuffer] += 1; glTexBuffer(target, internalformat, buffer); }
+inline void instrumented_glPrimitiveRestartIndex (GLuint index) { GLStats::calls[GLStats::Call_glPrimitiveRestartIndex] += 1; glPrimitiveRestartIndex(index); }
+inline void instrumented_glCopyBufferSubData (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) { GLStats::calls[GLStats::Call_glCopyBufferSubData] += 1; glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size); }
+inline void instrumented_glGetUniformIndices (GLuint program, GLsizei uniformCount, const GLchar *const*uniformNames, GLuint *uniformIndices) { GLStats::calls[GLStats::Call_glGetUniformIndices] += 1; glGetUniformIndices(program, uniformCount, uniformNames, uniformIndices); }
+inline void instrumented_glGetActiveUniformsiv (GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetActiveUniformsiv] += 1; glGetActiveUniformsiv(program, uniformCount, uniformIndices, pname, params); }
+inline void instrumented_glGetActiveUniformName (GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName) { GLStats::calls[GLStats::Call_glGetActiveUniformName] += 1; glGetActiveUniformName(program, uniformIndex, bufSize, length, uniformName); }
+inline GLuint instrumented_glGetUniformBlockIndex (GLuint program, const GLchar *uniformBlockName) { GLStats::calls[GLStats::Call_glGetUniformBlockIndex] += 1; return glGetUniformBlockIndex(program, uniformBlockName); }
+inline void instrumented_glGetActiveUniformBlockiv (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetActiveUniformBlockiv] += 1; glGetActiveUniformBlockiv(program, uniformBlockIndex, pname, params); }
+inline void instrumented_glGetActiveUniformBlockName (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName) { GLStats::calls[GLStats::Call_glGetActiveUniformBlockName] += 1; glGetActiveUniformBlockName(program, uniformBlockIndex, bufSize, length, uniformBlockName); }
+inline void instrumented_glUniformBlockBinding (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding) { GLStats::calls[GLStats::Call_glUniformBlockBinding] += 1; glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding); }
+inline void instrumented_glDrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex) { GLStats::calls[GLStats::Call_glDrawElementsBaseVertex] += 1; GLStats::note_draw(mode, count, 1); glDrawElementsBaseVertex(mode, count, type, indices, basevertex); }
+inline void instrumented_glDrawRangeElementsBaseVertex (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices, GLint basevertex) { GLStats::calls[GLStats::Call_glDrawRangeElementsBaseVertex] += 1; GLStats::note_draw(mode, count, 1); glDrawRangeElementsBaseVertex(mode, start, end, count, type, indices, basevertex); }
+inline void instrumented_glDrawElementsInstancedBaseVertex (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex) { GLStats::calls[GLStats::Call_glDrawElementsInstancedBaseVertex] += 1; GLStats::note_draw(mode, count, instancecount); glDrawElementsInstancedBaseVertex(mode, count, type, indices, instancecount, basevertex); }
+inline void instrumented_glMultiDrawElementsBaseVertex (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex) { GLStats::calls[GLStats::Call_glMultiDrawElementsBaseVertex] += 1; for (GLsizei i = 0; i < drawcount; ++i) GLStats::note_draw(mode, count[i], 1); glMultiDrawElementsBaseVertex(mode, count, type, indices, drawcount, basevertex); }
+inline void instrumented_glProvokingVertex (GLenum mode) { GLStats::calls[GLStats::Call_glProvokingVertex] += 1; glProvokingVertex(mode); }
+inline GLsync instrumented_glFenceSync (GLenum condition, GLbitfield flags) { GLStats::calls[GLStats::Call_glFenceSync] += 1; return glFenceSync(condition, flags); }
+inline GLboolean instrumented_glIsSync (GLsync sync) { GLStats::calls[GLStats::Call_glIsSync] += 1; return glIsSync(sync); }
+inline void instrumented_glDeleteSync (GLsync sync) { GLStats::calls[GLStats::Call_glDeleteSync] += 1; glDeleteSync(sync); }
+inline GLenum instrumented_glClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout) { GLStats::calls[GLStats::Call_glClientWaitSync] += 1; return glClientWaitSync(sync, flags, timeout); }
+inline void instrumented_glWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout) { GLStats::calls[GLStats::Call_glWaitSync] += 1; glWaitSync(sync, flags, timeout); }
+inline void instrumented_glGetInteger64v (GLenum pname, GLint64 *data) { GLStats::calls[GLStats::Call_glGetInteger64v] += 1; glGetInteger64v(pname, data); }
+inline void instrumented_glGetSynciv (GLsync sync, GLenum pname, GLsizei bufSize, GLsizei *length, GLint *values) { GLStats::calls[GLStats::Call_glGetSynciv] += 1; glGetSynciv(sync, pname, bufSize, length, values); }
+inline void instrumented_glGetInteger64i_v (GLenum target, GLuint index, GLint64 *data) { GLStats::calls[GLStats::Call_glGetInteger64i_v] += 1; glGetInteger64i_v(target, index, data); }
+inline void instrumented_glGetBufferParameteri64v (GLenum target, GLenum pname, GLint64 *params) { GLStats::calls[GLStats::Call_glGetBufferParameteri64v] += 1; glGetBufferParameteri64v(target, pname, params); }
+inline void instrumented_glFramebufferTexture (GLenum target, GLenum attachment, GLuint texture, GLint level) { GLStats::calls[GLStats::Call_glFramebufferTexture] += 1; glFramebufferTexture(target, attachment, texture, level); }
+inline void instrumented_glTexImage2DMultisample (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations) { GLStats::calls[GLStats::Call_glTexImage2DMultisample] += 1; glTexImage2DMultisample(target, samples, internalformat, width, height, fixedsamplelocations); }
+inline void instrumented_glTexImage3DMultisample (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations) { GLStats::calls[GLStats::Call_glTexImage3DMultisample] += 1; glTexImage3DMultisample(target, samples, internalformat, width, height, depth, fixedsamplelocations); }
+inline void instrumented_glGetMultisamplefv (GLenum pname, GLuint index, GLfloat *val) { GLStats::calls[GLStats::Call_glGetMultisamplefv] += 1; glGetMultisamplefv(pname, index, val); }
+inline void instrumented_glSampleMaski (GLuint maskNumber, GLbitfield mask) { GLStats::calls[GLStats::Call_glSampleMaski] += 1; glSampleMaski(maskNumber, mask); }
+inline void instrumented_glBindFragDataLocationIndexed (GLuint program, GLuint colorNumber, GLuint index, const GLchar *name) { GLStats::calls[GLStats::Call_glBindFragDataLocationIndexed] += 1; glBindFragDataLocationIndexed(program, colorNumber, index, name); }
+inline GLint instrumented_glGetFragDataIndex (GLuint program, const GLchar *name) { GLStats::calls[GLStats::Call_glGetFragDataIndex] += 1; return glGetFragDataIndex(program, name); }
+inline void instrumented_glGenSamplers (GLsizei count, GLuint *samplers) { GLStats::calls[GLStats::Call_glGenSamplers] += 1; glGenSamplers(count, samplers); }
+inline void instrumented_glDeleteSamplers (GLsizei count, const GLuint *samplers) { GLStats::calls[GLStats::Call_glDeleteSamplers] += 1; glDeleteSamplers(count, samplers); }
+inline GLboolean instrumented_glIsSampler (GLuint sampler) { GLStats::calls[GLStats::Call_glIsSampler] += 1; return glIsSampler(sampler); }
+inline void instrumented_glBindSampler (GLuint unit, GLuint sampler) { GLStats::calls[GLStats::Call_glBindSampler] += 1; glBindSampler(unit, sampler); }
+inline void instrumented_glSamplerParameteri (GLuint sampler, GLenum pname, GLint param) { GLStats::calls[GLStats::Call_glSamplerParameteri] += 1; glSamplerParameteri(sampler, pname, param); }
+inline void instrumented_glSamplerParameteriv (GLuint sampler, GLenum pname, const GLint *param) { GLStats::calls[GLStats::Call_glSamplerParameteriv] += 1; glSamplerParameteriv(sampler, pname, param); }
+inline void instrumented_glSamplerParameterf (GLuint sampler, GLenum pname, GLfloat param) { GLStats::calls[GLStats::Call_glSamplerParameterf] += 1; glSamplerParameterf(sampler, pname, param); }
+inline void instrumented_glSamplerParameterfv (GLuint sampler, GLenum pname, const GLfloat *param) { GLStats::calls[GLStats::Call_glSamplerParameterfv] += 1; glSamplerParameterfv(sampler, pname, param); }
+inline void instrumented_glSamplerParameterIiv (GLuint sampler, GLenum pname, const GLint *param) { GLStats::calls[GLStats::Call_glSamplerParameterIiv] += 1; glSamplerParameterIiv(sampler, pname, param); }
+inline void instrumented_glSamplerParameterIuiv (GLuint sampler, GLenum pname, const GLuint *param) { GLStats::calls[GLStats::Call_glSamplerParameterIuiv] += 1; glSamplerParameterIuiv(sampler, pname, param); }
+inline void instrumented_glGetSamplerParameteriv (GLuint sampler, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetSamplerParameteriv] += 1; glGetSamplerParameteriv(sampler, pname, params); }
+inline void instrumented_glGetSamplerParameterIiv (GLuint sampler, GLenum pname, GLint *params) { GLStats::calls[GLStats::Call_glGetSamplerParameterIiv] += 1; glGetSamplerParameterIiv(sampler, pname, params); }
+inline void instrumented_glGetSamplerParameterfv (GLuint sampler, GLenum pname, GLfloat *params) { GLStats::calls[GLStats::Call_glGetSamplerParameterfv] += 1; glGetSamplerParameterfv(sampler, pname, params); }
+inline void instrumented_glGetSamplerParameterIuiv (GLuint sampler, GLenum pname, GLuint *params) { GLStats::calls[GLStats::Call_glGetSamplerParameterIuiv] += 1; glGetSamplerParameterIuiv(sampler, pname, params); }
+inline void instrumented_glQueryCounter (GLuint id, GLenum target) { GLStats::calls[GLStats::Call_glQueryCounter] += 1; glQueryCounter(id, target); }
+inline void instrumented_glGetQueryObjecti64v (GLuint id, GLenum pname, GLint64 *params) { GLStats::calls[GLStats::Call_glGetQueryObjecti64v] += 1; glGetQueryObjecti64v(id, pname, params); }
+inline void instrumented_glGetQueryObjectui64v (GLuint id, GLenum pname, GLuint64 *params) { GLStats::calls[GLStats::Call_glGetQueryObjectui64v] += 1; glGetQueryObjectui64v(id, pname, params); }
+inline void instrumented_glVertexAttribDivisor (GLuint index, GLuint divisor) { GLStats::calls[GLStats::Call_glVertexAttribDivisor] += 1; glVertexAttribDivisor(index, divisor); }
+inline void instrumented_glVertexAttribP1ui (GLuint index, GLenum type, GLboolean normalized, GLuint value) { GLStats::calls[GLStats::Call_glVertexAttribP1ui] += 1; glVertexAttribP1ui(index, type, normalized, value); }
+inline void instrumented_glVertexAttribP1uiv (GLuint index, GLenum type, GLboolean normalized, const GLuint *value) { GLStats::calls[GLStats::Call_glVertexAttribP1uiv] += 1; glVertexAttribP1uiv(index, type, normalized, value); }
+inline void instrumented_glVertexAttribP2ui (GLuint index, GLenum type, GLboolean normalized, GLuint value) { GLStats::calls[GLStats::Call_glVertexAttribP2ui] += 1; glVertexAttribP2ui(index, type, normalized, value); }
+inline void instrumented_glVertexAttribP2uiv (GLuint index, GLenum type, GLboolean normalized, const GLuint *value) { GLStats::calls[GLStats::Call_glVertexAttribP2uiv] += 1; glVertexAttribP2uiv(index, type, normalized, value); }
+inline void instrumented_glVertexAttribP3ui (GLuint index, GLenum type, GLboolean normalized, GLuint value) { GLStats::calls[GLStats::Call_glVertexAttribP3ui] += 1; glVertexAttribP3ui(index, type, normalized, value); }
+inline void instrumented_glVertexAttribP3uiv (GLuint index, GLenum type, GLboolean normalized, const GLuint *value) { GLStats::calls[GLStats::Call_glVertexAttribP3uiv] += 1; glVertexAttribP3uiv(index, type, normalized, value); }
+inline void instrumented_glVertexAttribP4ui (GLuint index, GLenum type, GLboolean normalized, GLuint value) { GLStats::calls[GLStats::Call_glVertexAttribP4ui] += 1; glVertexAttribP4ui(index, type, normalized, value); }
+inline void instrumented_glVertexAttribP4uiv (GLuint index, GLenum type, GLboolean normalized, const GLuint *value) { GLStats::calls[GLStats::Call_glVertexAttribP4uiv] += 1; glVertexAttribP4uiv(index, type, normalized, value); }
+
+//(GL.cpp defines GL_NO_WRAPPERS, since it needs the actual entry points)
+#ifndef GL_NO_WRAPPERS
+#define glCullFace instrumented_glCullFace
+#define glFrontFace instrumented_glFrontFace
+#define glHint instrumented_glHint
+#define glLineWidth instrumented_glLineWidth
+#define glPointSize instrumented_glPointSize
+#define glPolygonMode instrumented_glPolygonMode
+#define glScissor instrumented_glScissor
+#define glTexParameterf instrumented_glTexParameterf
+#define glTexParameterfv instrumented_glTexParameterfv
+#define glTexParameteri instrumented_glTexParameteri
+#define glTexParameteriv instrumented_glTexParameteriv
+#define glTexImage1D instrumented_glTexImage1D
+#define glTexImage2D instrumented_glTexImage2D
+#define glDrawBuffer instrumented_glDrawBuffer
+#define glClear instrumented_glClear
+#define glClearColor instrumented_glClearColor
+#define glClearStencil instrumented_glClearStencil
+#define glClearDepth instrumented_glClearDepth
+#define glStencilMask instrumented_glStencilMask
+#define glColorMask instrumented_glColorMask
+#define glDepthMask instrumented_glDepthMask
+#define glDisable instrumented_glDisable
+#define glEnable instrumented_glEnable
+#define glFinish instrumented_glFinish
+#define glFlush instrumented_glFlush
+#define glBlendFunc instrumented_glBlendFunc
+#define glLogicOp instrumented_glLogicOp
+#define glStencilFunc instrumented_glStencilFunc
+#define glStencilOp instrumented_glStencilOp
+#define glDepthFunc instrumented_glDepthFunc
+#define glPixelStoref instrumented_glPixelStoref
+#define glPixelStorei instrumented_glPixelStorei
+#define glReadBuffer instrumented_glReadBuffer
+#define glReadPixels instrumented_glReadPixels
+#define glGetBooleanv instrumented_glGetBooleanv
+#define glGetDoublev instrumented_glGetDoublev
+#define glGetError instrumented_glGetError
+#define glGetFloatv instrumented_glGetFloatv
+#define glGetIntegerv instrumented_glGetIntegerv
+#define glGetString instrumented_glGetString
+#define glGetTexImage instrumented_glGetTexImage
+#define glGetTexParameterfv instrumented_glGetTexParameterfv
+#define glGetTexParameteriv instrumented_glGetTexParameteriv
+#define glGetTexLevelParameterfv instrumented_glGetTexLevelParameterfv
+#define glGetTexLevelParameteriv instrumented_glGetTexLevelParameteriv
+#define glIsEnabled instrumented_glIsEnabled
+#define glDepthRange instrumented_glDepthRange
+#define glViewport instrumented_glViewport
+#define glDrawArrays instrumented_glDrawArrays
+#define glDrawElements instrumented_glDrawElements
+#define glGetPointerv instrumented_glGetPointerv
+#define glPolygonOffset instrumented_glPolygonOffset
+#define glCopyTexImage1D instrumented_glCopyTexImage1D
+#define glCopyTexImage2D instrumented_glCopyTexImage2D
+#define glCopyTexSubImage1D instrumented_glCopyTexSubImage1D
+#define glCopyTexSubImage2D instrumented_glCopyTexSubImage2D
+#define glTexSubImage1D instrumented_glTexSubImage1D
+#define glTexSubImage2D instrumented_glTexSubImage2D
+#define glBindTexture instrumented_glBindTexture
+#define glDeleteTextures instrumented_glDeleteTextures
+#define glGenTextures instrumented_glGenTextures
+#define glIsTexture instrumented_glIsTexture
+#define glDrawRangeElements instrumented_glDrawRangeElements
+#define glTexImage3D instrumented_glTexImage3D
+#define glTexSubImage3D instrumented_glTexSubImage3D
+#define glCopyTexSubImage3D instrumented_glCopyTexSubImage3D
+#define glActiveTexture instrumented_glActiveTexture
+#define glSampleCoverage instrumented_glSampleCoverage
+#define glCompressedTexImage3D instrumented_glCompressedTexImage3D
+#define glCompressedTexImage2D instrumented_glCompressedTexImage2D
+#define glCompressedTexImage1D instrumented_glCompressedTexImage1D
+#define glCompressedTexSubImage3D instrumented_glCompressedTexSubImage3D
+#define glCompressedTexSubImage2D instrumented_glCompressedTexSubImage2D
+#define glCompressedTexSubImage1D instrumented_glCompressedTexSubImage1D
+#define glGetCompressedTexImage instrumented_glGetCompressedTexImage
+#define glBlendFuncSeparate instrumented_glBlendFuncSeparate
+#define glMultiDrawArrays instrumented_glMultiDrawArrays
+#define glMultiDrawElements instrumented_glMultiDrawElements
+#define glPointParameterf instrumented_glPointParameterf
+#define glPointParameterfv instrumented_glPointParameterfv
+#define glPointParameteri instrumented_glPointParameteri
+#define glPointParameteriv instrumented_glPointParameteriv
+#define glBlendColor instrumented_glBlendColor
+#define glBlendEquation instrumented_glBlendEquation
+#define glGenQueries instrumented_glGenQueries
+#define glDeleteQueries instrumented_glDeleteQueries
+#define glIsQuery instrumented_glIsQuery
+#define glBeginQuery instrumented_glBeginQuery
+#define glEndQuery instrumented_glEndQuery
+#define glGetQueryiv instrumented_glGetQueryiv
+#define glGetQueryObjectiv instrumented_glGetQueryObjectiv
+#define glGetQueryObjectuiv instrumented_glGetQueryObjectuiv
+#define glBindBuffer instrumented_glBindBuffer
+#define glDeleteBuffers instrumented_glDeleteBuffers
+#define glGenBuffers instrumented_glGenBuffers
+#define glIsBuffer instrumented_glIsBuffer
+#define glBufferData instrumented_glBufferData
+#define glBufferSubData instrumented_glBufferSubData
+#define glGetBufferSubData instrumented_glGetBufferSubData
+#define glMapBuffer instrumented_glMapBuffer
+#define glUnmapBuffer instrumented_glUnmapBuffer
+#define glGetBufferParameteriv instrumented_glGetBufferParameteriv
+#define glGetBufferPointerv instrumented_glGetBufferPointerv
+#define glBlendEquationSeparate instrumented_glBlendEquationSeparate
+#define glDrawBuffers instrumented_glDrawBuffers
+#define glStencilOpSeparate instrumented_glStencilOpSeparate
+#define glStencilFuncSeparate instrumented_glStencilFuncSeparate
+#define glStencilMaskSeparate instrumented_glStencilMaskSeparate
+#define glAttachShader instrumented_glAttachShader
+#define glBindAttribLocation instrumented_glBindAttribLocation
+#define glCompileShader instrumented_glCompileShader
+#define glCreateProgram instrumented_glCreateProgram
+#define glCreateShader instrumented_glCreateShader
+#define glDeleteProgram instrumented_glDeleteProgram
+#define glDeleteShader instrumented_glDeleteShader
+#define glDetachShader instrumented_glDetachShader
+#define glDisableVertexAttribArray instrumented_glDisableVertexAttribArray
+#define glEnableVertexAttribArray instrumented_glEnableVertexAttribArray
+#define glGetActiveAttrib instrumented_glGetActiveAttrib
+#define glGetActiveUniform instrumented_glGetActiveUniform
+#define glGetAttachedShaders instrumented_glGetAttachedShaders
+#define glGetAttribLocation instrumented_glGetAttribLocation
+#define glGetProgramiv instrumented_glGetProgramiv
+#define glGetProgramInfoLog instrumented_glGetProgramInfoLog
+#define glGetShaderiv instrumented_glGetShaderiv
+#define glGetShaderInfoLog instrumented_glGetShaderInfoLog
+#define glGetShaderSource instrumented_glGetShaderSource
+#define glGetUniformLocation instrumented_glGetUniformLocation
+#define glGetUniformfv instrumented_glGetUniformfv
+#define glGetUniformiv instrumented_glGetUniformiv
+#define glGetVertexAttribdv instrumented_glGetVertexAttribdv
+#define glGetVertexAttribfv instrumented_glGetVertexAttribfv
+#define glGetVertexAttribiv instrumented_glGetVertexAttribiv
+#define glGetVertexAttribPointerv instrumented_glGetVertexAttribPointerv
+#define glIsProgram instrumented_glIsProgram
+#define glIsShader instrumented_glIsShader
+#define glLinkProgram instrumented_glLinkProgram
+#define glShaderSource instrumented_glShaderSource
+#define glUseProgram instrumented_glUseProgram
+#define glUniform1f instrumented_glUniform1f
+#define glUniform2f instrumented_glUniform2f
+#define glUniform3f instrumented_glUniform3f
+#define glUniform4f instrumented_glUniform4f
+#define glUniform1i instrumented_glUniform1i
+#define glUniform2i instrumented_glUniform2i
+#define glUniform3i instrumented_glUniform3i
+#define glUniform4i instrumented_glUniform4i
+#define glUniform1fv instrumented_glUniform1fv
+#define glUniform2fv instrumented_glUniform2fv
+#define glUniform3fv instrumented_glUniform3fv
+#define glUniform4fv instrumented_glUniform4fv
+#define glUniform1iv instrumented_glUniform1iv
+#define glUniform2iv instrumented_glUniform2iv
+#define glUniform3iv instrumented_glUniform3iv
+#define glUniform4iv instrumented_glUniform4iv
+#define glUniformMatrix2fv instrumented_glUniformMatrix2fv
+#define glUniformMatrix3fv instrumented_glUniformMatrix3fv
+#define glUniformMatrix4fv instrumented_glUniformMatrix4fv
+#define glValidateProgram instrumented_glValidateProgram
+#define glVertexAttrib1d instrumented_glVertexAttrib1d
+#define glVertexAttrib1dv instrumented_glVertexAttrib1dv
+#define glVertexAttrib1f instrumented_glVertexAttrib1f
+#define glVertexAttrib1fv instrumented_glVertexAttrib1fv
+#define glVertexAttrib1s instrumented_glVertexAttrib1s
+#define glVertexAttrib1sv instrumented_glVertexAttrib1sv
+#define glVertexAttrib2d instrumented_glVertexAttrib2d
+#define glVertexAttrib2dv instrumented_glVertexAttrib2dv
+#define glVertexAttrib2f instrumented_glVertexAttrib2f
+#define glVertexAttrib2fv instrumented_glVertexAttrib2fv
+#define glVertexAttrib2s instrumented_glVertexAttrib2s
+#define glVertexAttrib2sv instrumented_glVertexAttrib2sv
+#define glVertexAttrib3d instrumented_glVertexAttrib3d
+#define glVertexAttrib3dv instrumented_glVertexAttrib3dv
+#define glVertexAttrib3f instrumented_glVertexAttrib3f
+#define glVertexAttrib3fv instrumented_glVertexAttrib3fv
+#define glVertexAttrib3s instrumented_glVertexAttrib3s
+#define glVertexAttrib3sv instrumented_glVertexAttrib3sv
+#define glVertexAttrib4Nbv instrumented_glVertexAttrib4Nbv
+#define glVertexAttrib4Niv instrumented_glVertexAttrib4Niv
+#define glVertexAttrib4Nsv instrumented_glVertexAttrib4Nsv
+#define glVertexAttrib4Nub instrumented_glVertexAttrib4Nub
+#define glVertexAttrib4Nubv instrumented_glVertexAttrib4Nubv
+#define glVertexAttrib4Nuiv instrumented_glVertexAttrib4Nuiv
+#define glVertexAttrib4Nusv instrumented_glVertexAttrib4Nusv
+#define glVertexAttrib4bv instrumented_glVertexAttrib4bv
+#define glVertexAttrib4d instrumented_glVertexAttrib4d
+#define glVertexAttrib4dv instrumented_glVertexAttrib4dv
+#define glVertexAttrib4f instrumented_glVertexAttrib4f
+#define glVertexAttrib4fv instrumented_glVertexAttrib4fv
+#define glVertexAttrib4iv instrumented_glVertexAttrib4iv
+#define glVertexAttrib4s instrumented_glVertexAttrib4s
+#define glVertexAttrib4sv instrumented_glVertexAttrib4sv
+#define glVertexAttrib4ubv instrumented_glVertexAttrib4ubv
+#define glVertexAttrib4uiv instrumented_glVertexAttrib4uiv
+#define glVertexAttrib4usv instrumented_glVertexAttrib4usv
+#define glVertexAttribPointer instrumented_glVertexAttribPointer
+#define glUniformMatrix2x3fv instrumented_glUniformMatrix2x3fv
+#define glUniformMatrix3x2fv instrumented_glUniformMatrix3x2fv
+#define glUniformMatrix2x4fv instrumented_glUniformMatrix2x4fv
+#define glUniformMatrix4x2fv instrumented_glUniformMatrix4x2fv
+#define glUniformMatrix3x4fv instrumented_glUniformMatrix3x4fv
+#define glUniformMatrix4x3fv instrumented_glUniformMatrix4x3fv
+#define glColorMaski instrumented_glColorMaski
+#define glGetBooleani_v instrumented_glGetBooleani_v
+#define glGetIntegeri_v instrumented_glGetIntegeri_v
+#define glEnablei instrumented_glEnablei
+#define glDisablei instrumented_glDisablei
+#define glIsEnabledi instrumented_glIsEnabledi
+#define glBeginTransformFeedback instrumented_glBeginTransformFeedback
+#define glEndTransformFeedback instrumented_glEndTransformFeedback
+#define glBindBufferRange instrumented_glBindBufferRange
+#define glBindBufferBase instrumented_glBindBufferBase
+#define glTransformFeedbackVaryings instrumented_glTransformFeedbackVaryings
+#define glGetTransformFeedbackVarying instrumented_glGetTransformFeedbackVarying
+#define glClampColor instrumented_glClampColor
+#define glBeginConditionalRender instrumented_glBeginConditionalRender
+#define glEndConditionalRender instrumented_glEndConditionalRender
+#define glVertexAttribIPointer instrumented_glVertexAttribIPointer
+#define glGetVertexAttribIiv instrumented_glGetVertexAttribIiv
+#define glGetVertexAttribIuiv instrumented_glGetVertexAttribIuiv
+#define glVertexAttribI1i instrumented_glVertexAttribI1i
+#define glVertexAttribI2i instrumented_glVertexAttribI2i
+#define glVertexAttribI3i instrumented_glVertexAttribI3i
+#define glVertexAttribI4i instrumented_glVertexAttribI4i
+#define glVertexAttribI1ui instrumented_glVertexAttribI1ui
+#define glVertexAttribI2ui instrumented_glVertexAttribI2ui
+#define glVertexAttribI3ui instrumented_glVertexAttribI3ui
+#define glVertexAttribI4ui instrumented_glVertexAttribI4ui
+#define glVertexAttribI1iv instrumented_glVertexAttribI1iv
+#define glVertexAttribI2iv instrumented_glVertexAttribI2iv
+#define glVertexAttribI3iv instrumented_glVertexAttribI3iv
+#define glVertexAttribI4iv instrumented_glVertexAttribI4iv
+#define glVertexAttribI1uiv instrumented_glVertexAttribI1uiv
+#define glVertexAttribI2uiv instrumented_glVertexAttribI2uiv
+#define glVertexAttribI3uiv instrumented_glVertexAttribI3uiv
+#define glVertexAttribI4uiv instrumented_glVertexAttribI4uiv
+#define glVertexAttribI4bv instrumented_glVertexAttribI4bv
+#define glVertexAttribI4sv instrumented_glVertexAttribI4sv
+#define glVertexAttribI4ubv instrumented_glVertexAttribI4ubv
+#define glVertexAttribI4usv instrumented_glVertexAttribI4usv
+#define glGetUniformuiv instrumented_glGetUniformuiv
+#define glBindFragDataLocation instrumented_glBindFragDataLocation
+#define glGetFragDataLocation instrumented_glGetFragDataLocation
+#define glUniform1ui instrumented_glUniform1ui
+#define glUniform2ui instrumented_glUniform2ui
+#define glUniform3ui instrumented_glUniform3ui
+#define glUniform4ui instrumented_glUniform4ui
+#define glUniform1uiv instrumented_glUniform1uiv
+#define glUniform2uiv instrumented_glUniform2uiv
+#define glUniform3uiv instrumented_glUniform3uiv
+#define glUniform4uiv instrumented_glUniform4uiv
+#define glTexParameterIiv instrumented_glTexParameterIiv
+#define glTexParameterIuiv instrumented_glTexParameterIuiv
+#define glGetTexParameterIiv instrumented_glGetTexParameterIiv
+#define glGetTexParameterIuiv instrumented_glGetTexParameterIuiv
+#define glClearBufferiv instrumented_glClearBufferiv
+#define glClearBufferuiv instrumented_glClearBufferuiv
+#define glClearBufferfv instrumented_glClearBufferfv
+#define glClearBufferfi instrumented_glClearBufferfi
+#define glGetStringi instrumented_glGetStringi
+#define glIsRenderbuffer instrumented_glIsRenderbuffer
+#define glBindRenderbuffer instrumented_glBindRenderbuffer
+#define glDeleteRenderbuffers instrumented_glDeleteRenderbuffers
+#define glGenRenderbuffers instrumented_glGenRenderbuffers
+#define glRenderbufferStorage instrumented_glRenderbufferStorage
+#define glGetRenderbufferParameteriv instrumented_glGetRenderbufferParameteriv
+#define glIsFramebuffer instrumented_glIsFramebuffer
+#define glBindFramebuffer instrumented_glBindFramebuffer
+#define glDeleteFramebuffers instrumented_glDeleteFramebuffers
+#define glGenFramebuffers instrumented_glGenFramebuffers
+#define glCheckFramebufferStatus instrumented_glCheckFramebufferStatus
+#define glFramebufferTexture1D instrumented_glFramebufferTexture1D
+#define glFramebufferTexture2D instrumented_glFramebufferTexture2D
+#define glFramebufferTexture3D instrumented_glFramebufferTexture3D
+#define glFramebufferRenderbuffer instrumented_glFramebufferRenderbuffer
+#define glGetFramebufferAttachmentParameteriv instrumented_glGetFramebufferAttachmentParameteriv
+#define glGenerateMipmap instrumented_glGenerateMipmap
+#define glBlitFramebuffer instrumented_glBlitFramebuffer
+#define glRenderbufferStorageMultisample instrumented_glRenderbufferStorageMultisample
+#define glFramebufferTextureLayer instrumented_glFramebufferTextureLayer
+#define glMapBufferRange instrumented_glMapBufferRange
+#define glFlushMappedBufferRange instrumented_glFlushMappedBufferRange
+#define glBindVertexArray instrumented_glBindVertexArray
+#define glDeleteVertexArrays instrumented_glDeleteVertexArrays
+#define glGenVertexArrays instrumented_glGenVertexArrays
+#define glIsVertexArray instrumented_glIsVertexArray
+#define glDrawArraysInstanced instrumented_glDrawArraysInstanced
+#define glDrawElementsInstanced instrumented_glDrawElementsInstanced
+#define glTexBuffer instrumented_glTexBuffer
+#define glPrimitiveRestartIndex instrumented_glPrimitiveRestartIndex
+#define glCopyBufferSubData instrumented_glCopyBufferSubData
+#define glGetUniformIndices instrumented_glGetUniformIndices
+#define glGetActiveUniformsiv instrumented_glGetActiveUniformsiv
+#define glGetActiveUniformName instrumented_glGetActiveUniformName
+#define glGetUniformBlockIndex instrumented_glGetUniformBlockIndex
+#define glGetActiveUniformBlockiv instrumented_glGetActiveUniformBlockiv
+#define glGetActiveUniformBlockName instrumented_glGetActiveUniformBlockName
+#define glUniformBlockBinding instrumented_glUniformBlockBinding
+#define glDrawElementsBaseVertex instrumented_glDrawElementsBaseVertex
+#define glDrawRangeElementsBaseVertex instrumented_glDrawRangeElementsBaseVertex
+#define glDrawElementsInstancedBaseVertex instrumented_glDrawElementsInstancedBaseVertex
+#define glMultiDrawElementsBaseVertex instrumented_glMultiDrawElementsBaseVertex
+#define glProvokingVertex instrumented_glProvokingVertex
+#define glFenceSync instrumented_glFenceSync
+#define glIsSync instrumented_glIsSync
+#define glDeleteSync instrumented_glDeleteSync
+#define glClientWaitSync instrumented_glClientWaitSync
+#define glWaitSync instrumented_glWaitSync
+#define glGetInteger64v instrumented_glGetInteger64v
+#define glGetSynciv instrumented_glGetSynciv
+#define glGetInteger64i_v instrumented_glGetInteger64i_v
+#define glGetBufferParameteri64v instrumented_glGetBufferParameteri64v
+#define glFramebufferTexture instrumented_glFramebufferTexture
+#define glTexImage2DMultisample instrumented_glTexImage2DMultisample
+#define glTexImage3DMultisample instrumented_glTexImage3DMultisample
+#define glGetMultisamplefv instrumented_glGetMultisamplefv
+#define glSampleMaski instrumented_glSampleMaski
+#define glBindFragDataLocationIndexed instrumented_glBindFragDataLocationIndexed
+#define glGetFragDataIndex instrumented_glGetFragDataIndex
+#define glGenSamplers instrumented_glGenSamplers
+#define glDeleteSamplers instrumented_glDeleteSamplers
+#define glIsSampler instrumented_glIsSampler
+#define glBindSampler instrumented_glBindSampler
+#define glSamplerParameteri instrumented_glSamplerParameteri
+#define glSamplerParameteriv instrumented_glSamplerParameteriv
+#define glSamplerParameterf instrumented_glSamplerParameterf
+#define glSamplerParameterfv instrumented_glSamplerParameterfv
+#define glSamplerParameterIiv instrumented_glSamplerParameterIiv
+#define glSamplerParameterIuiv instrumented_glSamplerParameterIuiv
+#define glGetSamplerParameteriv instrumented_glGetSamplerParameteriv
+#define glGetSamplerParameterIiv instrumented_glGetSamplerParameterIiv
+#define glGetSamplerParameterfv instrumented_glGetSamplerParameterfv
+#define glGetSamplerParameterIuiv instrumented_glGetSamplerParameterIuiv
+#define glQueryCounter instrumented_glQueryCounter
+#define glGetQueryObjecti64v instrumented_glGetQueryObjecti64v
+#define glGetQueryObjectui64v instrumented_glGetQueryObjectui64v
+#define glVertexAttribDivisor instrumented_glVertexAttribDivisor
+#define glVertexAttribP1ui instrumented_glVertexAttribP1ui
+#define glVertexAttribP1uiv instrumented_glVertexAttribP1uiv
+#define glVertexAttribP2ui instrumented_glVertexAttribP2ui
+#define glVertexAttribP2uiv instrumented_glVertexAttribP2uiv
+#define glVertexAttribP3ui instrumented_glVertexAttribP3ui
+#define glVertexAttribP3uiv instrumented_glVertexAttribP3uiv
+#define glVertexAttribP4ui instrumented_glVertexAttribP4ui
+#define glVertexAttribP4uiv instrumented_glVertexAttribP4uiv
+#endif
+
+#endif //GL_INSTRUMENT
@@ -0,0 +1,267 @@
+#include "GLState.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+	//cached values are 'UNKNOWN' until first set (or after invalidate()), so the first request always goes through:
+	constexpr GLuint const UNKNOWN = ~GLuint(0);
+
+	//texture targets available in OpenGL 3.3 core:
+	constexpr GLenum const TEXTURE_TARGETS[] = {
+		GL_TEXTURE_1D,
+		GL_TEXTURE_2D,
+		GL_TEXTURE_3D,
+		GL_TEXTURE_1D_ARRAY,
+		GL_TEXTURE_2D_ARRAY,
+		GL_TEXTURE_RECTANGLE,
+		GL_TEXTURE_CUBE_MAP,
+		GL_TEXTURE_BUFFER,
+		GL_TEXTURE_2D_MULTISAMPLE,
+		GL_TEXTURE_2D_MULTISAMPLE_ARRAY,
+	};
+	constexpr uint32_t const TEXTURE_TARGET_COUNT = uint32_t(sizeof(TEXTURE_TARGETS) / sizeof(TEXTURE_TARGETS[0]));
+
+	//capabilities whose enabled/disabled state is cached:
+	constexpr GLenum const CAPABILITIES[] = {
+		GL_BLEND,
+		GL_CULL_FACE,
+		GL_DEPTH_TEST,
+		GL_FRAMEBUFFER_SRGB,
+		GL_LINE_SMOOTH,
+		GL_SCISSOR_TEST,
+		GL_STENCIL_TEST,
+	};
+	constexpr uint32_t const CAPABILITY_COUNT = uint32_t(sizeof(CAPABILITIES) / sizeof(CAPABILITIES[0]));
+
+	struct Cache {
+		GLuint program = UNKNOWN;
+		GLuint vao = UNKNOWN;
+		GLuint array_buffer = UNKNOWN;
+		GLuint active_unit = UNKNOWN;
+		GLuint textures[GLState::MAX_TEXTURE_UNITS][TEXTURE_TARGET_COUNT];
+		GLuint capabilities[CAPABILITY_COUNT]; //(GL_FALSE, GL_TRUE, or UNKNOWN)
+		GLuint depth_func = UNKNOWN;
+		GLuint depth_mask = UNKNOWN;
+		GLuint blend_sfactor = UNKNOWN, blend_dfactor = UNKNOWN;
+
+		Cache() {
+			for (auto &unit : textures) {
+				for (auto &texture : unit) texture = UNKNOWN;
+			}
+			for (auto &capability : capabilities) capability = UNKNOWN;
+		}
+	} cache;
+
+	GLState::Stats current; //counts for the frame in progress
+	GLState::Stats finished; //counts for the last finished frame
+
+	//set from the GL_STATE_STATS environment variable:
+	bool const print_stats = (std::getenv("GL_STATE_STATS") != nullptr);
+
+	//count a request of the given kind; returns true if it changes 'cached' (and updates it):
+	bool changes(GLState::Stats::Kind kind, GLuint &cached, GLuint value) {
+		current.requested[kind] += 1;
+		if (cached == value) {
+			current.skipped[kind] += 1;
+			return false;
+		}
+		cached = value;
+		return true;
+	}
+
+	uint32_t target_index(GLenum target) {
+		for (uint32_t i = 0; i < TEXTURE_TARGET_COUNT; ++i) {
+			if (TEXTURE_TARGETS[i] == target) return i;
+		}
+		return -1U;
+	}
+
+	uint32_t capability_index(GLenum cap) {
+		for (uint32_t i = 0; i < CAPABILITY_COUNT; ++i) {
+			if (CAPABILITIES[i] == cap) return i;
+		}
+		return -1U;
+	}
+
+	//make 'unit' the active texture unit (without counting a request):
+	void set_active_unit(uint32_t unit) {
+		if (cache.active_unit != unit) {
+			glActiveTexture(GL_TEXTURE0 + unit);
+			cache.active_unit = unit;
+		}
+	}
+
+	void set_capability(GLenum cap, GLuint enabled) {
+		uint32_t index = capability_index(cap);
+		if (index == -1U) {
+			current.requested[GLState::Stats::Capability] += 1;
+		} else if (!changes(GLState::Stats::Capability, cache.capabilities[index], enabled)) {
+			return;
+		}
+		if (enabled) glEnable(cap);
+		else glDisable(cap);
+	}
+}
+
+void GLState::use_program(GLuint program) {
+	if (changes(Stats::Program, cache.program, program)) glUseProgram(program);
+}
+
+void GLState::bind_vertex_array(GLuint vao) {
+	if (changes(Stats::VertexArray, cache.vao, vao)) glBindVertexArray(vao);
+}
+
+void GLState::bind_array_buffer(GLuint buffer) {
+	if (changes(Stats::ArrayBuffer, cache.array_buffer, buffer)) glBindBuffer(GL_ARRAY_BUFFER, buffer);
+}
+
+void GLState::active_texture(uint32_t unit) {
+	if (changes(Stats::ActiveTexture, cache.active_unit, unit)) glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLState::bind_texture(uint32_t unit, GLenum target, GLuint texture) {
+	uint32_t index = target_index(target);
+	if (unit >= MAX_TEXTURE_UNITS || index == -1U) {
+		current.requested[Stats::Texture] += 1;
+	} else if (!changes(Stats::Texture, cache.textures[unit][index], texture)) {
+		return;
+	}
+	set_active_unit(unit);
+	glBindTexture(target, texture);
+}
+
+void GLState::bind_texture(GLenum target, GLuint texture) {
+	if (cache.active_unit != UNKNOWN) {
+		bind_texture(cache.active_unit, target, texture);
+		return;
+	}
+	//don't know which unit is active, so don't know which binding this replaces:
+	current.requested[Stats::Texture] += 1;
+	glBindTexture(target, texture);
+	uint32_t index = target_index(target);
+	if (index != -1U) {
+		for (auto &unit : cache.textures) unit[index] = UNKNOWN;
+	}
+}
+
+void GLState::enable(GLenum cap) {
+	set_capability(cap, GL_TRUE);
+}
+
+void GLState::disable(GLenum cap) {
+	set_capability(cap, GL_FALSE);
+}
+
+void GLState::depth_func(GLenum func) {
+	if (changes(Stats::DepthFunc, cache.depth_func, func)) glDepthFunc(func);
+}
+
+void GLState::depth_mask(GLboolean mask) {
+	if (changes(Stats::DepthMask, cache.depth_mask, mask ? GL_TRUE : GL_FALSE)) glDepthMask(mask);
+}
+
+void GLState::blend_func(GLenum sfactor, GLenum dfactor) {
+	current.requested[Stats::BlendFunc] += 1;
+	if (cache.blend_sfactor == sfactor && cache.blend_dfactor == dfactor) {
+		current.skipped[Stats::BlendFunc] += 1;
+		return;
+	}
+	cache.blend_sfactor = sfactor;
+	cache.blend_dfactor = dfactor;
+	glBlendFunc(sfactor, dfactor);
+}
+
+void GLState::invalidate() {
+	cache = Cache();
+}
+
+void GLState::forget_program(GLuint program) {
+	if (cache.program == program) cache.program = UNKNOWN;
+}
+
+void GLState::forget_vertex_array(GLuint vao) {
+	if (cache.vao == vao) cache.vao = UNKNOWN;
+}
+
+void GLState::forget_buffer(GLuint buffer) {
+	if (cache.array_buffer == buffer) cache.array_buffer = UNKNOWN;
+}
+
+void GLState::forget_texture(GLuint texture) {
+	for (auto &unit : cache.textures) {
+		for (auto &cached : unit) {
+			if (cached == texture) cached = UNKNOWN;
+		}
+	}
+}
+
+char const *GLState::Stats::name(Kind kind) {
+	switch (kind) {
+		case Program: return "program";
+		case VertexArray: return "vertex_array";
+		case ArrayBuffer: return "array_buffer";
+		case ActiveTexture: return "active_texture";
+		case Texture: return "texture";
+		case Capability: return "capability";
+		case DepthFunc: return "depth_func";
+		case DepthMask: return "depth_mask";
+		case BlendFunc: return "blend_func";
+		case KindCount: break;
+	}
+	return "?";
+}
+
+uint32_t GLState::Stats::total_requested() const {
+	uint32_t total = 0;
+	for (uint32_t count : requested) total += count;
+	return total;
+}
+
+uint32_t GLState::Stats::total_skipped() const {
+	uint32_t total = 0;
+	for (uint32_t count : skipped) total += count;
+	return total;
+}
+
+GLState::Stats const &GLState::last_frame() {
+	return finished;
+}
+
+void GLState::end_frame() {
+	finished = current;
+	current = Stats();
+
+	if (!print_stats) return;
+
+	//sum over about a second of frames, then print per-frame averages:
+	static Stats sum;
+	static uint32_t frames = 0;
+	static auto started = std::chrono::steady_clock::now();
+	for (uint32_t k = 0; k < Stats::KindCount; ++k) {
+		sum.requested[k] += finished.requested[k];
+		sum.skipped[k] += finished.skipped[k];
+	}
+	frames += 1;
+
+	auto now = std::chrono::steady_clock::now();
+	if (now - started < std::chrono::seconds(1)) return;
+
+	std::cout << std::fixed << std::setprecision(1)
+	          << "GL state: " << float(sum.total_skipped()) / frames << " of " << float(sum.total_requested()) / frames
+	          << " calls per frame were redundant (";
+	bool first = true;
+	for (uint32_t k = 0; k < Stats::KindCount; ++k) {
+		if (sum.requested[k] == 0) continue;
+		if (!first) std::cout << ", ";
+		first = false;
+		std::cout << Stats::name(Stats::Kind(k)) << " " << float(sum.skipped[k]) / frames << "/" << float(sum.requested[k]) / frames;
+	}
+	std::cout << ")" << std::defaultfloat << std::endl;
+
+	sum = Stats();
+	frames = 0;
+	started = now;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+/*
+ * GLState -- a thin cache of the OpenGL state the renderers change most often
+ *  (current program, vertex array, array buffer, active texture unit, per-unit
+ *  texture bindings, and depth/blend settings).
+ *
+ * Each function here compares against the cached value and only calls into
+ *  OpenGL when the state actually changes, so callers can simply ask for the
+ *  state they need for each draw (rather than binding and un-binding around it).
+ *
+ * For the cache to stay correct, code that changes this state should go through
+ *  these functions; after calling OpenGL (or a library that does) directly, call
+ *  invalidate(). Likewise, before deleting a program, vertex array, buffer, or
+ *  texture, call the matching forget_*() so a new object that reuses its name
+ *  isn't mistaken for it.
+ *
+ * Call end_frame() once per frame; last_frame() then reports how many calls were
+ *  requested and how many were dropped as redundant.
+ * Set the GL_STATE_STATS environment variable to print those counts once a second.
+ *
+ */
+
+#include "GL.hpp"
+
+#include <cstdint>
+
+namespace GLState {
+
+//bindings for texture units [0, MAX_TEXTURE_UNITS) are cached (higher units are always passed through):
+constexpr uint32_t const MAX_TEXTURE_UNITS = 16;
+
+//glUseProgram:
+void use_program(GLuint program);
+
+//glBindVertexArray:
+void bind_vertex_array(GLuint vao);
+
+//glBindBuffer(GL_ARRAY_BUFFER, ...):
+// (GL_ELEMENT_ARRAY_BUFFER is part of the vertex array's state, so isn't cached here)
+void bind_array_buffer(GLuint buffer);
+
+//glActiveTexture(GL_TEXTURE0 + unit):
+void active_texture(uint32_t unit);
+
+//glBindTexture on texture unit 'unit' (changing the active unit only if the binding changes):
+void bind_texture(uint32_t unit, GLenum target, GLuint texture);
+
+//glBindTexture on the active unit (as used when creating and uploading textures):
+void bind_texture(GLenum target, GLuint texture);
+
+//glEnable / glDisable:
+// (GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_FRAMEBUFFER_SRGB, GL_LINE_SMOOTH, GL_SCISSOR_TEST,
+//  and GL_STENCIL_TEST are cached; other capabilities are passed through)
+void enable(GLenum cap);
+void disable(GLenum cap);
+
+//glDepthFunc / glDepthMask / glBlendFunc:
+void depth_func(GLenum func);
+void depth_mask(GLboolean mask);
+void blend_func(GLenum sfactor, GLenum dfactor);
+
+//forget all cached state (the next request for each piece of state will call OpenGL):
+// (also call this after creating a new OpenGL context)
+void invalidate();
+
+//forget any cached binding of an object that is about to be deleted (with glDeleteProgram, etc):
+void forget_program(GLuint program);
+void forget_vertex_array(GLuint vao);
+void forget_buffer(GLuint buffer);
+void forget_texture(GLuint texture);
+
+//Per-frame counts of requests made through this cache:
+struct Stats {
+	enum Kind : uint32_t {
+		Program,
+		VertexArray,
+		ArrayBuffer,
+		ActiveTexture,
+		Texture,
+		Capability,
+		DepthFunc,
+		DepthMask,
+		BlendFunc,
+		KindCount
+	};
+	static char const *name(Kind kind);
+
+	uint32_t requested[KindCount] = {}; //calls made to the functions above
+	uint32_t skipped[KindCount] = {}; //...that didn't change anything, so weren't passed on to OpenGL
+
+	uint32_t total_requested() const;
+	uint32_t total_skipped() const;
+};
+
+//counts for the most recently finished frame:
+Stats const &last_frame();
+
+//finish counting the current frame (and print counts once a second if GL_STATE_STATS is set):
+void end_frame();
+
+} //namespace GLState
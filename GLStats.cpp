@@ -0,0 +1,157 @@
+#include "GLStats.hpp"
+
+#ifdef GL_INSTRUMENT
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+//(incremented directly by the wrappers in GL.hpp)
+uint32_t GLStats::calls[GLStats::CallCount] = {};
+
+namespace {
+	GLStats::Frame current; //uploads and draws for the frame in progress (per-call counts are in GLStats::calls)
+	GLStats::Frame finished; //the last finished frame
+
+	//set from the GL_STATS environment variable:
+	bool const print_stats = (std::getenv("GL_STATS") != nullptr);
+
+	//size of one pixel of client data in the given format and type:
+	uint32_t pixel_bytes(GLenum format, GLenum type) {
+		switch (type) {
+			//packed types hold a whole pixel:
+			case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV:
+				return 1;
+			case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV:
+			case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+			case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+				return 2;
+			case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+			case GL_UNSIGNED_INT_10_10_10_2: case GL_UNSIGNED_INT_2_10_10_10_REV:
+			case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_5_9_9_9_REV:
+				return 4;
+			case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+				return 8;
+			default:
+				break;
+		}
+
+		uint32_t component_bytes = 1;
+		switch (type) {
+			case GL_UNSIGNED_BYTE: case GL_BYTE: component_bytes = 1; break;
+			case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: component_bytes = 2; break;
+			case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: component_bytes = 4; break;
+			default: break;
+		}
+
+		uint32_t components = 4;
+		switch (format) {
+			case GL_RED: case GL_GREEN: case GL_BLUE:
+			case GL_RED_INTEGER: case GL_GREEN_INTEGER: case GL_BLUE_INTEGER:
+			case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+				components = 1; break;
+			case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:
+				components = 2; break;
+			case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+				components = 3; break;
+			default:
+				break;
+		}
+
+		return components * component_bytes;
+	}
+
+	//points, lines, or triangles made by 'count' vertices:
+	uint64_t primitive_count(GLenum mode, GLsizei count_) {
+		uint64_t count = uint64_t(std::max(count_, 0));
+		switch (mode) {
+			case GL_POINTS: return count;
+			case GL_LINES: return count / 2;
+			case GL_LINE_STRIP: return (count >= 2 ? count - 1 : 0);
+			case GL_LINE_LOOP: return (count >= 2 ? count : 0);
+			case GL_TRIANGLES: return count / 3;
+			case GL_TRIANGLE_STRIP: case GL_TRIANGLE_FAN: return (count >= 3 ? count - 2 : 0);
+			case GL_LINES_ADJACENCY: return count / 4;
+			case GL_LINE_STRIP_ADJACENCY: return (count >= 4 ? count - 3 : 0);
+			case GL_TRIANGLES_ADJACENCY: return count / 6;
+			case GL_TRIANGLE_STRIP_ADJACENCY: return (count >= 6 ? (count - 4) / 2 : 0);
+			default: return 0;
+		}
+	}
+}
+
+void GLStats::note_upload(size_t bytes) {
+	current.bytes_uploaded += bytes;
+}
+
+void GLStats::note_image_upload(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels) {
+	if (!pixels) return; //(only allocating storage)
+	current.bytes_uploaded += uint64_t(std::max(width, 0)) * uint64_t(std::max(height, 0)) * uint64_t(std::max(depth, 0)) * pixel_bytes(format, type);
+}
+
+void GLStats::note_draw(GLenum mode, GLsizei count, GLsizei instances) {
+	current.draw_calls += 1;
+	current.primitives += primitive_count(mode, count) * uint64_t(std::max(instances, 0));
+}
+
+GLStats::Frame const &GLStats::last_frame() {
+	return finished;
+}
+
+void GLStats::end_frame() {
+	finished = current;
+	for (uint32_t c = 0; c < CallCount; ++c) {
+		finished.calls[c] = calls[c];
+		finished.total_calls += calls[c];
+		calls[c] = 0;
+	}
+	current = Frame();
+
+	if (!print_stats) return;
+
+	//sum over about a second of frames, then print per-frame averages:
+	static Frame sum;
+	static uint32_t frames = 0;
+	static auto started = std::chrono::steady_clock::now();
+	sum.total_calls += finished.total_calls;
+	sum.bytes_uploaded += finished.bytes_uploaded;
+	sum.draw_calls += finished.draw_calls;
+	sum.primitives += finished.primitives;
+	for (uint32_t c = 0; c < CallCount; ++c) {
+		sum.calls[c] += finished.calls[c];
+	}
+	frames += 1;
+
+	auto now = std::chrono::steady_clock::now();
+	if (now - started < std::chrono::seconds(1)) return;
+
+	//most-called entry points first:
+	std::vector< uint32_t > order;
+	for (uint32_t c = 0; c < CallCount; ++c) {
+		if (sum.calls[c] > 0) order.emplace_back(c);
+	}
+	std::stable_sort(order.begin(), order.end(), [](uint32_t a, uint32_t b) {
+		return sum.calls[a] > sum.calls[b];
+	});
+	if (order.size() > 8) order.resize(8);
+
+	std::cout << std::fixed << std::setprecision(1)
+	          << "GL: " << double(sum.total_calls) / frames << " calls, "
+	          << double(sum.bytes_uploaded) / frames / 1024.0 << " KiB uploaded, "
+	          << double(sum.draw_calls) / frames << " draws, "
+	          << double(sum.primitives) / frames << " primitives per frame (";
+	for (uint32_t c : order) {
+		if (c != order[0]) std::cout << ", ";
+		std::cout << call_names[c] << " " << double(sum.calls[c]) / frames;
+	}
+	std::cout << ")" << std::defaultfloat << std::endl;
+
+	sum = Frame();
+	frames = 0;
+	started = now;
+}
+
+#endif //GL_INSTRUMENT
@@ -0,0 +1,53 @@
+#pragma once
+
+/*
+ * GLStats -- per-frame counts of OpenGL calls (per entry point), bytes uploaded
+ *  through glBufferData / glBufferSubData / glTex[Sub]Image* / glCompressedTex*,
+ *  and draw calls and primitives drawn.
+ *
+ * Counting is done by the instrumented wrappers that make-GL.py generates in
+ *  GL.hpp, which are only compiled in when GL_INSTRUMENT is defined
+ *  (see GL_INSTRUMENT in Maekfile.js). Otherwise every gl* call goes straight
+ *  to the driver, end_frame() does nothing, and last_frame() is all zeros.
+ *
+ * Call end_frame() once per frame. When instrumented, set the GL_STATS environment
+ *  variable to print per-frame averages (and the most-called entry points) once a second.
+ *
+ * Texture upload sizes ignore GL_UNPACK_* row padding.
+ *
+ */
+
+#include "GL.hpp"
+
+#include <cstdint>
+
+namespace GLStats {
+
+#ifdef GL_INSTRUMENT
+constexpr bool const enabled = true;
+#else
+constexpr bool const enabled = false;
+#endif
+
+struct Frame {
+	uint32_t total_calls = 0; //calls to any gl* entry point
+	uint64_t bytes_uploaded = 0;
+	uint32_t draw_calls = 0; //glDraw* calls (glMultiDraw* counts each draw it makes)
+	uint64_t primitives = 0; //points, lines, or triangles drawn (times instances)
+#ifdef GL_INSTRUMENT
+	uint32_t calls[CallCount] = {}; //per entry point (names in call_names)
+#endif
+};
+
+#ifdef GL_INSTRUMENT
+//counts for the most recently finished frame:
+Frame const &last_frame();
+
+//finish counting the current frame (and print counts once a second if GL_STATS is set):
+void end_frame();
+#else
+inline Frame const &last_frame() { static Frame const empty; return empty; }
+inline void end_frame() { }
+#endif
+
+} //namespace GLStats
@@ -1,6 +1,8 @@
 #include "LitColorTextureProgram.hpp"
 
+#include "GLState.hpp"
 #include "gl_compile_program.hpp"
+#include "gl_debug_output.hpp"
 #include "gl_errors.hpp"
 
 Scene::Drawable::Pipeline lit_color_texture_program_pipeline;
@@ -27,14 +29,15 @@ Load< LitColorTextureProgram > lit_color_texture_program(LoadTagEarly, []() -> L
 	GLuint tex;
 	glGenTextures(1, &tex);
 
-	glBindTexture(GL_TEXTURE_2D, tex);
+	GLState::bind_texture(GL_TEXTURE_2D, tex);
+	gl_label(GL_TEXTURE, tex, "LitColorTextureProgram default texture"); //(names it in debug messages)
 	std::vector< glm::u8vec4 > tex_data(1, glm::u8vec4(0xff));
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, tex_data.data());
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::bind_texture(GL_TEXTURE_2D, 0);
 
 
 	lit_color_texture_program_pipeline.textures[0].texture = tex;
@@ -109,6 +112,8 @@ LitColorTextureProgram::LitColorTextureProgram() {
 	//As you can see above, adjacent strings in C/C++ are concatenated.
 	// this is very useful for writing long shader programs inline.
 
+	gl_label(GL_PROGRAM, program, "LitColorTextureProgram"); //(names it in debug messages)
+
 	//look up the locations of vertex attributes:
 	Position_vec4 = glGetAttribLocation(program, "Position");
 	Normal_vec3 = glGetAttribLocation(program, "Normal");
@@ -130,14 +135,15 @@ LitColorTextureProgram::LitColorTextureProgram() {
 	GLuint TEX_sampler2D = glGetUniformLocation(program, "TEX");
 
 	//set TEX to always refer to texture binding zero:
-	glUseProgram(program); //bind program -- glUniform* calls refer to this program now
+	GLState::use_program(program); //bind program -- glUniform* calls refer to this program now
 
 	glUniform1i(TEX_sampler2D, 0); //set TEX to sample from GL_TEXTURE0
 
-	glUseProgram(0); //unbind program -- glUniform* calls refer to ??? now
+	GLState::use_program(0); //unbind program -- glUniform* calls refer to ??? now
 }
 
 LitColorTextureProgram::~LitColorTextureProgram() {
+	GLState::forget_program(program);
 	glDeleteProgram(program);
 	program = 0;
 }
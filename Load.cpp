@@ -1,20 +1,27 @@
 #include "Load.hpp"
+#include "StartupProfile.hpp"
 
 #include <array>
 #include <list>
 #include <cassert>
 
 namespace {
-	std::array< std::list< std::function< void() > >, MaxLoadTag > &get_load_lists() {
-		static std::array< std::list< std::function< void() > >, MaxLoadTag > load_lists;
+	struct LoadFunction {
+		std::function< void() > fn;
+		char const *file; //where the function was added (for StartupProfile)
+		uint32_t line;
+	};
+
+	std::array< std::list< LoadFunction >, MaxLoadTag > &get_load_lists() {
+		static std::array< std::list< LoadFunction >, MaxLoadTag > load_lists;
 		return load_lists;
 	}
 }
 
-void add_load_function(LoadTag tag, std::function< void() > const &fn) {
+void add_load_function(LoadTag tag, std::function< void() > const &fn, char const *file, uint32_t line) {
 	auto &load_lists = get_load_lists();
 	assert(tag < load_lists.size());
-	load_lists[tag].emplace_back(fn);
+	load_lists[tag].emplace_back(LoadFunction{fn, file, line});
 }
 
 void call_load_functions() {
@@ -22,10 +29,17 @@ void call_load_functions() {
 	assert(!has_been_called && "call_load_functions should only be called *once*");
 	has_been_called = true;
 
+	static char const *tag_names[MaxLoadTag] = { "LoadTagEarly", "LoadTagDefault", "LoadTagLate" };
+
 	auto &load_lists = get_load_lists();
-	for (auto &fn_list : load_lists) {
+	for (uint32_t tag = 0; tag < load_lists.size(); ++tag) {
+		auto &fn_list = load_lists[tag];
 		while (!fn_list.empty()) {
-			(*fn_list.begin())(); //call first function in the list
+			{ //call first function in the list:
+				LoadFunction const &load = *fn_list.begin();
+				StartupProfile::Scope scope("load function", "load", load.file, load.line, tag_names[tag]);
+				load.fn();
+			}
 			fn_list.pop_front(); //remove from list
 		}
 	}
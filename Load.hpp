@@ -35,7 +35,8 @@ enum LoadTag : uint32_t {
 
 //Add a function to an internal list of loading functions:
 // (only call *before* "call_load_functions()")
-void add_load_function(LoadTag tag, std::function< void() > const &fn);
+// 'file' and 'line' default to the caller's location, and are used to label the function in StartupProfile output.
+void add_load_function(LoadTag tag, std::function< void() > const &fn, char const *file = __builtin_FILE(), uint32_t line = __builtin_LINE());
 
 //Call all loading functions:
 // (loading functions may throw exceptions if they fail.)
@@ -50,13 +51,13 @@ T const *new_T() { return new T; }
 template< typename T >
 struct Load {
 	//Constructing a Load< T > adds the passed function to the list of functions to call:
-	Load(LoadTag tag, const std::function< T const *() > &load_fn = new_T< T >) : value(nullptr) {
+	Load(LoadTag tag, const std::function< T const *() > &load_fn = new_T< T >, char const *file = __builtin_FILE(), uint32_t line = __builtin_LINE()) : value(nullptr) {
 		add_load_function(tag, [this,load_fn](){
 			this->value = load_fn();
 			if (!(this->value)) {
 				throw std::runtime_error("Loading failed.");
 			}
-		});
+		}, file, line);
 	}
 
 	//Make a "Load< T >" behave like a "T const *":
@@ -74,8 +75,8 @@ struct Load {
 template< >
 struct Load< void > {
 	//Constructing a Load< T > adds the passed function to the list of functions to call:
-	Load( LoadTag tag, const std::function< void() > &load_fn) {
-		add_load_function(tag, load_fn);
+	Load( LoadTag tag, const std::function< void() > &load_fn, char const *file = __builtin_FILE(), uint32_t line = __builtin_LINE()) {
+		add_load_function(tag, load_fn, file, line);
 	}
 };
 
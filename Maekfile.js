@@ -102,6 +102,18 @@ if (maek.OS === "windows") {
 		`-L${NEST_LIBS}/freetype/lib`, `-lfreetype`
 	);
 }
+//set to true to count every OpenGL call, upload, and draw (see GLStats.hpp); when false, the counting compiles to nothing:
+const GL_INSTRUMENT = false;
+if (GL_INSTRUMENT) {
+	maek.options.CPPFlags.push(maek.OS === "windows" ? `/DGL_INSTRUMENT` : `-DGL_INSTRUMENT`);
+}
+//set to true to compile GL_ERRORS() checks (see gl_errors.hpp) to nothing, e.g. for release builds:
+// (debug callback messages are still printed once per frame)
+const GL_NO_ERRORS = false;
+if (GL_NO_ERRORS) {
+	maek.options.CPPFlags.push(maek.OS === "windows" ? `/DGL_NO_ERRORS` : `-DGL_NO_ERRORS`);
+}
+
 //use COPY to copy a file
 // 'COPY(from, to)'
 // from: file to copy from
@@ -120,6 +132,24 @@ if (maek.OS === 'windows') {
 	copies.push( maek.COPY(`${NEST_LIBS}/SDL2/dist/SDL2.dll`, `dist/SDL2.dll`) );
 }
 
+//use RULE to run commands that generate files:
+// 'RULE(targets, prerequisites, recipe)'
+// targets: array of files made by the recipe
+// prerequisites: array of files read by the recipe
+// recipe: array of commands (each an array of strings) to run
+
+//assets (paths relative to dist/) that get compiled into the game executable:
+// (see EmbeddedAssets.hpp -- loading these requires no file I/O)
+const embedded_assets = [
+	'hexapod.pnct',
+	'hexapod.scene'
+];
+const [embedded_assets_cpp] = maek.RULE(
+	['objs/embedded-assets.cpp'],
+	['make-embedded-assets.py', ...embedded_assets.map(asset => `dist/${asset}`)],
+	[ [(maek.OS === 'windows' ? 'python.exe' : 'python3'), 'make-embedded-assets.py', 'objs/embedded-assets.cpp', 'dist', ...embedded_assets] ]
+);
+
 //call rules on the maek object to specify tasks.
 // rules generally look like:
 //  output = maek.RULE_NAME(input [, output] [, {options}])
@@ -128,18 +158,41 @@ if (maek.OS === 'windows') {
 // cppFile: name of c++ file to compile
 // objFileBase (optional): base name object file to produce (if not supplied, set to options.objDir + '/' + cppFile without the extension)
 //returns objFile: objFileBase + a platform-dependant suffix ('.o' or '.obj')
+//(the audio mixing kernels, sample codecs, resampler, and convolution engine are shared by the game and the audio benchmarks;
+// the whole audio system is shared by the game and the offline renderer)
+const mix_kernels_obj = maek.CPP('mix_kernels.cpp');
+const ima_adpcm_obj = maek.CPP('ima_adpcm.cpp');
+const resample_obj = maek.CPP('resample.cpp');
+const convolve_obj = maek.CPP('convolve.cpp');
+const data_path_obj = maek.CPP('data_path.cpp');
+const startup_profile_obj = maek.CPP('StartupProfile.cpp');
+
+const sound_names = [
+	maek.CPP('Sound.cpp'),
+	mix_kernels_obj,
+	ima_adpcm_obj,
+	resample_obj,
+	convolve_obj,
+	maek.CPP('load_wav.cpp'),
+	maek.CPP('load_opus.cpp'),
+	maek.CPP('OpusStream.cpp'),
+	maek.CPP('AudioCache.cpp'),
+	maek.CPP('MappedFile.cpp')
+];
+
 const game_names = [
 	maek.CPP('PlayMode.cpp'),
 	maek.CPP('main.cpp'),
 	maek.CPP('LitColorTextureProgram.cpp'),
 	//maek.CPP('ColorTextureProgram.cpp'),  //not used right now, but you might want it
-	maek.CPP('Sound.cpp'),
-	maek.CPP('load_wav.cpp'),
-	maek.CPP('load_opus.cpp')
+	...sound_names,
+	maek.CPP('EmbeddedAssets.cpp'),
+	maek.CPP('AssetWatch.cpp'),
+	maek.CPP(embedded_assets_cpp, 'objs/embedded-assets')
 ];
 
 const common_names = [
-	maek.CPP('data_path.cpp'),
+	data_path_obj,
 	maek.CPP('PathFont.cpp'),
 	maek.CPP('PathFont-font.cpp'),
 	maek.CPP('DrawLines.cpp'),
@@ -148,9 +201,13 @@ const common_names = [
 	maek.CPP('Mesh.cpp'),
 	maek.CPP('load_save_png.cpp'),
 	maek.CPP('gl_compile_program.cpp'),
+	maek.CPP('gl_debug_output.cpp'),
 	maek.CPP('Mode.cpp'),
 	maek.CPP('GL.cpp'),
-	maek.CPP('Load.cpp')
+	maek.CPP('GLState.cpp'),
+	maek.CPP('GLStats.cpp'),
+	maek.CPP('Load.cpp'),
+	startup_profile_obj
 ];
 
 const show_meshes_names = [
@@ -169,6 +226,29 @@ const freetype_test_names = [
 	maek.CPP('freetype-test.cpp')
 ];
 
+const bench_mix_names = [
+	maek.CPP('bench-mix.cpp'),
+	mix_kernels_obj,
+	ima_adpcm_obj
+];
+
+const bench_resample_names = [
+	maek.CPP('bench-resample.cpp'),
+	resample_obj
+];
+
+const bench_convolve_names = [
+	maek.CPP('bench-convolve.cpp'),
+	convolve_obj
+];
+
+const render_audio_names = [
+	maek.CPP('render-audio.cpp'),
+	...sound_names,
+	data_path_obj,
+	startup_profile_obj
+];
+
 //the '[exeFile =] LINK(objFiles, exeFileBase, [, options])' links an array of objects into an executable:
 // objFiles: array of objects to link
 // exeFileBase: name of executable file to produce
@@ -179,8 +259,13 @@ const show_scene_exe = maek.LINK([...show_scene_names, ...common_names], 'scenes
 
 const freetype_test_exe = maek.LINK([...freetype_test_names], 'freetype-test');
 
+const bench_mix_exe = maek.LINK([...bench_mix_names], 'bench-mix');
+const bench_resample_exe = maek.LINK([...bench_resample_names], 'bench-resample');
+const bench_convolve_exe = maek.LINK([...bench_convolve_names], 'bench-convolve');
+const render_audio_exe = maek.LINK([...render_audio_names], 'render-audio');
+
 //set the default target to the game (and copy the readme files):
-maek.TARGETS = [game_exe, show_meshes_exe, show_scene_exe, freetype_test_exe, ...copies];
+maek.TARGETS = [game_exe, show_meshes_exe, show_scene_exe, freetype_test_exe, bench_mix_exe, bench_resample_exe, bench_convolve_exe, render_audio_exe, ...copies];
 
 //Note that tasks that produce ':abstract targets' are never cached.
 // This is similar to how .PHONY targets behave in make.
@@ -316,6 +401,45 @@ function init_maek() {
 	};
 
 
+	//RULE adds a task that runs a list of commands to make some target files from some prerequisite files:
+	// targets is an array of files that the commands produce
+	// prerequisites is an array of files that the commands read
+	// recipe is an array of commands (each one an array of strings) to run in order
+	//returns targets
+	maek.RULE = (targets, prerequisites, recipe) => {
+		if (!Array.isArray(targets)) throw new Error("RULE: targets should be an array.");
+		if (!Array.isArray(prerequisites)) throw new Error("RULE: prerequisites should be an array.");
+		if (!Array.isArray(recipe)) throw new Error("RULE: recipe should be an array of commands.");
+
+		const task = async () => {
+			for (const target of targets) {
+				await fsPromises.mkdir(path.dirname(target), { recursive: true });
+			}
+			for (const command of recipe) {
+				await run(command, `${task.label}: ${command.join(' ')}`,
+					async () => {
+						return {
+							read:[...prerequisites],
+							written:[...targets]
+						};
+					}
+				);
+			}
+		};
+
+		task.depends = [...prerequisites];
+		task.label = `RULE ${targets.join(', ')}`;
+
+		for (const target of targets) {
+			if (target in maek.tasks) {
+				throw new Error(`Task ${task.label} purports to create ${target}, but ${maek.tasks[target].label} already creates that file.`);
+			}
+			maek.tasks[target] = task;
+		}
+
+		return targets;
+	};
+
 	//maek.CPP makes an object from a c++ source file:
 	// cppFile is the source file name
 	// objFileBase (optional) is the output file (including any subdirectories, but not the extension)
@@ -0,0 +1,81 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(std::string const &filename) {
+	file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		file = nullptr;
+		throw std::runtime_error("Failed to open '" + filename + "' for mapping (error " + std::to_string(GetLastError()) + ").");
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		throw std::runtime_error("Failed to get size of '" + filename + "' (error " + std::to_string(GetLastError()) + ").");
+	}
+	bytes.size = size_t(size.QuadPart);
+	if (bytes.size == 0) return; //(can't map an empty file)
+
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping != NULL) {
+		bytes.data = reinterpret_cast< uint8_t const * >(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	}
+	if (bytes.data == nullptr) {
+		DWORD error = GetLastError();
+		if (mapping) CloseHandle(mapping);
+		CloseHandle(file);
+		throw std::runtime_error("Failed to map '" + filename + "' (error " + std::to_string(error) + ").");
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (bytes.data) UnmapViewOfFile(bytes.data);
+	if (mapping) CloseHandle(mapping);
+	if (file) CloseHandle(file);
+}
+
+#else
+
+MappedFile::MappedFile(std::string const &filename) {
+	int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		throw std::runtime_error("Failed to open '" + filename + "' for mapping (" + std::strerror(errno) + ").");
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		int error = errno;
+		close(fd);
+		throw std::runtime_error("Failed to get size of '" + filename + "' (" + std::strerror(error) + ").");
+	}
+	bytes.size = size_t(st.st_size);
+	if (bytes.size != 0) { //(can't map an empty file)
+		void *addr = mmap(nullptr, bytes.size, PROT_READ, MAP_SHARED, fd, 0);
+		if (addr == MAP_FAILED) {
+			int error = errno;
+			close(fd);
+			throw std::runtime_error("Failed to map '" + filename + "' (" + std::strerror(error) + ").");
+		}
+		bytes.data = reinterpret_cast< uint8_t const * >(addr);
+	}
+	//(the mapping stays valid after the file is closed)
+	close(fd);
+}
+
+MappedFile::~MappedFile() {
+	if (bytes.data) munmap(const_cast< uint8_t * >(bytes.data), bytes.size);
+}
+
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+/*
+ * MappedFile -- a read-only memory mapping of a whole file.
+ *
+ * The mapping lasts as long as the MappedFile; pages are loaded on first
+ *  touch and shared with any other process that maps the same file.
+ *
+ */
+
+#include "ByteSpan.hpp"
+
+#include <string>
+
+struct MappedFile {
+	//map 'filename'; throws on error:
+	MappedFile(std::string const &filename);
+	~MappedFile();
+	MappedFile(MappedFile const &) = delete;
+	MappedFile &operator=(MappedFile const &) = delete;
+
+	ByteSpan bytes; //the file's contents
+
+private:
+	#if defined(_WIN32)
+	void *file = nullptr;
+	void *mapping = nullptr;
+	#endif
+};
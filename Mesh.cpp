@@ -1,4 +1,6 @@
 #include "Mesh.hpp"
+#include "GLState.hpp"
+#include "gl_debug_output.hpp"
 #include "read_write_chunk.hpp"
 
 #include <glm/glm.hpp>
@@ -12,10 +14,21 @@
 #include <cstddef>
 
 MeshBuffer::MeshBuffer(std::string const &filename) {
-	glGenBuffers(1, &buffer);
+	std::ifstream file(filename, std::ios::binary);
+	load(file, filename);
+}
+
+MeshBuffer::MeshBuffer(ByteSpan const &bytes, std::string const &name) {
+	ByteSpanStream file(bytes);
+	load(file, name);
+}
 
+void MeshBuffer::reload(std::string const &filename) {
 	std::ifstream file(filename, std::ios::binary);
+	load(file, filename);
+}
 
+void MeshBuffer::load(std::istream &file, std::string const &filename) {
 	GLuint total = 0;
 
 	struct Vertex {
@@ -27,15 +40,11 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 	static_assert(sizeof(Vertex) == 3*4+3*4+4*1+2*4, "Vertex is packed.");
 	std::vector< Vertex > data;
 
-	//read + upload data chunk:
+	//read data chunk:
+	// (upload happens after everything is read, so a failed reload leaves the buffer untouched)
 	if (filename.size() >= 5 && filename.substr(filename.size()-5) == ".pnct") {
 		read_chunk(file, "pnct", &data);
 
-		//upload data:
-		glBindBuffer(GL_ARRAY_BUFFER, buffer);
-		glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(Vertex), data.data(), GL_STATIC_DRAW);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-
 		total = GLuint(data.size()); //store total for later checks on index
 
 		//store attrib locations:
@@ -50,6 +59,8 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 	std::vector< char > strings;
 	read_chunk(file, "str0", &strings);
 
+	std::map< std::string, Mesh > loaded_meshes;
+
 	{ //read index chunk, add to meshes:
 		struct IndexEntry {
 			uint32_t name_begin, name_end;
@@ -76,7 +87,7 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 				mesh.min = glm::min(mesh.min, data[v].Position);
 				mesh.max = glm::max(mesh.max, data[v].Position);
 			}
-			bool inserted = meshes.insert(std::make_pair(name, mesh)).second;
+			bool inserted = loaded_meshes.insert(std::make_pair(name, mesh)).second;
 			if (!inserted) {
 				std::cerr << "WARNING: mesh name '" + name + "' in filename '" + filename + "' collides with existing mesh." << std::endl;
 			}
@@ -87,6 +98,23 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 		std::cerr << "WARNING: trailing data in mesh file '" << filename << "'" << std::endl;
 	}
 
+	//upload data:
+	// (on reload, the buffer object itself is kept, so vertex arrays made by make_vao_for_program stay valid)
+	if (buffer == 0) glGenBuffers(1, &buffer);
+	GLState::bind_array_buffer(buffer);
+	if (data.size() * sizeof(Vertex) == buffer_size) {
+		//same size as what's already there (common when tweaking an existing mesh), so update in place:
+		glBufferSubData(GL_ARRAY_BUFFER, 0, buffer_size, data.data());
+	} else {
+		buffer_size = data.size() * sizeof(Vertex);
+		glBufferData(GL_ARRAY_BUFFER, buffer_size, data.data(), GL_STATIC_DRAW);
+	}
+	gl_label(GL_BUFFER, buffer, filename.c_str()); //(names it in debug messages)
+	GLState::bind_array_buffer(0);
+	StartupProfile::note_bytes_uploaded(data.size() * sizeof(Vertex));
+
+	meshes = std::move(loaded_meshes);
+
 	/* //DEBUG:
 	std::cout << "File '" << filename << "' contained meshes";
 	for (auto const &m : meshes) {
@@ -110,11 +138,11 @@ GLuint MeshBuffer::make_vao_for_program(GLuint program) const {
 	//create a new vertex array object:
 	GLuint vao = 0;
 	glGenVertexArrays(1, &vao);
-	glBindVertexArray(vao);
+	GLState::bind_vertex_array(vao);
 
 	//Try to bind all attributes in this buffer:
 	std::set< GLuint > bound;
-	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	GLState::bind_array_buffer(buffer);
 	auto bind_attribute = [&](char const *name, MeshBuffer::Attrib const &attrib) {
 		if (attrib.size == 0) return; //don't bind empty attribs
 		GLint location = glGetAttribLocation(program, name);
@@ -127,8 +155,8 @@ GLuint MeshBuffer::make_vao_for_program(GLuint program) const {
 	bind_attribute("Normal", Normal);
 	bind_attribute("Color", Color);
 	bind_attribute("TexCoord", TexCoord);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::bind_array_buffer(0);
+	GLState::bind_vertex_array(0);
 
 	//Check that all active attributes were bound:
 	GLint active = 0;
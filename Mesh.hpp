@@ -10,6 +10,7 @@
  */
 
 #include "GL.hpp"
+#include "ByteSpan.hpp"
 #include <glm/glm.hpp>
 #include <map>
 #include <limits>
@@ -34,6 +35,17 @@ struct MeshBuffer {
 	// note: will throw if file fails to read.
 	MeshBuffer(std::string const &filename);
 
+	//construct from file contents that are already in memory (e.g., an embedded asset):
+	// 'name' is used to determine the file type (by extension) and in error messages
+	// note: will throw if data fails to parse.
+	MeshBuffer(ByteSpan const &bytes, std::string const &name);
+
+	//re-read mesh data from a file (e.g., after it is re-exported while the game is running):
+	// 'buffer' keeps its name, so existing vertex array objects stay valid
+	// note: will throw if file fails to read, in which case nothing is changed.
+	// note: Mesh references returned by lookup() before the reload are invalidated.
+	void reload(std::string const &filename);
+
 	//look up a particular mesh by name:
 	// note: will throw if mesh not found.
 	const Mesh &lookup(std::string const &name) const;
@@ -47,6 +59,12 @@ struct MeshBuffer {
 
 	//-- internals ---
 
+	//used by the constructors and reload() to read and upload the mesh data:
+	void load(std::istream &from, std::string const &filename);
+
+	//size (in bytes) of the data currently in 'buffer':
+	size_t buffer_size = 0;
+
 	//used by the lookup() function:
 	std::map< std::string, Mesh > meshes;
 
@@ -0,0 +1,255 @@
+#include "OpusStream.hpp"
+#include "mix_kernels.hpp"
+
+#include <opusfile.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//local (to this file) data used by the decoder:
+namespace {
+	struct Stream {
+		//control, protected by 'mutex':
+		enum State : uint8_t {
+			Free, //not in use
+			Opening, //open() was called; decoder hasn't opened the file yet
+			Playing, //decoder is keeping the ring full
+			Closing, //close() was called; decoder will close the file and free the slot
+		} state = Free;
+		Sound::Sample const *sample = nullptr;
+		bool loop = false;
+
+		//decoder thread only:
+		OggOpusFile *op = nullptr;
+		uint64_t decoded_since_seek = 0; //(guards against looping an empty file forever)
+
+		//decoded audio -- written by the decoder thread, read by the audio thread:
+		// ('written' and 'read' count samples forever; masked to index 'ring')
+		std::vector< float > ring;
+		std::atomic< uint64_t > written{0};
+		std::atomic< uint64_t > read{0};
+		std::atomic< bool > ended{false}; //set after the last sample of a non-looping stream is written
+	};
+
+	std::vector< Stream > streams;
+
+	std::mutex mutex;
+	std::condition_variable wake; //signalled when there is work for the decoder
+	bool quit = false; //(protected by mutex)
+	bool requested = false; //open() or close() was called since the decoder last checked the streams (protected by mutex)
+	std::thread decoder;
+
+	//how often the decoder checks for ring space while any stream is playing:
+	// (must be well under RING_SAMPLES / 48000 seconds; with nothing to decode, it sleeps until woken)
+	constexpr std::chrono::milliseconds const DECODE_INTERVAL = std::chrono::milliseconds(5);
+
+	//open a stream's file and seek to just after the part of the sample already in memory:
+	OggOpusFile *open_stream(Sound::Sample const &sample) {
+		int err = 0;
+		OggOpusFile *op = nullptr;
+		//(samples loaded from memory still have a name -- for messages -- so check for the bytes, not the name)
+		if (sample.stream_bytes.data) {
+			op = op_open_memory(sample.stream_bytes.data, sample.stream_bytes.size, &err);
+		} else {
+			op = op_open_file(sample.stream_filename.c_str(), &err);
+		}
+		if (err != 0 || !op) {
+			std::cerr << "WARNING: opusfile error " << err << " opening '" << sample.stream_filename << "' for streaming." << std::endl;
+			if (op) op_free(op);
+			return nullptr;
+		}
+		err = op_pcm_seek(op, ogg_int64_t(sample.data.size()));
+		if (err != 0) {
+			std::cerr << "WARNING: opusfile error " << err << " seeking in '" << sample.stream_filename << "' for streaming." << std::endl;
+			op_free(op);
+			return nullptr;
+		}
+		return op;
+	}
+
+	//decoder thread: decode into a stream's ring until it is (nearly) full:
+	void fill(Stream &stream) {
+		if (stream.ended.load(std::memory_order_relaxed)) return;
+		if (!stream.op) {
+			stream.ended.store(true, std::memory_order_release);
+			return;
+		}
+
+		//(op_read_float_stereo returns at most one packet -- at most 120ms -- per call)
+		float pcm[2 * 5760];
+		for (;;) {
+			uint64_t written = stream.written.load(std::memory_order_relaxed);
+			//(the HISTORY_SAMPLES before the read position stay put; see OpusStream::history)
+			uint64_t space = OpusStream::RING_SAMPLES - OpusStream::HISTORY_SAMPLES - (written - stream.read.load(std::memory_order_acquire));
+			if (space < 1024) break; //wait for room to do a reasonably-sized read
+
+			int ret = op_read_float_stereo(stream.op, pcm, int(2 * std::min< uint64_t >(space, 5760)));
+			if (ret < 0) {
+				std::cerr << "WARNING: opusfile read error " << ret << " streaming '" << stream.sample->stream_filename << "'." << std::endl;
+				stream.ended.store(true, std::memory_order_release);
+				break;
+			}
+			if (ret == 0) { //end of file
+				if (stream.loop && stream.decoded_since_seek > 0 && op_pcm_seek(stream.op, 0) == 0) {
+					stream.decoded_since_seek = 0;
+					continue;
+				}
+				stream.ended.store(true, std::memory_order_release);
+				break;
+			}
+
+			//downmix to mono into the ring (in two parts if the write wraps around):
+			uint32_t begin = uint32_t(written & (OpusStream::RING_SAMPLES - 1));
+			uint32_t first = std::min(uint32_t(ret), OpusStream::RING_SAMPLES - begin);
+			downmix_stereo_to_mono(pcm, first, stream.ring.data() + begin);
+			downmix_stereo_to_mono(pcm + 2 * first, uint32_t(ret) - first, stream.ring.data());
+			stream.decoded_since_seek += ret;
+			stream.written.store(written + ret, std::memory_order_release);
+		}
+	}
+
+	void decoder_thread() {
+		std::unique_lock< std::mutex > lock(mutex);
+		while (!quit) {
+			requested = false;
+			bool decoding = false; //is any stream still being decoded? (if not, nothing changes until open() or close())
+			for (auto &stream : streams) {
+				if (stream.state == Stream::Opening) {
+					Sound::Sample const &sample = *stream.sample;
+					lock.unlock();
+					OggOpusFile *op = open_stream(sample);
+					lock.lock();
+					stream.op = op;
+					stream.decoded_since_seek = 0;
+					if (stream.state == Stream::Opening) stream.state = Stream::Playing;
+					//(if state is now Closing, the next check cleans up)
+				}
+				if (stream.state == Stream::Closing) {
+					if (stream.op) {
+						op_free(stream.op);
+						stream.op = nullptr;
+					}
+					stream.sample = nullptr;
+					stream.state = Stream::Free;
+				}
+				if (stream.state == Stream::Playing) {
+					//n.b. only the decoder thread changes state away from Playing (to Free), so 'stream' stays valid:
+					lock.unlock();
+					fill(stream);
+					lock.lock();
+					if (!stream.ended.load(std::memory_order_relaxed)) decoding = true;
+				}
+			}
+			if (decoding) {
+				wake.wait_for(lock, DECODE_INTERVAL);
+			} else {
+				//(open() or close() may have been called while the lock was released above, so check before sleeping)
+				wake.wait(lock, [](){ return requested || quit; });
+			}
+		}
+
+		//close any remaining streams:
+		for (auto &stream : streams) {
+			if (stream.op) {
+				op_free(stream.op);
+				stream.op = nullptr;
+			}
+			stream.state = Stream::Free;
+		}
+	}
+}
+
+void OpusStream::start() {
+	assert(!decoder.joinable() && "OpusStream::start should only be called once");
+	streams = std::vector< Stream >(MAX_STREAMS);
+	for (auto &stream : streams) {
+		stream.ring.assign(RING_SAMPLES, 0.0f);
+	}
+	quit = false;
+	decoder = std::thread(decoder_thread);
+}
+
+void OpusStream::stop() {
+	if (!decoder.joinable()) return;
+	{
+		std::lock_guard< std::mutex > lock(mutex);
+		quit = true;
+	}
+	wake.notify_one();
+	decoder.join();
+}
+
+uint32_t OpusStream::open(Sound::Sample const &sample, bool loop) {
+	assert(sample.streamed);
+	std::lock_guard< std::mutex > lock(mutex);
+	if (!decoder.joinable()) return -1U;
+	for (uint32_t s = 0; s < streams.size(); ++s) {
+		Stream &stream = streams[s];
+		if (stream.state != Stream::Free) continue;
+
+		//(nothing else touches a free slot, so it is safe to reset the ring here)
+		stream.sample = &sample;
+		stream.loop = loop;
+		stream.written.store(0, std::memory_order_relaxed);
+		stream.read.store(0, std::memory_order_relaxed);
+		stream.ended.store(false, std::memory_order_relaxed);
+		stream.state = Stream::Opening;
+		requested = true;
+		wake.notify_one();
+		return s;
+	}
+	return -1U;
+}
+
+void OpusStream::close(uint32_t stream) {
+	std::lock_guard< std::mutex > lock(mutex);
+	assert(stream < streams.size());
+	assert(streams[stream].state == Stream::Opening || streams[stream].state == Stream::Playing);
+	streams[stream].state = Stream::Closing;
+	requested = true;
+	wake.notify_one();
+}
+
+uint32_t OpusStream::read(uint32_t stream_, float *out, uint32_t count, bool *ended) {
+	assert(stream_ < streams.size());
+	Stream &stream = streams[stream_];
+
+	//(check 'ended' before 'written' so that an ended stream is never missing its last samples)
+	bool end = stream.ended.load(std::memory_order_acquire);
+	uint64_t read = stream.read.load(std::memory_order_relaxed);
+	uint64_t available = stream.written.load(std::memory_order_acquire) - read;
+
+	uint32_t got = uint32_t(std::min< uint64_t >(count, available));
+	uint32_t begin = uint32_t(read & (RING_SAMPLES - 1));
+	uint32_t first = std::min(got, RING_SAMPLES - begin);
+	std::memcpy(out, stream.ring.data() + begin, first * sizeof(float));
+	std::memcpy(out + first, stream.ring.data(), (got - first) * sizeof(float));
+
+	stream.read.store(read + got, std::memory_order_release);
+
+	*ended = (end && got == available);
+	return got;
+}
+
+uint32_t OpusStream::history(uint32_t stream_, float *out, uint32_t count) {
+	assert(stream_ < streams.size());
+	assert(count <= HISTORY_SAMPLES);
+	Stream &stream = streams[stream_];
+
+	uint64_t read = stream.read.load(std::memory_order_relaxed);
+	uint32_t got = uint32_t(std::min< uint64_t >(count, read));
+	uint32_t begin = uint32_t((read - got) & (RING_SAMPLES - 1));
+	uint32_t first = std::min(got, RING_SAMPLES - begin);
+	float *dst = out + (count - got);
+	std::memcpy(dst, stream.ring.data() + begin, first * sizeof(float));
+	std::memcpy(dst + first, stream.ring.data(), (got - first) * sizeof(float));
+	return got;
+}
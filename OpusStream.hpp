@@ -0,0 +1,50 @@
+#pragma once
+
+/*
+ * OpusStream -- decodes streamed Sound::Samples on a background thread.
+ *
+ * Each playing streamed sample gets one of MAX_STREAMS stream slots; the
+ *  decoder thread keeps the slot's OggOpusFile open and keeps its ring buffer
+ *  (RING_SAMPLES of 48kHz mono float) full ahead of the mixer, seeking back
+ *  to the start when a looping sample reaches its end.
+ *
+ * Used by Sound.cpp:
+ *  - the game thread calls open() when a streamed sample starts playing and
+ *    close() once its voice has finished;
+ *  - the audio thread calls read() from mix_audio (never blocks or allocates).
+ *
+ */
+
+#include "Sound.hpp"
+
+#include <cstdint>
+
+namespace OpusStream {
+
+constexpr uint32_t const MAX_STREAMS = 32; //streamed samples that can play at once
+constexpr uint32_t const RING_SAMPLES = 16384; //per-stream buffer (~0.34 seconds, 64k); n.b. must be a power of two
+constexpr uint32_t const HISTORY_SAMPLES = 32; //samples kept in the ring after they are read (see history())
+
+//start/stop the decoder thread (called by Sound::init / Sound::shutdown):
+void start();
+void stop();
+
+//game thread: start decoding 'sample' (which must be streamed) just after the part stored in sample.data;
+// returns a stream slot index, or -1U if all slots are in use:
+uint32_t open(Sound::Sample const &sample, bool loop);
+
+//game thread: stop decoding; the slot is recycled once the decoder thread closes the file.
+// (caller must ensure the audio thread is done reading the stream)
+void close(uint32_t stream);
+
+//audio thread: copy up to 'count' decoded samples into 'out'; returns number of samples copied.
+// sets *ended to true once every sample in a (non-looping) stream has been read.
+// (returning fewer than 'count' samples without *ended means the decoder has fallen behind)
+uint32_t read(uint32_t stream, float *out, uint32_t count, bool *ended);
+
+//audio thread: copy the last 'count' (at most HISTORY_SAMPLES) samples returned by read() into 'out';
+// returns how many there were (if fewer than 'count' have been read, they go at the end of 'out').
+// (used to start resampling a voice partway through its stream)
+uint32_t history(uint32_t stream, float *out, uint32_t count);
+
+} //namespace OpusStream
@@ -12,8 +12,11 @@
 #include "DrawLines.hpp"
 #include "Mesh.hpp"
 #include "Load.hpp"
+#include "GLState.hpp"
 #include "gl_errors.hpp"
 #include "data_path.hpp"
+#include "EmbeddedAssets.hpp"
+#include "AssetWatch.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -22,14 +25,23 @@
 
 GLuint hexapod_meshes_for_lit_color_texture_program = 0;
 Load< MeshBuffer > hexapod_meshes(LoadTagDefault, []() -> MeshBuffer const * {
-	MeshBuffer const *ret = new MeshBuffer(data_path("hexapod.pnct"));
+	//hexapod.pnct is embedded in the executable by Maekfile.js, but fall back to the file just in case:
+	ByteSpan const *embedded = EmbeddedAssets::embedded.find("hexapod.pnct");
+	MeshBuffer *ret = (embedded ? new MeshBuffer(*embedded, "hexapod.pnct") : new MeshBuffer(data_path("hexapod.pnct")));
 	hexapod_meshes_for_lit_color_texture_program = ret->make_vao_for_program(lit_color_texture_program->program);
+
+	//hot-reload mesh data when it is re-exported:
+	// (the vao made above stays valid, since reload() keeps the same buffer)
+	AssetWatch::watch("hexapod.pnct", [ret](){
+		ret->reload(data_path("hexapod.pnct"));
+	});
+
 	return ret;
 });
 
 Load< Scene > hexapod_scene(LoadTagDefault, []() -> Scene const * {
     
-	return new Scene(data_path("hexapod.scene"), [&](Scene &scene, Scene::Transform *transform, std::string const &mesh_name){
+	auto on_drawable = [](Scene &scene, Scene::Transform *transform, std::string const &mesh_name){
 		Mesh const &mesh = hexapod_meshes->lookup(mesh_name);
 
 		scene.drawables.emplace_back(transform);
@@ -42,12 +54,26 @@ Load< Scene > hexapod_scene(LoadTagDefault, []() -> Scene const * {
 		drawable.pipeline.start = mesh.start;
 		drawable.pipeline.count = mesh.count;
 
-	});
-    
+	};
+
+	//hexapod.scene is also embedded, with the same fallback:
+	ByteSpan const *embedded = EmbeddedAssets::embedded.find("hexapod.scene");
+	Scene *ret = (embedded ? new Scene(*embedded, "hexapod.scene", on_drawable) : new Scene(data_path("hexapod.scene"), on_drawable));
+
+	//hot-reload when the scene is re-exported or the meshes it refers to change:
+	// (these run after the hexapod_meshes reload above, since they were registered later)
+	auto reload = [ret,on_drawable](){
+		*ret = Scene(data_path("hexapod.scene"), on_drawable);
+	};
+	AssetWatch::watch("hexapod.scene", reload);
+	AssetWatch::watch("hexapod.pnct", reload);
+
+	return ret;
 });
 
 Load< Sound::Sample > dusty_floor_sample(LoadTagDefault, []() -> Sound::Sample const * {
-	return new Sound::Sample(data_path("dusty-floor.opus"));
+	//(ambience loop, so stream it rather than decoding the whole thing into memory)
+	return new Sound::Sample(data_path("dusty-floor.opus"), Sound::Sample::Stream());
 });
 
 PlayMode::PlayMode() : scene(*hexapod_scene) {
@@ -72,6 +98,14 @@ PlayMode::PlayMode() : scene(*hexapod_scene) {
 	//start music loop playing:
 	// (note: position will be over-ridden in update())
 	leg_tip_loop = Sound::loop_3D(*dusty_floor_sample, 1.0f, get_leg_tip_position(), 10.0f);
+
+	//when hexapod_scene is hot-reloaded, pick up its new drawables:
+	// (transforms are kept, so hip/upper_leg/lower_leg/camera stay valid)
+	for (std::string const &name : {"hexapod.scene", "hexapod.pnct"}) {
+		asset_watches.emplace_back(AssetWatch::watch(name, [this](){
+			scene.update_drawables_from(*hexapod_scene);
+		}));
+	}
     
     // load the font
     if (!font_loader.loadFont(data_path("path/to/font.ttf"), 36)) {
@@ -80,6 +114,9 @@ PlayMode::PlayMode() : scene(*hexapod_scene) {
 }
 
 PlayMode::~PlayMode() {
+	for (uint32_t handle : asset_watches) {
+		AssetWatch::unwatch(handle);
+	}
 }
 
 bool PlayMode::handle_event(SDL_Event const &evt, glm::uvec2 const &window_size) {
@@ -189,8 +226,9 @@ void PlayMode::update(float elapsed) {
 	{ //update listener to camera position:
 		glm::mat4x3 frame = camera->transform->make_local_to_parent();
 		glm::vec3 frame_right = frame[0];
+		glm::vec3 frame_up = frame[1];
 		glm::vec3 frame_at = frame[3];
-		Sound::listener.set_position_right(frame_at, frame_right, 1.0f / 60.0f);
+		Sound::listener.set_position_right_up(frame_at, frame_right, frame_up, 1.0f / 60.0f);
 	}
 
 	//reset button press counters:
@@ -207,18 +245,17 @@ void PlayMode::draw(glm::uvec2 const &drawable_size) {
 
 	//set up light type and position for lit_color_texture_program:
 	// TODO: consider using the Light(s) in the scene to do this
-	glUseProgram(lit_color_texture_program->program);
+	GLState::use_program(lit_color_texture_program->program);
 	glUniform1i(lit_color_texture_program->LIGHT_TYPE_int, 1);
 	glUniform3fv(lit_color_texture_program->LIGHT_DIRECTION_vec3, 1, glm::value_ptr(glm::vec3(0.0f, 0.0f,-1.0f)));
 	glUniform3fv(lit_color_texture_program->LIGHT_ENERGY_vec3, 1, glm::value_ptr(glm::vec3(1.0f, 1.0f, 0.95f)));
-	glUseProgram(0);
 
 	glClearColor(0.5f, 0.5f, 0.5f, 1.0f);
 	glClearDepth(1.0f); //1.0 is actually the default value to clear the depth buffer to, but FYI you can change it.
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LESS); //this is the default depth comparison function, but FYI you can change it.
+	GLState::enable(GL_DEPTH_TEST);
+	GLState::depth_func(GL_LESS); //this is the default depth comparison function, but FYI you can change it.
 
 	scene.draw(*camera);
 */
@@ -45,4 +45,7 @@ struct PlayMode : Mode {
 	//camera:
 	Scene::Camera *camera = nullptr;
 
+	//asset hot-reload callbacks (unwatched in destructor):
+	std::vector< uint32_t > asset_watches;
+
 };
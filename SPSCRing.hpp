@@ -0,0 +1,56 @@
+#pragma once
+
+/*
+ * SPSCRing -- a fixed-capacity, lock-free, single-producer/single-consumer queue.
+ *
+ * Exactly one thread may call push() and exactly one (other) thread may call pop();
+ *  neither call ever blocks or allocates. (Used by Sound.cpp to hand commands
+ *  from the game thread to the audio callback.)
+ *
+ * Items are moved into and out of preallocated slots, so T should be cheap to
+ *  move and should not allocate when moved-from.
+ *
+ */
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+template< typename T, uint32_t Capacity >
+struct SPSCRing {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+	SPSCRing() : slots(Capacity) { }
+	SPSCRing(SPSCRing const &) = delete;
+	SPSCRing &operator=(SPSCRing const &) = delete;
+
+	//producer: add an item; returns false (and leaves 'item' alone) if the ring is full:
+	bool push(T &&item) {
+		uint32_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == Capacity) return false;
+		slots[t & (Capacity - 1)] = std::move(item);
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	//consumer: remove the oldest item; returns false if the ring is empty:
+	bool pop(T *item) {
+		uint32_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire)) return false;
+		*item = std::move(slots[h & (Capacity - 1)]);
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	//(approximate unless called from the producer or consumer thread)
+	uint32_t size() const {
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+private:
+	std::vector< T > slots;
+	//head and tail count up forever (wrapping at 2^32) and are masked to index slots;
+	// they live on separate cache lines so the two threads don't contend:
+	alignas(64) std::atomic< uint32_t > head{0}; //next slot to pop; written only by consumer
+	alignas(64) std::atomic< uint32_t > tail{0}; //next slot to push; written only by producer
+};
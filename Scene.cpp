@@ -1,5 +1,6 @@
 #include "Scene.hpp"
 
+#include "GLState.hpp"
 #include "gl_errors.hpp"
 #include "read_write_chunk.hpp"
 
@@ -103,10 +104,11 @@ void Scene::draw(glm::mat4 const &world_to_clip, glm::mat4x3 const &world_to_lig
 
 
 		//Set shader program:
-		glUseProgram(pipeline.program);
+		// (through GLState, so drawables that share a program or vertex array don't re-bind it)
+		GLState::use_program(pipeline.program);
 
 		//Set attribute sources:
-		glBindVertexArray(pipeline.vao);
+		GLState::bind_vertex_array(pipeline.vao);
 
 		//Configure program uniforms:
 
@@ -138,30 +140,17 @@ void Scene::draw(glm::mat4 const &world_to_clip, glm::mat4x3 const &world_to_lig
 		if (pipeline.set_uniforms) pipeline.set_uniforms();
 
 		//set up textures:
+		// (units without a texture are bound to zero, so they don't sample a previous drawable's texture;
+		//  textures are left bound after drawing, since the next drawable often uses the same ones)
 		for (uint32_t i = 0; i < Drawable::Pipeline::TextureCount; ++i) {
-			if (pipeline.textures[i].texture != 0) {
-				glActiveTexture(GL_TEXTURE0 + i);
-				glBindTexture(pipeline.textures[i].target, pipeline.textures[i].texture);
-			}
+			GLState::bind_texture(i, pipeline.textures[i].target, pipeline.textures[i].texture);
 		}
 
 		//draw the object:
 		glDrawArrays(pipeline.type, pipeline.start, pipeline.count);
 
-		//un-bind textures:
-		for (uint32_t i = 0; i < Drawable::Pipeline::TextureCount; ++i) {
-			if (pipeline.textures[i].texture != 0) {
-				glActiveTexture(GL_TEXTURE0 + i);
-				glBindTexture(pipeline.textures[i].target, 0);
-			}
-		}
-		glActiveTexture(GL_TEXTURE0);
-
 	}
 
-	glUseProgram(0);
-	glBindVertexArray(0);
-
 	GL_ERRORS();
 }
 
@@ -170,6 +159,18 @@ void Scene::load(std::string const &filename,
 	std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable) {
 
 	std::ifstream file(filename, std::ios::binary);
+	load(file, filename, on_drawable);
+}
+
+void Scene::load(ByteSpan const &bytes, std::string const &name,
+	std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable) {
+
+	ByteSpanStream file(bytes);
+	load(file, name, on_drawable);
+}
+
+void Scene::load(std::istream &file, std::string const &filename,
+	std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable) {
 
 	std::vector< char > names;
 	read_chunk(file, "str0", &names);
@@ -318,6 +319,10 @@ Scene::Scene(std::string const &filename, std::function< void(Scene &, Transform
 	load(filename, on_drawable);
 }
 
+Scene::Scene(ByteSpan const &bytes, std::string const &name, std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable) {
+	load(bytes, name, on_drawable);
+}
+
 Scene::Scene(Scene const &other) {
 	set(other);
 }
@@ -375,3 +380,41 @@ void Scene::set(Scene const &other, std::unordered_map< Transform const *, Trans
 		l.transform = transform_to_transform.at(l.transform);
 	}
 }
+
+void Scene::update_drawables_from(Scene const &other) {
+	//map other's transforms to this scene's transforms by name:
+	std::unordered_map< std::string, Transform * > by_name;
+	for (auto &t : transforms) {
+		by_name.emplace(t.name, &t); //(if names are duplicated, the first one wins)
+	}
+
+	std::unordered_map< Transform const *, Transform * > transform_to_transform;
+	transform_to_transform.insert(std::make_pair(nullptr, nullptr));
+
+	std::vector< std::pair< Transform *, Transform const * > > added;
+	for (auto const &t : other.transforms) {
+		auto f = by_name.find(t.name);
+		if (f != by_name.end()) {
+			transform_to_transform.insert(std::make_pair(&t, f->second));
+		} else {
+			transforms.emplace_back();
+			transforms.back().name = t.name;
+			transforms.back().position = t.position;
+			transforms.back().rotation = t.rotation;
+			transforms.back().scale = t.scale;
+			transform_to_transform.insert(std::make_pair(&t, &transforms.back()));
+			added.emplace_back(&transforms.back(), &t);
+		}
+	}
+
+	//new transforms get parents from other:
+	for (auto const &a : added) {
+		a.first->parent = transform_to_transform.at(a.second->parent);
+	}
+
+	//copy other's drawables, updating transform pointers:
+	drawables = other.drawables;
+	for (auto &d : drawables) {
+		d.transform = transform_to_transform.at(d.transform);
+	}
+}
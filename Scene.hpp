@@ -11,6 +11,7 @@
  */
 
 #include "GL.hpp"
+#include "ByteSpan.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -135,6 +136,17 @@ struct Scene {
 		std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable = nullptr
 	);
 
+	//..from scene file contents that are already in memory (e.g., an embedded asset):
+	// 'name' is used in error messages
+	void load(ByteSpan const &bytes, std::string const &name,
+		std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable = nullptr
+	);
+
+	//..from any stream (both of the above call this):
+	void load(std::istream &from, std::string const &filename,
+		std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable
+	);
+
 	//this function is called to read extra chunks from the scene file after the main chunks are read:
 	// this is useful if you, e.g., subclassing scene to represent a game level/area
 	virtual void load_extra(std::istream &from, std::vector< char > const &str0, std::vector< Transform * > const &xfh0) { }
@@ -144,10 +156,17 @@ struct Scene {
 
 	//load a scene:
 	Scene(std::string const &filename, std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable);
+	Scene(ByteSpan const &bytes, std::string const &name, std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable);
 
 	//copy a scene (with proper pointer fixup):
 	Scene(Scene const &); //...as a constructor
 	Scene &operator=(Scene const &); //...as scene = scene
 	//... as a set() function that optionally returns the transform->transform mapping:
 	void set(Scene const &, std::unordered_map< Transform const *, Transform * > *transform_map = nullptr);
+
+	//replace drawables with copies of another scene's drawables (e.g., from a freshly re-loaded scene file),
+	// matching transforms by name so that existing transforms -- and pointers to them -- are kept:
+	// (existing transforms keep their current values; transforms that are new in 'other' are added;
+	//  cameras and lights are left alone)
+	void update_drawables_from(Scene const &other);
 };
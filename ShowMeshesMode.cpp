@@ -2,6 +2,7 @@
 
 #include "ShowMeshesProgram.hpp"
 #include "DrawLines.hpp"
+#include "GLState.hpp"
 
 #include <iostream>
 
@@ -116,9 +117,9 @@ void ShowMeshesMode::draw(glm::uvec2 const &drawable_size) {
 	//--- actual drawing ---
 	glClearColor(0.5f, 0.5f, 0.5f, 0.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glDisable(GL_BLEND);
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LEQUAL);
+	GLState::disable(GL_BLEND);
+	GLState::enable(GL_DEPTH_TEST);
+	GLState::depth_func(GL_LEQUAL);
 
 	scene.draw(*scene_camera);
 
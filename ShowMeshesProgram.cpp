@@ -1,6 +1,8 @@
 #include "ShowMeshesProgram.hpp"
 
+#include "GLState.hpp"
 #include "gl_compile_program.hpp"
+#include "gl_debug_output.hpp"
 #include "gl_errors.hpp"
 
 Scene::Drawable::Pipeline show_meshes_program_pipeline;
@@ -72,6 +74,7 @@ ShowMeshesProgram::ShowMeshesProgram() {
 		"	}\n"
 		"}\n"
 	);
+	gl_label(GL_PROGRAM, program, "ShowMeshesProgram"); //(names it in debug messages)
 
 	//look up the locations of vertex attributes:
 	Position_vec4 = glGetAttribLocation(program, "Position");
@@ -88,6 +91,7 @@ ShowMeshesProgram::ShowMeshesProgram() {
 }
 
 ShowMeshesProgram::~ShowMeshesProgram() {
+	GLState::forget_program(program);
 	glDeleteProgram(program);
 	program = 0;
 }
@@ -1,5 +1,6 @@
 #include "ShowSceneMode.hpp"
 #include "DrawLines.hpp"
+#include "GLState.hpp"
 
 #include <iostream>
 
@@ -87,9 +88,9 @@ void ShowSceneMode::draw(glm::uvec2 const &drawable_size) {
 	//--- actual drawing ---
 	glClearColor(0.5f, 0.5f, 0.5f, 0.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glDisable(GL_BLEND);
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LEQUAL);
+	GLState::disable(GL_BLEND);
+	GLState::enable(GL_DEPTH_TEST);
+	GLState::depth_func(GL_LEQUAL);
 
 	scene.draw(*scene_camera);
 
@@ -129,10 +130,10 @@ void ShowSceneMode::draw(glm::uvec2 const &drawable_size) {
 			);
 		}
 		/*
-		glEnable(GL_LINE_SMOOTH);
-		glEnable(GL_BLEND);
+		GLState::enable(GL_LINE_SMOOTH);
+		GLState::enable(GL_BLEND);
 		glBlendEquation(GL_FUNC_ADD);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		GLState::blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		*/
 	}
 
@@ -1,6 +1,8 @@
 #include "ShowSceneProgram.hpp"
 
+#include "GLState.hpp"
 #include "gl_compile_program.hpp"
+#include "gl_debug_output.hpp"
 #include "gl_errors.hpp"
 
 Scene::Drawable::Pipeline show_scene_program_pipeline;
@@ -72,6 +74,7 @@ ShowSceneProgram::ShowSceneProgram() {
 		"	}\n"
 		"}\n"
 	);
+	gl_label(GL_PROGRAM, program, "ShowSceneProgram"); //(names it in debug messages)
 
 	//look up the locations of vertex attributes:
 	Position_vec4 = glGetAttribLocation(program, "Position");
@@ -88,6 +91,7 @@ ShowSceneProgram::ShowSceneProgram() {
 }
 
 ShowSceneProgram::~ShowSceneProgram() {
+	GLState::forget_program(program);
 	glDeleteProgram(program);
 	program = 0;
 }
@@ -1,27 +1,548 @@
 #include "Sound.hpp"
 #include "load_wav.hpp"
 #include "load_opus.hpp"
+#include "mix_kernels.hpp"
+#include "ima_adpcm.hpp"
+#include "resample.hpp"
+#include "convolve.hpp"
+#include "SPSCRing.hpp"
+#include "OpusStream.hpp"
+#include "AudioCache.hpp"
+#include "StartupProfile.hpp"
 
 #include <SDL.h>
 
-#include <list>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <exception>
+#include <fstream>
+#include <iterator>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
 #include <algorithm>
+#include <thread>
 
 //local (to this file) data used by the audio system:
 namespace {
 
 	//handy constants:
 	constexpr uint32_t const AUDIO_RATE = 48000; //sampling rate
-	constexpr uint32_t const MIX_SAMPLES = 1024; //number of samples to mix per call of mix_audio callback; n.b. SDL requires this to be a power of two
+	constexpr uint32_t const MAX_MIX_SAMPLES = Sound::MAX_BLOCK_SAMPLES; //most samples mixed per call of mix_audio callback (the actual number is set by Sound::set_block_samples)
+	constexpr uint32_t const CONTROL_SAMPLES = Sound::MIN_BLOCK_SAMPLES; //ramps and panning of mixed voices are updated this often, whatever the block size
+	constexpr uint32_t const MAX_VOICES = 4096; //size of the voice pool (maximum number of samples playing at once); n.b. SPSCRing requires this to be a power of two
+	constexpr float const MAX_RATE = 4.0f; //fastest playback rate (see PlayingSample::set_rate)
+	constexpr uint32_t const RESAMPLE_TAPS = 32; //length of the filter used to resample voices playing at other rates
 
 	//The audio device:
 	SDL_AudioDeviceID device = 0;
 
-	//list of all currently playing samples:
-	std::list< std::shared_ptr< Sound::PlayingSample > > playing_samples;
+	//------ block size ------
+	//(game thread; see Sound::set_block_samples)
+	uint32_t block_samples = Sound::DEFAULT_BLOCK_SAMPLES; //size requested when opening the device
+	bool adaptive_blocks = false;
+	uint32_t min_block_samples = Sound::DEFAULT_BLOCK_SAMPLES; //(adaptive mode never goes below this)
+
+	//adaptive mode shrinks the block size after this long without trouble, if the callback used at most
+	// a quarter of its budget (so would use at most about half at the smaller size):
+	constexpr float const ADAPT_SHRINK_SECONDS = 10.0f;
+
+	//Is the mixer being driven by Sound::render() instead of an audio device? (see Sound::init_offline)
+	bool offline = false;
+
+	//------ output channels ------
+	//(game thread sets these in Sound::init / Sound::init_offline, before the audio thread starts; fixed after that)
+	uint32_t requested_channels = 0; //(see Sound::set_output_channels; 0 == ask the device)
+	uint32_t output_channels = 2; //interleaved channels in the output and bus buffers
+	VBAPLayout output_layout; //speaker pairs for panning 3D voices (if output_channels > 2)
+	//Reverb and Convolution effects are stereo; on surround output, each channel adds to their (left, right) input
+	// by fold_gains and gets their output times spread_gains (see fold_to_stereo / spread_stereo):
+	float fold_gains[Sound::MAX_OUTPUT_CHANNELS][2];
+	float spread_gains[Sound::MAX_OUTPUT_CHANNELS][2];
+
+	static_assert(Sound::MAX_OUTPUT_CHANNELS <= MAX_MIX_CHANNELS, "mix kernels handle every output channel count");
+
+	//speaker directions (degrees clockwise from straight ahead; NaN for the LFE channel) for each supported channel count, in SDL's order:
+	float const *speaker_azimuths(uint32_t channels) {
+		constexpr float const LFE = std::numeric_limits< float >::quiet_NaN();
+		static float const QUAD[4] = { -45.0f, 45.0f, -135.0f, 135.0f };
+		static float const SURROUND_51[6] = { -30.0f, 30.0f, 0.0f, LFE, -110.0f, 110.0f };
+		static float const SURROUND_71[8] = { -30.0f, 30.0f, 0.0f, LFE, -150.0f, 150.0f, -90.0f, 90.0f };
+		if (channels == 4) return QUAD;
+		if (channels == 6) return SURROUND_51;
+		if (channels == 8) return SURROUND_71;
+		return nullptr;
+	}
+
+	//set output_channels (and the tables that depend on it), falling back to stereo for unsupported counts:
+	void use_output_channels(uint32_t channels) {
+		if (channels != 2 && !speaker_azimuths(channels)) {
+			std::cerr << "WARNING: can't mix " << channels << " output channels (only 2, 4, 6, or 8); using stereo." << std::endl;
+			channels = 2;
+		}
+		output_channels = channels;
+		if (channels == 2) return;
+
+		float const *azimuths = speaker_azimuths(channels);
+		output_layout = vbap_layout(channels, azimuths);
+		uint32_t left_count = 0, right_count = 0;
+		for (uint32_t c = 0; c < channels; ++c) {
+			if (azimuths[c] < 0.0f) left_count += 1;
+			if (azimuths[c] > 0.0f) right_count += 1;
+		}
+		for (uint32_t c = 0; c < channels; ++c) {
+			//(NaN -- the LFE channel -- is neither left, right, nor center, so is left out)
+			bool left = (azimuths[c] < 0.0f), right = (azimuths[c] > 0.0f), center = (azimuths[c] == 0.0f);
+			fold_gains[c][0] = (left ? 1.0f : (center ? std::sqrt(0.5f) : 0.0f));
+			fold_gains[c][1] = (right ? 1.0f : (center ? std::sqrt(0.5f) : 0.0f));
+			//(keeping the power of each side)
+			spread_gains[c][0] = (left ? 1.0f / std::sqrt(float(left_count)) : 0.0f);
+			spread_gains[c][1] = (right ? 1.0f / std::sqrt(float(right_count)) : 0.0f);
+		}
+	}
+
+	//------ voice pool ------
+	//Voices are preallocated in Sound::init(); starting and stopping a voice never allocates or frees memory.
+	//The game thread hands out free voices (in play()) and the audio thread hands them back (when they finish);
+	// each reuse of a voice bumps its generation, so PlayingSample handles to earlier uses become stale.
+
+	//playback state of a voice (owned by the audio thread):
+	struct Voice {
+		void const *data = nullptr; //sample data being played (stored in 'encoding')
+		Sound::Sample::Encoding encoding = Sound::Sample::Float;
+		uint32_t size = 0; //number of samples in 'data'
+		uint32_t i = 0; //next data value to read
+		uint32_t stream = -1U; //OpusStream slot supplying samples after 'data' (for streamed samples)
+		bool stream_ended = false; //has the stream run out of samples?
+		uint32_t generation = 0; //generation of the PlayingSample handle for this use of the voice
+		uint32_t active_index = -1U; //position in active_voices (or -1U if not playing)
+		bool loop = false; //should playback loop after data runs out?
+		bool stopping = false; //is playing stopping?
+		bool is_3D = false; //position (rather than pan) controls panning?
+		float priority = 1.0f; //(see Sound::set_virtualization)
+		bool real = false; //was the voice mixed (rather than virtual) in the last block?
+		bool fresh = false; //has the voice just started? (so hasn't been mixed or virtual yet)
+		bool scheduled = false; //is the voice waiting (in scheduled_voices) for its start time?
+		uint64_t start = 0; //audio clock time to start at (if scheduled)
+		uint32_t delay = 0; //samples of the current block before the voice starts (if it starts partway through)
+		uint32_t bus = Sound::MASTER_BUS; //bus the voice is mixed into
+		float low_pass_state = 0.0f; //(see Sound::set_distance_low_pass)
+		uint32_t hrtf = -1U; //convolver rendering the voice binaurally (or -1U if it is panned; see Sound::load_hrtf)
+
+		//playback rate -- once the rate has been changed from 1, the voice is resampled as it plays:
+		// (it stays resampled even if the rate returns to 1, since switching back would skip a few samples)
+		Sound::Ramp< float > rate = Sound::Ramp< float >(1.0f);
+		bool resampling = false;
+		double rate_position = 0.0; //fractional position in rate_window
+		float rate_window[RESAMPLE_TAPS]; //the RESAMPLE_TAPS samples before voice.i
+
+		Sound::Ramp< float > volume = Sound::Ramp< float >(1.0f);
+		Sound::Ramp< float > pan = Sound::Ramp< float >(0.0f); //(2D mode)
+		Sound::Ramp< glm::vec3 > position = Sound::Ramp< glm::vec3 >(0.0f); //(3D mode)
+		Sound::Ramp< float > half_volume_radius = Sound::Ramp< float >(1.0f); //(3D mode)
+	};
+
+	//audio thread: all voices, and a dense list of the ones currently playing (for O(1) add/remove):
+	std::vector< Voice > voices;
+	std::vector< uint32_t > active_voices;
+	uint32_t active_count = 0;
+
+	//audio thread -> game thread: voices that finished playing (never fills, since each voice is in here at most once):
+	SPSCRing< uint32_t, MAX_VOICES > finished_voices;
+
+	//------ scheduling ------
+	//Voices started with Sound::play_at (etc.) wait in scheduled_voices until the block containing their start time,
+	// then begin that many samples into the block (see Voice::delay).
+
+	//audio thread: voices waiting for their start time (never more than MAX_VOICES, so never reallocates):
+	std::vector< uint32_t > scheduled_voices;
+
+	//audio thread: samples mixed so far (the time of the first sample of the next block):
+	uint64_t mix_clock = 0;
+
+	//audio thread -> game thread: copy of mix_clock (see Sound::get_audio_clock):
+	std::atomic< uint64_t > audio_clock{0};
+
+	//------ virtualization ------
+	//Only the top max_real_voices audible voices (ranked by priority x gain) are mixed each block;
+	// the others are 'virtual' -- their playback position advances, but they aren't mixed.
+
+	//(audio thread; set by Sound::set_virtualization)
+	uint32_t max_real_voices = 256;
+	float audibility_threshold = 0.001f; //(-60dB)
+
+	//audio thread: per-block scratch state for each active voice (indexed like active_voices):
+	struct VoiceMix {
+		float gain[Sound::MAX_OUTPUT_CHANNELS]; //gain of each output channel at start of block
+		float gain_step[Sound::MAX_OUTPUT_CHANNELS]; //change in gain per sample
+		uint32_t entry; //index in 'spatial' arrays (start of block; end is at entry + MAX_VOICES)
+		float start_volume, end_volume; //voice volume (including global volume) at start/end of block
+		float start_rate, end_rate; //playback rate at start/end of block (if resampling)
+		float score; //priority x loudness (for picking real voices)
+		bool real; //should the voice be mixed in this block?
+		bool finished; //did the voice finish in this block?
+		bool hrtf; //should the voice be rendered binaurally (by the end of the block)?
+		float hrtf_start, hrtf_end; //binaural share of the voice's output at start/end of block (the rest is panned)
+	};
+	std::vector< VoiceMix > voice_mixes;
+	std::vector< uint32_t > audible; //active voice positions of voices above audibility_threshold
+	std::vector< uint32_t > mixing; //active voice positions of voices being mixed in this block
+
+	//------ spatialization ------
+	//Panning gains for all voices are computed together (see spatialize(), vbap_spatialize(), and equal_power_pan() in mix_kernels.hpp)
+	// from parameters gathered into structure-of-arrays form. Each array has two halves --
+	// values at the start of the block in [0, MAX_VOICES) and at the end in [MAX_VOICES, 2*MAX_VOICES) --
+	// and each half holds 3D voices' entries from the front and 2D voices' entries from the back.
+
+	//(audio thread)
+	struct {
+		std::vector< float > x, y, z, half_radius; //(3D voices)
+		std::vector< float > pan; //(2D voices)
+		std::vector< float > gains[Sound::MAX_OUTPUT_CHANNELS]; //computed gains (for each output channel)
+	} spatial;
+
+	//------ HRTF ------
+	//The highest-scoring real 3D voices (up to the budget set by Sound::set_hrtf_budget) are rendered binaurally:
+	// each is convolved (see convolve.hpp) with the HRIR pair nearest its direction by a convolver from a preallocated pool.
+
+	//a set of HRIR pairs (see Sound::load_hrtf):
+	struct HRTFSet {
+		std::vector< glm::vec3 > directions; //unit vectors relative to the listener (x right, y forward, z up)
+		std::vector< ConvolutionFilter > filters; //(left + i right, partitioned every CONTROL_SAMPLES)
+	};
+
+	//game thread: every set loaded (kept until exit, since the audio thread may still be using an earlier one):
+	std::vector< std::unique_ptr< HRTFSet > > hrtf_sets;
+
+	//(audio thread; set by Sound::load_hrtf and Sound::set_hrtf_budget)
+	HRTFSet const *hrtf_set = nullptr;
+	uint32_t max_hrtf_voices = 16;
+	float hrtf_cpu_fraction = 1.0f;
+
+	//audio thread: convolvers (MAX_HRTF_VOICES, allocated up front) and the ones not in use:
+	std::vector< Convolver > hrtf_convolvers;
+	std::vector< uint32_t > free_hrtf_convolvers;
+
+	//audio thread: real 3D voices (active voice positions), when picking the ones to render binaurally:
+	std::vector< uint32_t > hrtf_candidates;
+
+	//audio thread: running estimate of the time a binaural voice takes per sample (for hrtf_cpu_fraction):
+	double hrtf_nanoseconds_per_sample = 0.0;
+
+	//audio thread: a voice's samples times its gain, as stereo with right == 0 (so convolving gives both ears):
+	float hrtf_input[2 * CONTROL_SAMPLES];
+
+	//------ buses ------
+	//Voices are mixed into their bus's buffer (the master bus's buffer is the output itself); after all voices are mixed,
+	// buses run their effects and add themselves into their parents, from the last bus down to the master bus.
+	// (a bus's parent and send bus were always added before it, so come earlier)
+
+	//audio thread: state of each bus (all allocated up front, so adding buses and changing effects never allocates):
+	struct Bus {
+		bool active = false; //has the bus been added?
+		uint32_t parent = Sound::MASTER_BUS;
+		uint32_t send = -1U; //bus that also gets some of this bus's output (or -1U for none)...
+		float send_level = 0.0f; //...scaled by this much
+		Sound::Ramp< float > volume = Sound::Ramp< float >(1.0f);
+		Sound::Effect effects[Sound::MAX_BUS_EFFECTS];
+		BiquadCoefficients biquads[Sound::MAX_BUS_EFFECTS]; //(LowPass / HighPass effects)
+		float biquad_states[Sound::MAX_BUS_EFFECTS][2 * Sound::MAX_OUTPUT_CHANNELS];
+		FDNReverb reverb; //(Reverb effect -- at most one per bus)
+		std::vector< float > reverb_lines;
+		Convolver *convolver = nullptr; //(Convolution effect -- at most one per bus; allocated by the game thread when first needed)
+	};
+	std::vector< Bus > buses;
+	std::vector< float > bus_mixes; //MAX_BUSES buffers of MAX_MIX_SAMPLES samples of output_channels channels (the first is unused)
+
+	//reverb delay lengths (at room_size 1; mutually prime, so echoes don't pile up) and the ring size that holds them:
+	constexpr uint32_t const REVERB_LENGTHS[4] = { 1693, 1979, 2311, 2677 };
+	constexpr uint32_t const REVERB_ROWS = 4096;
+
+	//impulse responses are split into partitions this long -- longer than HRIRs', since fewer partitions
+	// means fewer multiply-adds per sample (see convolve.hpp) -- and so are at most this many partitions long:
+	constexpr uint32_t const IMPULSE_RESPONSE_BLOCK = 1024;
+	constexpr uint32_t const IMPULSE_RESPONSE_PARTITIONS = (uint32_t(Sound::MAX_IMPULSE_RESPONSE_SECONDS * AUDIO_RATE) + IMPULSE_RESPONSE_BLOCK - 1) / IMPULSE_RESPONSE_BLOCK;
+
+	//audio thread: a bus's convolved output, before it is mixed with the dry signal:
+	float convolution_output[2 * MAX_MIX_SAMPLES];
+
+	//audio thread: a surround bus's mix folded down to stereo (for its Reverb or Convolution effect):
+	float surround_fold[2 * MAX_MIX_SAMPLES];
+
+	//(audio thread; set by Sound::set_distance_low_pass)
+	float low_pass_half_distance = std::numeric_limits< float >::infinity();
+
+	//audio thread: samples of a voice being filtered (by the distance low-pass or HRTF):
+	float voice_buffer[CONTROL_SAMPLES];
+
+	//game thread: number of buses added so far (including the master bus):
+	uint32_t bus_count = 1;
+
+	//game thread: each bus's convolver (made by the first Sound::set_bus_effects with a Convolution effect; kept until exit):
+	std::unique_ptr< Convolver > bus_convolvers[Sound::MAX_BUSES];
+
+	//game thread: voices available to play(), and the current generation, stream slot, and (if shared) sample of each voice:
+	std::vector< uint32_t > free_voices;
+	std::vector< uint32_t > voice_generations;
+	std::vector< uint32_t > voice_streams;
+	std::vector< std::shared_ptr< Sound::Sample const > > voice_owners; //(keeps shared samples alive while they play)
+
+	//game thread: return finished voices to the free list:
+	void reclaim_finished_voices() {
+		uint32_t voice;
+		while (finished_voices.pop(&voice)) {
+			voice_generations[voice] += 1; //(invalidates handles to the finished playback)
+			if (voice_streams[voice] != -1U) {
+				OpusStream::close(voice_streams[voice]);
+				voice_streams[voice] = -1U;
+			}
+			voice_owners[voice].reset(); //(frees the sample, if this was the last use of a shared one)
+			free_voices.emplace_back(voice);
+		}
+	}
+
+	//------ shared samples ------
+	//(see Sound::load_sample)
+
+	//samples loaded by load_sample, by filename and encoding -- weak, so they are freed once no one is using them:
+	struct SharedSample {
+		std::weak_ptr< Sound::Sample const > sample;
+		bool loading = false; //is some thread loading the sample right now?
+	};
+	std::map< std::pair< std::string, Sound::Sample::Encoding >, SharedSample > shared_samples;
+	std::mutex shared_samples_mutex; //protects shared_samples
+	std::condition_variable shared_sample_loaded; //signalled when a load finishes (or fails)
+
+	//------ decoding / streaming ------
+
+	//audio thread: samples decoded from a non-Float sample or read from a stream, waiting to be mixed:
+	float decode_buffer[CONTROL_SAMPLES];
+
+	//audio thread: filters for resampling voices playing at rates up to 1, 2, and MAX_RATE
+	// (faster playback needs a lower cutoff to avoid aliasing; built in Sound::init):
+	std::vector< ResampleFilter > rate_filters;
+
+	//audio thread: samples read from a resampled voice (after RESAMPLE_TAPS samples from its rate_window), and the resampled result:
+	float resample_input[RESAMPLE_TAPS + uint32_t(MAX_RATE * CONTROL_SAMPLES) + 1];
+	float resample_output[CONTROL_SAMPLES];
+
+	//number of times a stream ran dry (reported by Sound::update):
+	std::atomic< uint32_t > stream_underruns{0};
+
+	//------ statistics ------
+	//Recorded at the end of each mix_audio call and read by Sound::get_stats.
+	//Only the audio thread writes these, so relaxed loads and stores (rather than read-modify-writes) are enough.
+	struct {
+		std::atomic< uint64_t > histogram[Sound::Stats::HISTOGRAM_BINS] = {};
+		std::atomic< uint64_t > callbacks{0};
+		std::atomic< uint64_t > over_budget{0};
+		std::atomic< uint64_t > late{0};
+		std::atomic< uint64_t > late_starts{0};
+		std::atomic< uint32_t > block_samples{0};
+		std::atomic< uint32_t > max_microseconds{0};
+		std::atomic< uint32_t > active_voices{0}, real_voices{0};
+		std::atomic< uint32_t > max_active_voices{0}, max_real_voices{0};
+		std::atomic< float > last_peak{0.0f}, peak{0.0f};
+		std::atomic< uint64_t > bus_nanoseconds[Sound::MAX_BUSES] = {};
+		std::atomic< uint32_t > hrtf_voices{0}, max_hrtf_voices{0};
+		std::atomic< uint64_t > hrtf_nanoseconds{0};
+	} stats;
+
+	//audio thread: when the previous callback started (to spot late callbacks; reset when the device is opened):
+	std::chrono::steady_clock::time_point previous_callback;
+
+	//audio thread: helpers for updating stats:
+	template< typename T >
+	void stats_add(std::atomic< T > &counter, T amount) {
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+	template< typename T >
+	void stats_max(std::atomic< T > &maximum, T value) {
+		if (value > maximum.load(std::memory_order_relaxed)) maximum.store(value, std::memory_order_relaxed);
+	}
+
+	//------ commands ------
+
+	//Commands sent from the game thread to the audio thread:
+	struct Command {
+		enum Type : uint8_t {
+			Play, //start 'voice' playing 'data'
+			SetVolume, //set 'voice' volume to 'value'
+			SetPan, //set 'voice' pan to 'value'
+			SetPosition, //set 'voice' position to 'vec'
+			SetHalfVolumeRadius, //set 'voice' half volume radius to 'value'
+			Stop, //fade out 'voice'
+			StopAll, //fade out all voices
+			SetGlobalVolume, //set Sound::volume to 'value'
+			SetListener, //set listener position to 'vec' and right to 'vec2'
+			SetListenerUp, //set listener up to 'vec'
+			SetPriority, //set 'voice' priority to 'value'
+			SetBus, //mix 'voice' into 'bus'
+			SetRate, //set 'voice' playback rate to 'value'
+			SetVirtualization, //set max_real_voices to 'voice' and audibility_threshold to 'value'
+			AddBus, //start using 'bus', with parent 'to_bus'
+			SetBusEffect, //set effect 'slot' of 'bus' to 'effect'
+			SetBusVolume, //set 'bus' volume to 'value'
+			SetBusSend, //send 'value' of 'bus' output to 'to_bus'
+			SetDistanceLowPass, //set low_pass_half_distance to 'value'
+			SetHRTF, //set hrtf_set to 'data'
+			SetHRTFBudget, //set max_hrtf_voices to 'voice' and hrtf_cpu_fraction to 'value'
+		} type = Play;
+		bool loop = false; //(Play only)
+		bool is_3D = false; //(Play only)
+		uint32_t stream = -1U; //(Play only)
+		bool scheduled = false; //(Play only) wait until the audio clock reaches 'start'?
+		uint64_t start = 0; //(Play only)
+		uint32_t voice = -1U; //voice the command applies to...
+		uint32_t generation = 0; //...ignored unless the voice is still playing this generation
+		float value = 0.0f;
+		float value2 = 0.0f;
+		float ramp = 0.0f;
+		glm::vec3 vec = glm::vec3(0.0f);
+		glm::vec3 vec2 = glm::vec3(0.0f);
+		void const *data = nullptr; //(Play, SetHRTF)
+		Sound::Sample::Encoding encoding = Sound::Sample::Float; //(Play only)
+		uint32_t size = 0; //(Play only)
+		uint32_t bus = Sound::MASTER_BUS; //bus the command applies to (SetBus: bus to mix the voice into)
+		uint32_t to_bus = Sound::MASTER_BUS; //(AddBus, SetBusSend)
+		uint32_t slot = 0; //(SetBusEffect)
+		Sound::Effect effect; //(SetBusEffect)
+		Convolver *convolver = nullptr; //(SetBusEffect) the bus's convolver, if 'effect' needs it
+	};
+
+	//plenty of room for a frame's worth of commands, even with hundreds of voices:
+	SPSCRing< Command, 8192 > commands;
+
+	//commands that didn't fit in the ring (game thread only; sent in order before any newer command):
+	std::vector< Command > overflow;
+
+	//game thread: move any overflow commands into the ring (returns true if all fit):
+	bool flush_overflow() {
+		uint32_t sent = 0;
+		while (sent < overflow.size() && commands.push(std::move(overflow[sent]))) {
+			++sent;
+		}
+		overflow.erase(overflow.begin(), overflow.begin() + sent);
+		return overflow.empty();
+	}
+
+	//game thread: queue a command for the audio thread (never blocks):
+	void send(Command &&command) {
+		if (device == 0 && !offline) return; //no audio output, so nothing will ever consume commands
+		if (!(flush_overflow() && commands.push(std::move(command)))) {
+			overflow.emplace_back(std::move(command));
+		}
+	}
+
+	//game thread: start a voice playing with the parameters in 'command':
+	std::shared_ptr< Sound::PlayingSample > start_voice(Sound::Sample const &sample, Command &&command) {
+		reclaim_finished_voices();
+
+		command.encoding = sample.encoding;
+		switch (sample.encoding) {
+			case Sound::Sample::Float: command.data = sample.samples(); break;
+			case Sound::Sample::Int16: command.data = sample.data_int16.data(); break;
+			case Sound::Sample::ADPCM: command.data = sample.data_adpcm.data(); break;
+		}
+		command.size = uint32_t(sample.size());
+
+		uint32_t voice = -1U;
+		uint32_t generation = 0;
+		if (device != 0 || offline) {
+			if (sample.streamed) {
+				command.stream = OpusStream::open(sample, command.loop);
+				if (command.stream == -1U) {
+					std::cerr << "WARNING: all " << OpusStream::MAX_STREAMS << " streams are in use; '" << sample.stream_filename << "' will only play its first " << Sound::Sample::STREAM_PREFIX << " seconds." << std::endl;
+					command.loop = false; //(looping just the start would sound odd)
+				}
+			}
+			if (!free_voices.empty()) {
+				voice = free_voices.back();
+				free_voices.pop_back();
+				voice_generations[voice] += 1;
+				generation = voice_generations[voice];
+				voice_streams[voice] = command.stream;
+				voice_owners[voice] = sample.weak_from_this().lock(); //(null unless the sample is owned by a shared_ptr)
+
+				command.type = Command::Play;
+				command.voice = voice;
+				command.generation = generation;
+				send(std::move(command));
+			} else {
+				if (command.stream != -1U) OpusStream::close(command.stream);
+				static bool warned = false;
+				if (!warned) {
+					std::cerr << "WARNING: all " << MAX_VOICES << " voices are in use; ignoring requests to play more samples." << std::endl;
+					warned = true;
+				}
+			}
+		}
+
+		//(if no voice was available, the returned handle is already stopped)
+		return std::make_shared< Sound::PlayingSample >(voice, generation, command.is_3D);
+	}
+
+	//allocate the voice pool and mixer scratch space (Sound::init / Sound::init_offline):
+	void allocate_mixer() {
+		voices.assign(MAX_VOICES, Voice());
+		active_voices.assign(MAX_VOICES, -1U);
+		active_count = 0;
+		voice_generations.assign(MAX_VOICES, 0);
+		voice_streams.assign(MAX_VOICES, -1U);
+		voice_owners.assign(MAX_VOICES, nullptr);
+		voice_mixes.assign(MAX_VOICES, VoiceMix());
+		audible.assign(MAX_VOICES, -1U);
+		mixing.assign(MAX_VOICES, -1U);
+		scheduled_voices.clear();
+		scheduled_voices.reserve(MAX_VOICES);
+		buses.assign(Sound::MAX_BUSES, Bus());
+		for (auto &bus : buses) {
+			bus.reverb_lines.assign(REVERB_ROWS * 4, 0.0f);
+			bus.reverb.lines = bus.reverb_lines.data();
+			bus.reverb.rows = REVERB_ROWS;
+		}
+		buses[Sound::MASTER_BUS].active = true;
+		bus_mixes.assign(Sound::MAX_BUSES * MAX_MIX_SAMPLES * Sound::MAX_OUTPUT_CHANNELS, 0.0f);
+		bus_count = 1;
+		low_pass_half_distance = std::numeric_limits< float >::infinity();
+		hrtf_set = nullptr;
+		max_hrtf_voices = 16;
+		hrtf_cpu_fraction = 1.0f;
+		hrtf_convolvers.clear();
+		hrtf_convolvers.reserve(Sound::MAX_HRTF_VOICES);
+		free_hrtf_convolvers.clear();
+		for (uint32_t c = 0; c < Sound::MAX_HRTF_VOICES; ++c) {
+			hrtf_convolvers.emplace_back(CONTROL_SAMPLES, Sound::MAX_HRIR_SAMPLES / CONTROL_SAMPLES);
+			free_hrtf_convolvers.emplace_back(c);
+		}
+		hrtf_candidates.assign(MAX_VOICES, -1U);
+		hrtf_nanoseconds_per_sample = 0.0;
+		mix_clock = 0;
+		audio_clock.store(0, std::memory_order_relaxed);
+		//32-tap filters (Kaiser window, beta = 7: ~70dB stopband attenuation, transition band ~0.13 cycles/sample)
+		// with the transition band just below the output Nyquist frequency at each maximum rate:
+		rate_filters.clear();
+		for (float rate : { 1.0f, 2.0f, MAX_RATE }) {
+			rate_filters.emplace_back(RESAMPLE_TAPS, 256, (0.5f - 0.065f) / rate, 7.0f);
+		}
+		for (auto *array : { &spatial.x, &spatial.y, &spatial.z, &spatial.half_radius, &spatial.pan }) {
+			array->assign(2 * MAX_VOICES, 0.0f);
+		}
+		for (auto &array : spatial.gains) {
+			array.assign(2 * MAX_VOICES, 0.0f);
+		}
+		free_voices.clear();
+		free_voices.reserve(MAX_VOICES);
+		for (uint32_t v = MAX_VOICES - 1; v < MAX_VOICES; --v) {
+			free_voices.emplace_back(v); //(reversed so voice 0 is handed out first)
+		}
+	}
 
 }
 
@@ -36,21 +557,222 @@ Sound::Listener Sound::listener;
 //This audio-mixing callback is defined below:
 void mix_audio(void *, Uint8 *buffer_, int len);
 
+//helper: open the audio device with the current block_samples and start playback (returns false on failure):
+static bool open_device() {
+	assert(device == 0);
+
+	//(the audio thread isn't running, so this is safe to reset)
+	previous_callback = std::chrono::steady_clock::time_point();
+
+	//Based on the example on https://wiki.libsdl.org/SDL_OpenAudioDevice
+	SDL_AudioSpec want, have;
+	SDL_zero(want);
+	want.freq = AUDIO_RATE;
+	want.format = AUDIO_F32SYS;
+	want.channels = uint8_t(output_channels); //(SDL converts, if the device has some other number)
+	want.samples = uint16_t(block_samples);
+	want.callback = mix_audio;
+
+	device = SDL_OpenAudioDevice(nullptr, 0, &want, &have, 0);
+	if (device == 0) {
+		std::cerr << "Failed to open audio device:\n" << SDL_GetError() << std::endl;
+		return false;
+	}
+	//start audio playback:
+	SDL_PauseAudioDevice(device, 0);
+	return true;
+}
+
+//helper: change the block size, reopening the audio device if it is open (returns false if the device wouldn't take it):
+static bool change_block_samples(uint32_t samples) {
+	if (samples == block_samples) return true;
+	uint32_t previous = block_samples;
+	block_samples = samples;
+	if (device != 0) {
+		//(the voices and command queue live outside the device, so playback picks up where it left off)
+		SDL_CloseAudioDevice(device);
+		device = 0;
+		if (open_device()) return true;
+
+		//the device was working a moment ago, so try again with the block size it had:
+		// (and stop adapting, which would only keep asking for sizes the device may not take)
+		std::cerr << "  (Reopening with the previous block size of " << previous << " samples.)" << std::endl;
+		block_samples = previous;
+		adaptive_blocks = false;
+		if (open_device()) return false;
+
+		std::cerr << "  (Will continue without audio.)\n" << std::endl;
+		OpusStream::stop(); //(Sound::shutdown only stops the decoder if the device is open)
+		return false;
+	}
+	return true;
+}
+
 //------------------------ public-facing --------------------------------
 
-Sound::Sample::Sample(std::string const &filename) {
+//helper: load '.opus' file contents, using the decoded audio cache if possible:
+static void load_opus_cached(ByteSpan const &bytes, std::string const &name, Sound::Sample *sample) {
+	float const *samples = nullptr;
+	size_t count = 0;
+	if (std::shared_ptr< MappedFile const > mapped = AudioCache::find(bytes, &samples, &count)) {
+		std::cout << "loaded '" << name << "' from audio cache." << std::endl;
+		sample->mapped = mapped;
+		sample->mapped_samples = samples;
+		sample->mapped_count = count;
+		return;
+	}
+	load_opus(bytes, name, &sample->data);
+	AudioCache::store(bytes, sample->data.data(), sample->data.size());
+}
+
+Sound::Sample::Sample(std::string const &filename, Encoding encoding_) {
 	if (filename.size() >= 4 && filename.substr(filename.size()-4) == ".wav") {
-		load_wav(filename, &data);
+		//(files already in the mixer's format are used in place; others are converted)
+		mapped = map_wav(filename, &mapped_samples, &mapped_count);
+		if (!mapped) load_wav(filename, &data);
 	} else if (filename.size() >= 5 && filename.substr(filename.size()-5) == ".opus") {
-		load_opus(filename, &data);
+		//read the whole (compressed) file, since the cache is keyed by its contents:
+		std::ifstream file(filename, std::ios::binary);
+		std::vector< uint8_t > bytes((std::istreambuf_iterator< char >(file)), std::istreambuf_iterator< char >());
+		if (!file) {
+			throw std::runtime_error("Failed to read '" + filename + "'.");
+		}
+		StartupProfile::note_bytes_read(bytes.size());
+		load_opus_cached(ByteSpan(bytes.data(), bytes.size()), filename, this);
 	} else {
-		throw std::runtime_error("Sample '" + filename + "' doesn't end in either \".png\" or \".opus\" -- unsure how to load.");
+		throw std::runtime_error("Sample '" + filename + "' doesn't end in either \".wav\" or \".opus\" -- unsure how to load.");
 	}
+	convert(encoding_);
+}
+
+Sound::Sample::Sample(ByteSpan const &bytes, std::string const &name, Encoding encoding_) {
+	if (name.size() >= 4 && name.substr(name.size()-4) == ".wav") {
+		load_wav(bytes, name, &data);
+	} else if (name.size() >= 5 && name.substr(name.size()-5) == ".opus") {
+		load_opus_cached(bytes, name, this);
+	} else {
+		throw std::runtime_error("Sample '" + name + "' doesn't end in either \".wav\" or \".opus\" -- unsure how to load.");
+	}
+	convert(encoding_);
 }
 
 Sound::Sample::Sample(std::vector< float > const &data_) : data(data_) {
 }
 
+std::shared_ptr< Sound::Sample const > Sound::load_sample(std::string const &filename, Sample::Encoding encoding) {
+	auto key = std::make_pair(filename, encoding);
+	std::unique_lock< std::mutex > lock(shared_samples_mutex);
+	while (true) {
+		SharedSample &shared = shared_samples[key];
+		if (std::shared_ptr< Sample const > sample = shared.sample.lock()) return sample;
+		if (!shared.loading) break;
+		//(another thread is loading it; wait for that load rather than decoding a second copy)
+		shared_sample_loaded.wait(lock);
+	}
+
+	//forget samples that have been freed since (so the map doesn't keep growing):
+	for (auto s = shared_samples.begin(); s != shared_samples.end(); /* later */) {
+		if (s->second.sample.expired() && !s->second.loading && s->first != key) s = shared_samples.erase(s);
+		else ++s;
+	}
+
+	shared_samples[key].loading = true;
+	lock.unlock();
+
+	std::shared_ptr< Sample const > sample;
+	try {
+		//(not make_shared, which would keep the Sample's memory until the weak pointer goes too)
+		sample.reset(new Sample(filename, encoding));
+	} catch (...) {
+		//(waiting threads try the load themselves, so they get the error too)
+		lock.lock();
+		shared_samples[key].loading = false;
+		shared_sample_loaded.notify_all();
+		throw;
+	}
+
+	lock.lock();
+	shared_samples[key].sample = sample;
+	shared_samples[key].loading = false;
+	shared_sample_loaded.notify_all();
+	return sample;
+}
+
+Sound::Sample::Sample(std::string const &filename, Stream) {
+	if (!(filename.size() >= 5 && filename.substr(filename.size()-5) == ".opus")) {
+		throw std::runtime_error("Sample '" + filename + "' doesn't end in \".opus\" -- only opus files can be streamed.");
+	}
+	size_t prefix = size_t(STREAM_PREFIX * AUDIO_RATE);
+	load_opus(filename, &data, prefix);
+	//(samples shorter than the prefix are loaded entirely, so don't need streaming)
+	streamed = (data.size() == prefix);
+	stream_filename = filename;
+}
+
+Sound::Sample::Sample(ByteSpan const &bytes, std::string const &name, Stream) {
+	if (!(name.size() >= 5 && name.substr(name.size()-5) == ".opus")) {
+		throw std::runtime_error("Sample '" + name + "' doesn't end in \".opus\" -- only opus files can be streamed.");
+	}
+	size_t prefix = size_t(STREAM_PREFIX * AUDIO_RATE);
+	load_opus(bytes, name, &data, prefix);
+	streamed = (data.size() == prefix);
+	stream_filename = name;
+	stream_bytes = bytes;
+}
+
+size_t Sound::Sample::size() const {
+	switch (encoding) {
+		case Float: return mapped ? mapped_count : data.size();
+		case Int16: return data_int16.size();
+		case ADPCM: return adpcm_count;
+	}
+	return 0;
+}
+
+size_t Sound::Sample::bytes() const {
+	switch (encoding) {
+		case Float: return size() * sizeof(float);
+		case Int16: return data_int16.size() * sizeof(int16_t);
+		case ADPCM: return data_adpcm.size();
+	}
+	return 0;
+}
+
+void Sound::Sample::convert(Encoding new_encoding) {
+	if (new_encoding == encoding) return;
+	if (encoding != Float) {
+		throw std::runtime_error("Samples can only be converted from the Float encoding.");
+	}
+	if (streamed) {
+		std::cerr << "WARNING: not converting streamed sample '" << stream_filename << "'; streamed samples are always Float." << std::endl;
+		return;
+	}
+
+	size_t count = size();
+	size_t before = bytes();
+	if (new_encoding == Int16) {
+		data_int16.resize(count);
+		float const *src = samples();
+		for (size_t i = 0; i < count; ++i) {
+			data_int16[i] = int16_t(std::max(-32768.0f, std::min(32767.0f, std::round(src[i] * 32768.0f))));
+		}
+	} else if (new_encoding == ADPCM) {
+		ima_adpcm_encode(samples(), count, &data_adpcm);
+		adpcm_count = count;
+	}
+	encoding = new_encoding;
+
+	//release the Float samples:
+	std::vector< float >().swap(data);
+	mapped.reset();
+	mapped_samples = nullptr;
+	mapped_count = 0;
+
+	static char const *names[] = { "Float", "Int16", "ADPCM" };
+	std::cout << "converted " << count << " samples to " << names[encoding] << ": "
+	          << (before + 1023) / 1024 << "k -> " << (bytes() + 1023) / 1024 << "k." << std::endl;
+}
+
 
 
 void Sound::init() {
@@ -60,23 +782,28 @@ void Sound::init() {
 		return;
 	}
 
-	//Based on the example on https://wiki.libsdl.org/SDL_OpenAudioDevice
-	SDL_AudioSpec want, have;
-	SDL_zero(want);
-	want.freq = AUDIO_RATE;
-	want.format = AUDIO_F32SYS;
-	want.channels = 2;
-	want.samples = MIX_SAMPLES;
-	want.callback = mix_audio;
+	//mix as many channels as the default device has (if supported, and not set by Sound::set_output_channels):
+	uint32_t channels = requested_channels;
+	if (channels == 0) {
+		channels = 2;
+		#if SDL_VERSION_ATLEAST(2, 24, 0)
+		SDL_AudioSpec spec;
+		if (SDL_GetDefaultAudioInfo(nullptr, &spec, 0) == 0 && speaker_azimuths(spec.channels)) {
+			channels = spec.channels;
+		}
+		#endif
+	}
+	use_output_channels(channels);
 
-	device = SDL_OpenAudioDevice(nullptr, 0, &want, &have, 0);
-	if (device == 0) {
-		std::cerr << "Failed to open audio device:\n" << SDL_GetError() << std::endl;
-		std::cerr << "  (Will continue without audio.)\n" << std::endl;
+	//allocate the voice pool (before the audio callback can run):
+	allocate_mixer();
+
+	if (open_device()) {
+		//start decoding thread for streamed samples:
+		OpusStream::start();
+		std::cout << "Audio output initialized (" << output_channels << " channels)." << std::endl;
 	} else {
-		//start audio playback:
-		SDL_PauseAudioDevice(device, 0);
-		std::cout << "Audio output initialized." << std::endl;
+		std::cerr << "  (Will continue without audio.)\n" << std::endl;
 	}
 }
 
@@ -87,9 +814,190 @@ void Sound::shutdown() {
 		SDL_PauseAudioDevice(device, 1);
 		SDL_CloseAudioDevice(device);
 		device = 0;
+		OpusStream::stop();
+	}
+	if (offline) {
+		offline = false;
+		OpusStream::stop();
 	}
+
+	if (char const *filename = std::getenv("AUDIO_STATS")) {
+		write_stats(std::string(filename) == "1" ? "audio-stats.txt" : filename);
+	}
+}
+
+void Sound::init_offline(uint32_t channels) {
+	assert(device == 0 && "init_offline() replaces init(), rather than adding to it");
+	use_output_channels(channels);
+	allocate_mixer();
+	offline = true;
+	//streamed samples still decode in the background (but render() waits for them, rather than underrunning):
+	OpusStream::start();
+}
+
+void Sound::render(float *out, uint32_t samples) {
+	assert(offline && "call Sound::init_offline() before Sound::render()");
+	assert(samples <= MAX_BLOCK_SAMPLES);
+	mix_audio(nullptr, reinterpret_cast< Uint8 * >(out), int(output_channels * samples * sizeof(float)));
+}
+
+void Sound::set_block_samples(uint32_t samples, bool adaptive) {
+	uint32_t rounded = MIN_BLOCK_SAMPLES;
+	while (rounded < samples && rounded < MAX_BLOCK_SAMPLES) rounded *= 2;
+	if (rounded != samples) {
+		std::cerr << "WARNING: audio block size must be a power of two from " << MIN_BLOCK_SAMPLES << " to " << MAX_BLOCK_SAMPLES << "; using " << rounded << " rather than " << samples << "." << std::endl;
+	}
+	adaptive_blocks = adaptive;
+	min_block_samples = rounded;
+	change_block_samples(rounded);
 }
 
+uint32_t Sound::get_block_samples() {
+	return block_samples;
+}
+
+void Sound::set_output_channels(uint32_t channels) {
+	if (device != 0 || offline) {
+		std::cerr << "WARNING: output channels can only be set before Sound::init(); ignoring." << std::endl;
+		return;
+	}
+	requested_channels = channels;
+}
+
+uint32_t Sound::get_output_channels() {
+	return output_channels;
+}
+
+
+void Sound::update() {
+	//return finished voices to the pool:
+	reclaim_finished_voices();
+
+	static uint32_t reported_underruns = 0;
+	uint32_t underruns = stream_underruns.load(std::memory_order_relaxed);
+	if (underruns != reported_underruns) {
+		std::cerr << "WARNING: streamed audio ran out of decoded samples " << (underruns - reported_underruns) << " time(s); decoder thread may be starved." << std::endl;
+		reported_underruns = underruns;
+	}
+
+	static uint64_t reported_over_budget = 0;
+	static uint64_t reported_late = 0;
+	uint64_t over_budget = stats.over_budget.load(std::memory_order_relaxed);
+	uint64_t late = stats.late.load(std::memory_order_relaxed);
+	if (over_budget != reported_over_budget) {
+		std::cerr << "WARNING: audio callback took longer than the " << (1e3f * block_samples / AUDIO_RATE) << " ms of audio it mixed " << (over_budget - reported_over_budget) << " time(s); output probably dropped out." << std::endl;
+	}
+	if (late != reported_late) {
+		std::cerr << "WARNING: audio callback was delayed " << (late - reported_late) << " time(s); output probably dropped out." << std::endl;
+	}
+
+	//adaptive block size -- grow after trouble; shrink after a quiet spell with plenty of headroom:
+	if (adaptive_blocks && device != 0) {
+		static uint64_t calm_histogram[Stats::HISTOGRAM_BINS] = {}; //stats.histogram when the quiet spell started
+		static auto calm_since = std::chrono::steady_clock::now();
+		auto now = std::chrono::steady_clock::now();
+		auto restart_calm = [&]() {
+			for (uint32_t b = 0; b < Stats::HISTOGRAM_BINS; ++b) {
+				calm_histogram[b] = stats.histogram[b].load(std::memory_order_relaxed);
+			}
+			calm_since = now;
+		};
+
+		if (over_budget != reported_over_budget || late != reported_late) {
+			if (block_samples < MAX_BLOCK_SAMPLES) {
+				if (change_block_samples(block_samples * 2)) {
+					std::cout << "Audio block size increased to " << block_samples << " samples." << std::endl;
+				}
+			}
+			restart_calm();
+		} else if (std::chrono::duration< float >(now - calm_since).count() >= ADAPT_SHRINK_SECONDS) {
+			//longest callback since the quiet spell started, by histogram bin (bin b holds durations under 2^b us):
+			uint32_t longest_bin = 0;
+			for (uint32_t b = 0; b < Stats::HISTOGRAM_BINS; ++b) {
+				if (stats.histogram[b].load(std::memory_order_relaxed) != calm_histogram[b]) longest_bin = b;
+			}
+			uint64_t budget_microseconds = 1000000ULL * block_samples / AUDIO_RATE;
+			if (block_samples > min_block_samples && longest_bin + 1 < Stats::HISTOGRAM_BINS && 4 * (1ULL << longest_bin) <= budget_microseconds) {
+				if (change_block_samples(block_samples / 2)) {
+					std::cout << "Audio block size decreased to " << block_samples << " samples." << std::endl;
+				}
+			}
+			restart_calm();
+		}
+	}
+	reported_over_budget = over_budget;
+	reported_late = late;
+
+	static bool warned = false; //(warn once per backlog, not every frame)
+	if (overflow.empty() || flush_overflow()) {
+		warned = false;
+	} else if (!warned) {
+		std::cerr << "WARNING: audio command queue is full (" << overflow.size() << " commands waiting); is the audio callback running?" << std::endl;
+		warned = true;
+	}
+}
+
+Sound::Stats Sound::get_stats() {
+	Stats ret;
+	for (uint32_t b = 0; b < Stats::HISTOGRAM_BINS; ++b) {
+		ret.histogram[b] = stats.histogram[b].load(std::memory_order_relaxed);
+	}
+	ret.callbacks = stats.callbacks.load(std::memory_order_relaxed);
+	ret.over_budget = stats.over_budget.load(std::memory_order_relaxed);
+	ret.late = stats.late.load(std::memory_order_relaxed);
+	ret.late_starts = stats.late_starts.load(std::memory_order_relaxed);
+	ret.block_samples = stats.block_samples.load(std::memory_order_relaxed);
+	ret.budget_microseconds = uint32_t(1000000ULL * ret.block_samples / AUDIO_RATE);
+	ret.max_microseconds = stats.max_microseconds.load(std::memory_order_relaxed);
+	ret.active_voices = stats.active_voices.load(std::memory_order_relaxed);
+	ret.real_voices = stats.real_voices.load(std::memory_order_relaxed);
+	ret.max_active_voices = stats.max_active_voices.load(std::memory_order_relaxed);
+	ret.max_real_voices = stats.max_real_voices.load(std::memory_order_relaxed);
+	ret.last_peak = stats.last_peak.load(std::memory_order_relaxed);
+	ret.peak = stats.peak.load(std::memory_order_relaxed);
+	ret.stream_underruns = stream_underruns.load(std::memory_order_relaxed);
+	for (uint32_t b = 0; b < MAX_BUSES; ++b) {
+		uint64_t nanoseconds = stats.bus_nanoseconds[b].load(std::memory_order_relaxed);
+		ret.bus_microseconds[b] = (ret.callbacks ? float(double(nanoseconds) / ret.callbacks * 1e-3) : 0.0f);
+	}
+	ret.hrtf_voices = stats.hrtf_voices.load(std::memory_order_relaxed);
+	ret.max_hrtf_voices = stats.max_hrtf_voices.load(std::memory_order_relaxed);
+	uint64_t hrtf_nanoseconds = stats.hrtf_nanoseconds.load(std::memory_order_relaxed);
+	ret.hrtf_microseconds = (ret.callbacks ? float(double(hrtf_nanoseconds) / ret.callbacks * 1e-3) : 0.0f);
+	return ret;
+}
+
+void Sound::write_stats(std::string const &filename) {
+	Stats const stats = get_stats();
+	std::ofstream out(filename, std::ios::binary);
+	out << "callbacks " << stats.callbacks << "\n";
+	out << "over_budget " << stats.over_budget << "\n";
+	out << "late " << stats.late << "\n";
+	out << "late_starts " << stats.late_starts << "\n";
+	out << "block_samples " << stats.block_samples << "\n";
+	out << "budget_us " << stats.budget_microseconds << "\n";
+	out << "max_us " << stats.max_microseconds << "\n";
+	out << "active_voices " << stats.active_voices << " (max " << stats.max_active_voices << ")\n";
+	out << "real_voices " << stats.real_voices << " (max " << stats.max_real_voices << ")\n";
+	out << "peak " << stats.peak << " (last " << stats.last_peak << ")\n";
+	out << "stream_underruns " << stats.stream_underruns << "\n";
+	for (uint32_t b = 0; b < MAX_BUSES; ++b) {
+		if (stats.bus_microseconds[b] > 0.0f) out << "bus " << b << " us " << stats.bus_microseconds[b] << "\n";
+	}
+	out << "hrtf_voices " << stats.hrtf_voices << " (max " << stats.max_hrtf_voices << ") us " << stats.hrtf_microseconds << "\n";
+	out << "histogram (callback duration in us: count):\n";
+	for (uint32_t b = 0; b < Stats::HISTOGRAM_BINS; ++b) {
+		if (b == 0) out << "  <1";
+		else if (b + 1 == Stats::HISTOGRAM_BINS) out << "  >=" << (1U << (b - 1));
+		else out << "  " << (1U << (b - 1)) << "-" << (1U << b);
+		out << ": " << stats.histogram[b] << "\n";
+	}
+	if (!out) {
+		std::cerr << "WARNING: failed to write audio stats to '" << filename << "'." << std::endl;
+	} else {
+		std::cout << "Wrote audio stats to '" << filename << "'." << std::endl;
+	}
+}
 
 void Sound::lock() {
 	if (device) SDL_LockAudioDevice(device);
@@ -100,185 +1008,485 @@ void Sound::unlock() {
 }
 
 std::shared_ptr< Sound::PlayingSample > Sound::play(Sample const &sample, float play_volume, float pan) {
-	std::shared_ptr< Sound::PlayingSample > playing_sample = std::make_shared< Sound::PlayingSample >(sample, play_volume, pan, false);
-	lock();
-	playing_samples.emplace_back(playing_sample);
-	unlock();
-	return playing_sample;
+	Command command;
+	command.value = play_volume;
+	command.value2 = pan;
+	command.loop = false;
+	command.is_3D = false;
+	return start_voice(sample, std::move(command));
 }
 
 std::shared_ptr< Sound::PlayingSample > Sound::play_3D(Sample const &sample, float play_volume, glm::vec3 const &position, float half_volume_radius) {
-	std::shared_ptr< Sound::PlayingSample > playing_sample = std::make_shared< Sound::PlayingSample >(sample, play_volume, position, half_volume_radius, false);
-	lock();
-	playing_samples.emplace_back(playing_sample);
-	unlock();
-	return playing_sample;
+	Command command;
+	command.value = play_volume;
+	command.value2 = half_volume_radius;
+	command.vec = position;
+	command.loop = false;
+	command.is_3D = true;
+	return start_voice(sample, std::move(command));
+}
+
+std::shared_ptr< Sound::PlayingSample > Sound::play_at(Sample const &sample, uint64_t when, float play_volume, float pan) {
+	Command command;
+	command.value = play_volume;
+	command.value2 = pan;
+	command.loop = false;
+	command.is_3D = false;
+	command.scheduled = true;
+	command.start = when;
+	return start_voice(sample, std::move(command));
+}
+
+std::shared_ptr< Sound::PlayingSample > Sound::play_3D_at(Sample const &sample, uint64_t when, float play_volume, glm::vec3 const &position, float half_volume_radius) {
+	Command command;
+	command.value = play_volume;
+	command.value2 = half_volume_radius;
+	command.vec = position;
+	command.loop = false;
+	command.is_3D = true;
+	command.scheduled = true;
+	command.start = when;
+	return start_voice(sample, std::move(command));
 }
 
 std::shared_ptr< Sound::PlayingSample > Sound::loop(Sample const &sample, float play_volume, float pan) {
-	std::shared_ptr< Sound::PlayingSample > playing_sample = std::make_shared< Sound::PlayingSample >(sample, play_volume, pan, true);
-	lock();
-	playing_samples.emplace_back(playing_sample);
-	unlock();
-	return playing_sample;
+	Command command;
+	command.value = play_volume;
+	command.value2 = pan;
+	command.loop = true;
+	command.is_3D = false;
+	return start_voice(sample, std::move(command));
 }
 
 
 
 std::shared_ptr< Sound::PlayingSample > Sound::loop_3D(Sample const &sample, float play_volume, glm::vec3 const &position, float half_volume_radius) {
-	std::shared_ptr< Sound::PlayingSample > playing_sample = std::make_shared< Sound::PlayingSample >(sample, play_volume, position, half_volume_radius, true);
-	lock();
-	playing_samples.emplace_back(playing_sample);
-	unlock();
-	return playing_sample;
+	Command command;
+	command.value = play_volume;
+	command.value2 = half_volume_radius;
+	command.vec = position;
+	command.loop = true;
+	command.is_3D = true;
+	return start_voice(sample, std::move(command));
 }
 
 
-void Sound::stop_all_samples() {
-	lock();
-	for (auto &s : playing_samples) {
-		s->stop();
+std::shared_ptr< Sound::PlayingSample > Sound::loop_at(Sample const &sample, uint64_t when, float play_volume, float pan) {
+	Command command;
+	command.value = play_volume;
+	command.value2 = pan;
+	command.loop = true;
+	command.is_3D = false;
+	command.scheduled = true;
+	command.start = when;
+	return start_voice(sample, std::move(command));
+}
+
+std::shared_ptr< Sound::PlayingSample > Sound::loop_3D_at(Sample const &sample, uint64_t when, float play_volume, glm::vec3 const &position, float half_volume_radius) {
+	Command command;
+	command.value = play_volume;
+	command.value2 = half_volume_radius;
+	command.vec = position;
+	command.loop = true;
+	command.is_3D = true;
+	command.scheduled = true;
+	command.start = when;
+	return start_voice(sample, std::move(command));
+}
+
+Sound::Effect Sound::Effect::low_pass(float frequency, float q) {
+	Effect effect;
+	effect.type = LowPass;
+	effect.frequency = frequency;
+	effect.q = q;
+	return effect;
+}
+
+Sound::Effect Sound::Effect::high_pass(float frequency, float q) {
+	Effect effect;
+	effect.type = HighPass;
+	effect.frequency = frequency;
+	effect.q = q;
+	return effect;
+}
+
+Sound::Effect Sound::Effect::reverb(float room_size, float decay, float damping, float wet) {
+	Effect effect;
+	effect.type = Reverb;
+	effect.room_size = room_size;
+	effect.decay = decay;
+	effect.damping = damping;
+	effect.wet = wet;
+	return effect;
+}
+
+Sound::Effect Sound::Effect::convolution(ImpulseResponse const &impulse_response, float wet) {
+	Effect effect;
+	effect.type = Convolution;
+	effect.impulse_response = &impulse_response;
+	effect.wet = wet;
+	return effect;
+}
+
+//helper: split up and transform an impulse response for the convolution engine:
+static std::shared_ptr< ConvolutionFilter const > impulse_response_filter(std::vector< float > const &data, std::string const &name) {
+	uint32_t length = uint32_t(std::min(data.size(), size_t(IMPULSE_RESPONSE_PARTITIONS * IMPULSE_RESPONSE_BLOCK)));
+	if (length < data.size()) {
+		std::cerr << "WARNING: impulse response '" << name << "' is longer than " << Sound::MAX_IMPULSE_RESPONSE_SECONDS << " seconds; cutting it short." << std::endl;
+	}
+	return std::make_shared< ConvolutionFilter const >(IMPULSE_RESPONSE_BLOCK, data.data(), nullptr, length);
+}
+
+Sound::ImpulseResponse::ImpulseResponse(std::string const &filename) {
+	std::vector< float > data;
+	load_wav(filename, &data);
+	filter = impulse_response_filter(data, filename);
+}
+
+Sound::ImpulseResponse::ImpulseResponse(std::vector< float > const &data) : filter(impulse_response_filter(data, "(data)")) {
+}
+
+uint32_t Sound::add_bus(uint32_t parent) {
+	if (parent >= bus_count) {
+		std::cerr << "WARNING: parent bus " << parent << " hasn't been added; using the master bus instead." << std::endl;
+		parent = MASTER_BUS;
+	}
+	if (bus_count == MAX_BUSES) {
+		std::cerr << "WARNING: all " << MAX_BUSES << " buses are in use; using the master bus instead of a new one." << std::endl;
+		return MASTER_BUS;
+	}
+	uint32_t bus = bus_count;
+	bus_count += 1;
+
+	Command command;
+	command.type = Command::AddBus;
+	command.bus = bus;
+	command.to_bus = parent;
+	send(std::move(command));
+	return bus;
+}
+
+void Sound::set_bus_effects(uint32_t bus, std::vector< Effect > const &effects) {
+	if (bus >= bus_count) {
+		std::cerr << "WARNING: ignoring effects for bus " << bus << ", which hasn't been added." << std::endl;
+		return;
+	}
+	if (effects.size() > MAX_BUS_EFFECTS) {
+		std::cerr << "WARNING: buses can have at most " << MAX_BUS_EFFECTS << " effects; ignoring the last " << (effects.size() - MAX_BUS_EFFECTS) << "." << std::endl;
+	}
+	bool have_reverb = false;
+	bool have_convolution = false;
+	for (uint32_t slot = 0; slot < MAX_BUS_EFFECTS; ++slot) {
+		Command command;
+		command.type = Command::SetBusEffect;
+		command.bus = bus;
+		command.slot = slot;
+		if (slot < effects.size()) command.effect = effects[slot];
+		if (command.effect.type == Effect::Reverb) {
+			if (have_reverb) {
+				std::cerr << "WARNING: buses can have only one reverb; ignoring the others." << std::endl;
+				command.effect = Effect();
+			}
+			have_reverb = true;
+		} else if (command.effect.type == Effect::Convolution) {
+			if (have_convolution || !command.effect.impulse_response) {
+				std::cerr << "WARNING: buses can have only one convolution, and it needs an impulse response; ignoring the others." << std::endl;
+				command.effect = Effect();
+			} else {
+				//(the convolver's history is too big to allocate for every bus up front, so make it now)
+				if (!bus_convolvers[bus]) bus_convolvers[bus] = std::make_unique< Convolver >(IMPULSE_RESPONSE_BLOCK, IMPULSE_RESPONSE_PARTITIONS);
+				command.convolver = bus_convolvers[bus].get();
+			}
+			have_convolution = true;
+		}
+		send(std::move(command));
+	}
+}
+
+void Sound::set_bus_volume(uint32_t bus, float new_volume, float ramp) {
+	if (bus == MASTER_BUS) {
+		//(the master bus's volume is the global volume)
+		set_volume(new_volume, ramp);
+		return;
+	}
+	if (bus >= bus_count) return;
+	Command command;
+	command.type = Command::SetBusVolume;
+	command.bus = bus;
+	command.value = new_volume;
+	command.ramp = ramp;
+	send(std::move(command));
+}
+
+void Sound::set_bus_send(uint32_t bus, uint32_t send_bus, float level) {
+	if (bus == MASTER_BUS || bus >= bus_count || send_bus >= bus) {
+		std::cerr << "WARNING: can't send bus " << bus << " to bus " << send_bus << " (buses can only send to buses added before them)." << std::endl;
+		return;
 	}
-	unlock();
+	Command command;
+	command.type = Command::SetBusSend;
+	command.bus = bus;
+	command.to_bus = send_bus;
+	command.value = level;
+	send(std::move(command));
+}
+
+void Sound::set_distance_low_pass(float half_cutoff_distance) {
+	Command command;
+	command.type = Command::SetDistanceLowPass;
+	command.value = half_cutoff_distance;
+	send(std::move(command));
+}
+
+void Sound::load_hrtf(std::string const &filename) {
+	std::ifstream file(filename, std::ios::binary);
+	if (!file) throw std::runtime_error("Failed to open HRTF set '" + filename + "'.");
+	StartupProfile::Scope scope("load_hrtf", "startup", __FILE__, __LINE__, filename.c_str());
+
+	//response files are found relative to the set:
+	std::string dir = filename.substr(0, filename.find_last_of("/\\") + 1);
+
+	struct Response {
+		glm::vec3 direction;
+		std::vector< float > left, right;
+	};
+	std::vector< Response > responses;
+	bool warned = false;
+	std::string line;
+	uint32_t line_number = 0;
+	while (std::getline(file, line)) {
+		line_number += 1;
+		line = line.substr(0, line.find('#'));
+		if (line.find_first_not_of(" \t\r") == std::string::npos) continue; //(blank line)
+
+		std::istringstream str(line);
+		float azimuth, elevation;
+		std::string left, right;
+		if (!(str >> azimuth >> elevation >> left >> right)) {
+			throw std::runtime_error(filename + ":" + std::to_string(line_number) + ": expecting '<azimuth> <elevation> <left.wav> <right.wav>'.");
+		}
+		Response response;
+		float a = azimuth * (3.14159265358979323846f / 180.0f);
+		float e = elevation * (3.14159265358979323846f / 180.0f);
+		response.direction = glm::vec3(std::sin(a) * std::cos(e), std::cos(a) * std::cos(e), std::sin(e));
+		load_wav(left[0] == '/' ? left : dir + left, &response.left);
+		load_wav(right[0] == '/' ? right : dir + right, &response.right);
+		for (auto *ear : { &response.left, &response.right }) {
+			if (ear->size() > MAX_HRIR_SAMPLES) {
+				if (!warned) std::cerr << "WARNING: HRIRs in '" << filename << "' are longer than " << MAX_HRIR_SAMPLES << " samples; cutting them short." << std::endl;
+				warned = true;
+				ear->resize(MAX_HRIR_SAMPLES);
+			}
+		}
+		responses.emplace_back(std::move(response));
+	}
+	if (responses.empty()) throw std::runtime_error("HRTF set '" + filename + "' has no responses.");
+
+	//scale so that, averaged over directions, the two ears together get the same power as from panning:
+	double energy = 0.0;
+	for (auto const &response : responses) {
+		for (float v : response.left) energy += double(v) * v;
+		for (float v : response.right) energy += double(v) * v;
+	}
+	energy /= double(responses.size());
+	float scale = (energy > 0.0 ? float(1.0 / std::sqrt(energy)) : 1.0f);
+
+	auto set = std::make_unique< HRTFSet >();
+	set->directions.reserve(responses.size());
+	set->filters.reserve(responses.size());
+	for (auto &response : responses) {
+		size_t length = std::max(response.left.size(), response.right.size());
+		response.left.resize(length, 0.0f);
+		response.right.resize(length, 0.0f);
+		for (size_t i = 0; i < length; ++i) {
+			response.left[i] *= scale;
+			response.right[i] *= scale;
+		}
+		set->directions.emplace_back(response.direction);
+		set->filters.emplace_back(CONTROL_SAMPLES, response.left.data(), response.right.data(), uint32_t(length));
+	}
+	std::cout << "Loaded " << responses.size() << " HRIR pairs from '" << filename << "'." << std::endl;
+
+	Command command;
+	command.type = Command::SetHRTF;
+	command.data = set.get();
+	send(std::move(command));
+	hrtf_sets.emplace_back(std::move(set));
+}
+
+void Sound::set_hrtf_budget(uint32_t max_voices, float cpu_fraction) {
+	Command command;
+	command.type = Command::SetHRTFBudget;
+	command.voice = std::min(max_voices, MAX_HRTF_VOICES);
+	command.value = cpu_fraction;
+	send(std::move(command));
+}
+
+uint64_t Sound::get_audio_clock() {
+	return audio_clock.load(std::memory_order_relaxed);
+}
+
+void Sound::stop_all_samples() {
+	Command command;
+	command.type = Command::StopAll;
+	command.ramp = 1.0f / 60.0f;
+	send(std::move(command));
 }
 
 void Sound::set_volume(float new_volume, float ramp) {
-	lock();
-	volume.set(new_volume, ramp);
-	unlock();
+	Command command;
+	command.type = Command::SetGlobalVolume;
+	command.value = new_volume;
+	command.ramp = ramp;
+	send(std::move(command));
+}
+
+void Sound::set_virtualization(uint32_t new_max_real_voices, float new_audibility_threshold) {
+	Command command;
+	command.type = Command::SetVirtualization;
+	command.voice = new_max_real_voices;
+	command.value = new_audibility_threshold;
+	send(std::move(command));
 }
 
 //------------------
 
+bool Sound::PlayingSample::stopped() const {
+	//(the voice's generation changes once the game thread reclaims it)
+	return voice >= voice_generations.size() || voice_generations[voice] != generation;
+}
+
+//helper: send a command about a PlayingSample's voice:
+void send_to_voice(Sound::PlayingSample const &playing_sample, Command &&command) {
+	if (playing_sample.stopped()) return; //(the audio thread would ignore it anyway)
+	command.voice = playing_sample.voice;
+	command.generation = playing_sample.generation;
+	send(std::move(command));
+}
+
 void Sound::PlayingSample::set_volume(float new_volume, float ramp) {
-	Sound::lock();
-	if (!stopping) {
-		volume.set(new_volume, ramp);
-	}
-	Sound::unlock();
+	Command command;
+	command.type = Command::SetVolume;
+	command.value = new_volume;
+	command.ramp = ramp;
+	send_to_voice(*this, std::move(command));
 }
 
 void Sound::PlayingSample::set_pan(float new_pan, float ramp) {
-	if (!(pan.value == pan.value)) return; //ignore if not in '2D' mode
-	Sound::lock();
-	pan.set(new_pan, ramp);
-	Sound::unlock();
+	if (is_3D) return; //ignore if not in '2D' mode
+	Command command;
+	command.type = Command::SetPan;
+	command.value = new_pan;
+	command.ramp = ramp;
+	send_to_voice(*this, std::move(command));
 }
 
 void Sound::PlayingSample::set_position(glm::vec3 const &new_position, float ramp) {
-	if (pan.value == pan.value) return; //ignore if not in '3D' mode
-	Sound::lock();
-	position.set(new_position, ramp);
-	Sound::unlock();
+	if (!is_3D) return; //ignore if not in '3D' mode
+	Command command;
+	command.type = Command::SetPosition;
+	command.vec = new_position;
+	command.ramp = ramp;
+	send_to_voice(*this, std::move(command));
 }
 
 void Sound::PlayingSample::set_half_volume_radius(float new_radius, float ramp) {
-	if (pan.value == pan.value) return; //ignore if not in '3D' mode
-	Sound::lock();
-	half_volume_radius.set(new_radius, ramp);
-	Sound::unlock();
+	if (!is_3D) return; //ignore if not in '3D' mode
+	Command command;
+	command.type = Command::SetHalfVolumeRadius;
+	command.value = new_radius;
+	command.ramp = ramp;
+	send_to_voice(*this, std::move(command));
 }
 
-void Sound::PlayingSample::stop(float ramp) {
-	Sound::lock();
-	if (!(stopping || stopped)) {
-		stopping = true;
-		volume.target = 0.0f;
-		volume.ramp = ramp;
-	} else {
-		volume.ramp = std::min(volume.ramp, ramp);
+void Sound::PlayingSample::set_priority(float new_priority) {
+	Command command;
+	command.type = Command::SetPriority;
+	command.value = new_priority;
+	send_to_voice(*this, std::move(command));
+}
+
+void Sound::PlayingSample::set_bus(uint32_t new_bus) {
+	if (new_bus >= bus_count) {
+		std::cerr << "WARNING: sample moved to bus " << new_bus << ", which hasn't been added; ignoring." << std::endl;
+		return;
 	}
-	Sound::unlock();
+	Command command;
+	command.type = Command::SetBus;
+	command.bus = new_bus;
+	send_to_voice(*this, std::move(command));
+}
+
+void Sound::PlayingSample::set_rate(float new_rate, float ramp) {
+	Command command;
+	command.type = Command::SetRate;
+	command.value = new_rate;
+	command.ramp = ramp;
+	send_to_voice(*this, std::move(command));
+}
+
+void Sound::PlayingSample::stop(float ramp) {
+	Command command;
+	command.type = Command::Stop;
+	command.ramp = ramp;
+	send_to_voice(*this, std::move(command));
 }
 
 //------------------
 
 void Sound::Listener::set_position_right(glm::vec3 const &new_position, glm::vec3 const &new_right, float ramp) {
-	Sound::lock();
-	position.set(new_position, ramp);
+	Command command;
+	command.type = Command::SetListener;
+	command.vec = new_position;
 	//some extra code to make sure right is always a unit vector:
 	if (new_right == glm::vec3(0.0f)) {
-		right.set(glm::vec3(1.0f, 0.0f, 0.0f), ramp);
+		command.vec2 = glm::vec3(1.0f, 0.0f, 0.0f);
 	} else {
-		right.set(glm::normalize(new_right), ramp);
+		command.vec2 = glm::normalize(new_right);
 	}
-	Sound::unlock();
+	command.ramp = ramp;
+	send(std::move(command));
 }
 
-//------------------------ internals --------------------------------
-
+void Sound::Listener::set_position_right_up(glm::vec3 const &new_position, glm::vec3 const &new_right, glm::vec3 const &new_up, float ramp) {
+	set_position_right(new_position, new_right, ramp);
+	Command command;
+	command.type = Command::SetListenerUp;
+	command.vec = (new_up == glm::vec3(0.0f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::normalize(new_up));
+	command.ramp = ramp;
+	send(std::move(command));
+}
 
-//helper: equal-power panning
-inline void compute_pan_weights(float pan, float *left, float *right) {
-	//clamp pan to -1 to 1 range:
-	pan = std::max(-1.0f, std::min(1.0f, pan));
-
-	//want left^2 + right^2 = 1.0, so use angles:
-	float ang = 0.5f * 3.1415926f * (0.5f * (pan + 1.0f));
-	*left = std::cos(ang);
-	*right = std::sin(ang);
-}
-
-//helper: 3D audio panning
-void compute_pan_from_listener_and_position(
-	glm::vec3 const &listener_position,
-	glm::vec3 const &listener_right,
-	glm::vec3 const &source_position,
-	float source_half_radius,
-	float *left, float *right
-	) {
-	glm::vec3 to = source_position - listener_position;
-	float distance = glm::length(to);
-	//start by panning based on direction.
-	//note that for a LR fade to sound uniform, sound power (squared magnitude) should remain constant.
-	if (distance == 0.0f) {
-		*left = *right = std::sqrt(2.0f);
-	} else {
-		//amt ranges from -1 (most left) to 1 (most right):
-		float amt = glm::dot(listener_right, to) / distance;
-		//turn into an angle from 0.0f (most left) to pi/2 (most right):
-		float ang = 0.5f * 3.1415926f * (0.5f * (amt + 1.0f));
-		*left = std::cos(ang);
-		*right = std::sin(ang);
+//------------------------ internals --------------------------------
 
-		//squared distance attenuation is realistic if there are no walls,
-		// but I'm going to use linear because it's sounds better to me.
-		// (feel free to change it, of course)
-		//want att = 0.5f at distance == half_volume_radius
-		float att = 1.0f / (1.0f + (distance / source_half_radius));
-		*left *= att;
-		*right *= att;
-	}
-}
 
-//helper: ramp updates...
-constexpr float const RAMP_STEP = float(MIX_SAMPLES) / float(AUDIO_RATE);
+//helper: ramp updates (moving 'step' seconds along the ramp -- one block's worth of audio)...
 
 //helper: ...for single values:
-void step_value_ramp(Sound::Ramp< float > &ramp) {
-	if (ramp.ramp < RAMP_STEP) {
+void step_value_ramp(Sound::Ramp< float > &ramp, float step) {
+	if (ramp.ramp < step) {
 		ramp.value = ramp.target;
 		ramp.ramp = 0.0f;
 	} else {
-		ramp.value += (RAMP_STEP / ramp.ramp) * (ramp.target - ramp.value);
-		ramp.ramp -= RAMP_STEP;
+		ramp.value += (step / ramp.ramp) * (ramp.target - ramp.value);
+		ramp.ramp -= step;
 	}
 }
 
 //helper: ...for 3D positions:
-void step_position_ramp(Sound::Ramp< glm::vec3 > &ramp) {
-	if (ramp.ramp < RAMP_STEP) {
+void step_position_ramp(Sound::Ramp< glm::vec3 > &ramp, float step) {
+	if (ramp.ramp < step) {
 		ramp.value = ramp.target;
 		ramp.ramp = 0.0f;
 	} else {
-		ramp.value = glm::mix(ramp.value, ramp.target, RAMP_STEP / ramp.ramp);
-		ramp.ramp -= RAMP_STEP;
+		ramp.value = glm::mix(ramp.value, ramp.target, step / ramp.ramp);
+		ramp.ramp -= step;
 	}
 }
 
 //helper: ...for 3D directions:
-void step_direction_ramp(Sound::Ramp< glm::vec3 > &ramp) {
-	if (ramp.ramp < RAMP_STEP) {
+void step_direction_ramp(Sound::Ramp< glm::vec3 > &ramp, float step) {
+	if (ramp.ramp < step) {
 		ramp.value = ramp.target;
 		ramp.ramp = 0.0f;
 	} else {
@@ -302,135 +1510,1044 @@ void step_direction_ramp(Sound::Ramp< glm::vec3 > &ramp) {
 		float angle = std::acos(glm::clamp(glm::dot(ramp.value, ramp.target), -1.0f, 1.0f));
 
 		//figure out new target value by moving angle toward target:
-		angle *= (ramp.ramp - RAMP_STEP) / ramp.ramp;
+		angle *= (ramp.ramp - step) / ramp.ramp;
 
 		ramp.value = ramp.target * std::cos(angle) + perp * std::sin(angle);
-		ramp.ramp -= RAMP_STEP;
+		ramp.ramp -= step;
 	}
 }
 
 
-//The audio callback -- invoked by SDL when it needs more sound to play:
-void mix_audio(void *, Uint8 *buffer_, int len) {
-	assert(buffer_); //should always have some audio buffer
+//helper: read up to 'count' samples from a voice's stream (see OpusStream::read):
+// when rendering offline there's no deadline, so wait for the decoder instead of underrunning (keeps renders repeatable)
+uint32_t read_stream(Voice &voice, float *out, uint32_t count) {
+	uint32_t got = OpusStream::read(voice.stream, out, count, &voice.stream_ended);
+	while (offline && got < count && !voice.stream_ended) {
+		std::this_thread::yield();
+		got += OpusStream::read(voice.stream, out + got, count - got, &voice.stream_ended);
+	}
+	return got;
+}
+
+//helper: get 'count' samples of a voice's data (starting at voice.i) as floats, decoding if needed:
+float const *voice_samples(Voice const &voice, uint32_t count) {
+	assert(count <= CONTROL_SAMPLES);
+	switch (voice.encoding) {
+		case Sound::Sample::Float:
+			return static_cast< float const * >(voice.data) + voice.i;
+		case Sound::Sample::Int16:
+			int16_to_float(static_cast< int16_t const * >(voice.data) + voice.i, count, decode_buffer);
+			return decode_buffer;
+		case Sound::Sample::ADPCM:
+			ima_adpcm_decode(static_cast< uint8_t const * >(voice.data), voice.i, count, decode_buffer);
+			return decode_buffer;
+	}
+	return nullptr;
+}
 
-	struct LR {
-		float l;
-		float r;
+//helper: add a voice's next 'samples' samples into (interleaved, output_channels channels) 'buffer', with gains starting at 'gains' and changing by 'gain_steps' per sample:
+void mix_voice(Voice &voice, uint32_t samples, float const *gains, float const *gain_steps, float *buffer) {
+	//(gains at the start of each segment)
+	float segment_gains[Sound::MAX_OUTPUT_CHANNELS];
+	auto gains_at = [&](uint32_t mixed) {
+		for (uint32_t c = 0; c < output_channels; ++c) {
+			segment_gains[c] = gains[c] + mixed * gain_steps[c];
+		}
+		return segment_gains;
 	};
-	static_assert(sizeof(LR) == 8, "Sample is packed");
-	assert(len == MIX_SAMPLES * sizeof(LR)); //should always have the expected number of samples
-	LR *buffer = reinterpret_cast< LR * >(buffer_);
 
-	//zero the output buffer:
-	for (uint32_t s = 0; s < MIX_SAMPLES; ++s) {
-		buffer[s].l = 0.0f;
-		buffer[s].r = 0.0f;
+	//mix in contiguous segments, split wherever the sample ends (or loops -- possibly several times):
+	for (uint32_t mixed = 0; mixed < samples; /* later */) {
+		if (voice.i == voice.size) {
+			if (voice.stream != -1U) {
+				//streamed samples continue from the decoder's ring buffer:
+				uint32_t count = read_stream(voice, decode_buffer, samples - mixed);
+				mix_mono_to_channels(
+					decode_buffer, count, output_channels,
+					gains_at(mixed), gain_steps,
+					buffer + output_channels * mixed
+				);
+				if (mixed + count < samples && !voice.stream_ended) {
+					//decoder has fallen behind; voice is silent for the rest of the block:
+					stream_underruns.fetch_add(1, std::memory_order_relaxed);
+				}
+				break;
+			} else if (voice.loop) {
+				voice.i = 0;
+			} else {
+				break;
+			}
+		}
+
+		uint32_t count = std::min(samples - mixed, voice.size - voice.i);
+		mix_mono_to_channels(
+			voice_samples(voice, count), count, output_channels,
+			gains_at(mixed), gain_steps,
+			buffer + output_channels * mixed
+		);
+		mixed += count;
+
+		//update position in sample:
+		voice.i += count;
 	}
+}
 
-	//update global values:
-	float start_volume = Sound::volume.value;
-	glm::vec3 start_position =  Sound::listener.position.value;
-	glm::vec3 start_right =  Sound::listener.right.value;
+//helper: advance a (virtual) voice's playback position by 'count' samples without mixing it:
+void advance_voice(Voice &voice, uint32_t count) {
+	while (count > 0) {
+		if (voice.i == voice.size) {
+			if (voice.stream != -1U) {
+				//(streams are read and discarded, so they stay in step with the voice)
+				while (count > 0 && !voice.stream_ended) {
+					uint32_t step = std::min(count, CONTROL_SAMPLES);
+					if (read_stream(voice, decode_buffer, step) < step) break;
+					count -= step;
+				}
+				break;
+			} else if (voice.loop) {
+				voice.i = 0;
+			} else {
+				break;
+			}
+		}
+		uint32_t step = std::min(count, voice.size - voice.i);
+		voice.i += step;
+		count -= step;
+	}
+}
 
-	step_value_ramp(Sound::volume);
-	step_position_ramp( Sound::listener.position);
-	step_direction_ramp( Sound::listener.right);
+//helper: read a voice's next 'count' samples into 'out' (advancing its playback position, and looping or streaming as needed);
+// fills the rest of 'out' with silence if the sample ends:
+void read_voice(Voice &voice, float *out, uint32_t count) {
+	uint32_t done = 0;
+	while (done < count) {
+		if (voice.i == voice.size) {
+			if (voice.stream != -1U) {
+				uint32_t got = read_stream(voice, out + done, count - done);
+				if (done + got < count && !voice.stream_ended) {
+					stream_underruns.fetch_add(1, std::memory_order_relaxed);
+				}
+				done += got;
+				break;
+			} else if (voice.loop) {
+				voice.i = 0;
+			} else {
+				break;
+			}
+		}
+		uint32_t n = std::min(std::min(count - done, voice.size - voice.i), CONTROL_SAMPLES);
+		std::memcpy(out + done, voice_samples(voice, n), n * sizeof(float));
+		done += n;
+		voice.i += n;
+	}
+	std::fill(out + done, out + count, 0.0f);
+}
 
-	float end_volume = Sound::volume.value;
-	glm::vec3 end_position =  Sound::listener.position.value;
-	glm::vec3 end_right =  Sound::listener.right.value;
+//helper: switch a voice to resampled playback, filling its rate_window with the samples before its current position:
+void start_resampling(Voice &voice) {
+	voice.resampling = true;
+	voice.rate_position = 0.0;
+	if (voice.stream != -1U && voice.i == voice.size) {
+		//(playing from the stream's ring, which keeps the samples just read; any before those are the end of data)
+		static_assert(RESAMPLE_TAPS <= OpusStream::HISTORY_SAMPLES, "the ring keeps enough samples to fill rate_window");
+		uint32_t got = OpusStream::history(voice.stream, voice.rate_window, RESAMPLE_TAPS);
+		uint32_t before = std::min(RESAMPLE_TAPS - got, voice.size);
+		std::fill(voice.rate_window, voice.rate_window + (RESAMPLE_TAPS - got - before), 0.0f);
+		std::memcpy(voice.rate_window + (RESAMPLE_TAPS - got - before), static_cast< float const * >(voice.data) + (voice.size - before), before * sizeof(float));
+	} else if (voice.i >= RESAMPLE_TAPS && voice.i <= voice.size) {
+		//(playing from data, so the previous samples are still there)
+		voice.i -= RESAMPLE_TAPS;
+		std::memcpy(voice.rate_window, voice_samples(voice, RESAMPLE_TAPS), RESAMPLE_TAPS * sizeof(float));
+		voice.i += RESAMPLE_TAPS;
+	} else {
+		//(just started, or can't easily get the previous samples)
+		std::fill(voice.rate_window, voice.rate_window + RESAMPLE_TAPS, 0.0f);
+	}
+}
 
-	//add audio from each playing sample into the buffer:
-	for (auto si = playing_samples.begin(); si != playing_samples.end(); /* later */) {
-		Sound::PlayingSample &playing_sample = **si; //much more convenient than writing ** everywhere.
+//helper: resample a voice's next 'samples' samples (at most CONTROL_SAMPLES) into resample_output, with its rate going from 'rate' to 'end_rate':
+// (if 'output' is false -- for virtual voices -- just advances the voice by the same amount, for any number of samples)
+void resample_voice(Voice &voice, uint32_t samples, float rate, float end_rate, bool output) {
+	float rate_step = (end_rate - rate) / samples;
+	double end = resample_position(voice.rate_position, rate, rate_step, samples);
+	uint32_t consumed = uint32_t(end); //(number of samples the window moves forward)
+
+	if (output) {
+		assert(consumed <= uint32_t(MAX_RATE * CONTROL_SAMPLES) + 1); //(resample_input holds one control block's worth)
+		std::memcpy(resample_input, voice.rate_window, RESAMPLE_TAPS * sizeof(float));
+		read_voice(voice, resample_input + RESAMPLE_TAPS, consumed);
+
+		float fastest = std::max(rate, end_rate);
+		ResampleFilter const &filter = rate_filters[fastest <= 1.0f ? 0 : (fastest <= 2.0f ? 1 : 2)];
+		resample_block(filter, resample_input, voice.rate_position, rate, rate_step, samples, resample_output);
+
+		std::memcpy(voice.rate_window, resample_input + consumed, RESAMPLE_TAPS * sizeof(float));
+	} else if (consumed >= RESAMPLE_TAPS) {
+		//(window is entirely replaced, so skip to just before it)
+		advance_voice(voice, consumed - RESAMPLE_TAPS);
+		read_voice(voice, voice.rate_window, RESAMPLE_TAPS);
+	} else {
+		std::memmove(voice.rate_window, voice.rate_window + consumed, (RESAMPLE_TAPS - consumed) * sizeof(float));
+		read_voice(voice, voice.rate_window + (RESAMPLE_TAPS - consumed), consumed);
+	}
+	voice.rate_position = end - double(consumed);
+}
 
-		//Figure out sample panning/volume at start...
-		LR start_pan;
-		if (!(playing_sample.pan.value == playing_sample.pan.value)) {
-			//3D panning
-			compute_pan_from_listener_and_position(
-				start_position, start_right,
-				playing_sample.position.value,
-				playing_sample.half_volume_radius.value,
-				&start_pan.l, &start_pan.r);
-
-			step_position_ramp(playing_sample.position);
-			step_value_ramp(playing_sample.half_volume_radius);
+//helper: stop a voice (fading out over 'ramp' seconds):
+void stop_voice(Voice &voice, float ramp) {
+	if (!voice.stopping) {
+		voice.stopping = true;
+		voice.volume.target = 0.0f;
+		voice.volume.ramp = ramp;
+	} else {
+		voice.volume.ramp = std::min(voice.volume.ramp, ramp);
+	}
+}
+
+//helper: add a voice to the active list (so it is mixed from the next block on):
+void activate_voice(uint32_t index) {
+	Voice &voice = voices[index];
+	voice.active_index = active_count;
+	active_voices[active_count] = index;
+	active_count += 1;
+}
+
+//helper: start a voice playing (or schedule it to start later):
+void start_voice_playing(Command const &command) {
+	assert(command.voice < voices.size());
+	Voice &voice = voices[command.voice];
+	assert(voice.active_index == -1U && "game thread only starts free voices");
+
+	voice.data = command.data;
+	voice.encoding = command.encoding;
+	voice.size = command.size;
+	voice.i = 0;
+	voice.stream = command.stream;
+	voice.stream_ended = (command.stream == -1U);
+	voice.generation = command.generation;
+	voice.loop = command.loop;
+	voice.stopping = false;
+	voice.is_3D = command.is_3D;
+	voice.priority = 1.0f; //(see PlayingSample::set_priority)
+	voice.real = false;
+	voice.fresh = true; //(doesn't fade in, since that would soften its attack)
+	voice.delay = 0;
+	voice.bus = Sound::MASTER_BUS; //(see PlayingSample::set_bus)
+	voice.low_pass_state = 0.0f;
+	voice.rate.set(1.0f, 0.0f);
+	voice.resampling = false;
+	voice.volume.set(command.value, 0.0f);
+	if (command.is_3D) {
+		voice.position.set(command.vec, 0.0f);
+		voice.half_volume_radius.set(command.value2, 0.0f);
+	} else {
+		voice.pan.set(command.value2, 0.0f);
+	}
+
+	if (command.scheduled) {
+		//wait for start_scheduled_voices:
+		voice.scheduled = true;
+		voice.start = command.start;
+		scheduled_voices.emplace_back(command.voice);
+		return;
+	}
+
+	activate_voice(command.voice);
+}
+
+//helper: start the scheduled voices whose start time falls in the next 'samples' samples:
+void start_scheduled_voices(uint32_t samples) {
+	for (uint32_t s = 0; s < scheduled_voices.size(); /* later */) {
+		uint32_t index = scheduled_voices[s];
+		Voice &voice = voices[index];
+		if (voice.start >= mix_clock + samples) {
+			++s;
+			continue;
+		}
+		if (voice.start < mix_clock) {
+			//(the play_at command arrived after its start time, so start as soon as possible)
+			stats_add(stats.late_starts, uint64_t(1));
+			voice.delay = 0;
 		} else {
-			//2D panning
-			compute_pan_weights(playing_sample.pan.value, &start_pan.l, &start_pan.r);
+			voice.delay = uint32_t(voice.start - mix_clock);
+		}
+		voice.scheduled = false;
+		activate_voice(index);
+
+		scheduled_voices[s] = scheduled_voices.back();
+		scheduled_voices.pop_back();
+	}
+}
+
+//helper: drop the scheduled voice at position 's' in scheduled_voices before it starts, and hand it back to the game thread:
+// (only for voices that start after the current block begins; ones due now are stopped like playing voices)
+void cancel_scheduled_voice(uint32_t s) {
+	uint32_t index = scheduled_voices[s];
+	assert(voices[index].scheduled);
+	voices[index].scheduled = false;
+	scheduled_voices[s] = scheduled_voices.back();
+	scheduled_voices.pop_back();
+
+	bool pushed = finished_voices.push(std::move(index));
+	assert(pushed && "finished_voices has room for every voice");
+	(void)pushed;
+}
+
+//helper: remove a voice from the active list and hand it back to the game thread:
+void finish_voice(uint32_t index) {
+	Voice &voice = voices[index];
+	assert(voice.active_index < active_count);
+
+	//move last active voice into this voice's spot:
+	uint32_t last = active_voices[active_count - 1];
+	active_voices[voice.active_index] = last;
+	voices[last].active_index = voice.active_index;
+	active_count -= 1;
+	voice.active_index = -1U;
+
+	if (voice.hrtf != -1U) {
+		free_hrtf_convolvers.emplace_back(voice.hrtf);
+		voice.hrtf = -1U;
+	}
+
+	bool pushed = finished_voices.push(std::move(index));
+	assert(pushed && "finished_voices has room for every voice");
+	(void)pushed;
+}
+
+//helper: find the voice a command refers to (nullptr if that playback has already finished):
+Voice *command_voice(Command const &command) {
+	if (command.voice >= voices.size()) return nullptr;
+	Voice &voice = voices[command.voice];
+	if ((voice.active_index == -1U && !voice.scheduled) || voice.generation != command.generation) return nullptr;
+	return &voice;
+}
 
-			step_value_ramp(playing_sample.pan);
+//helper: change one of a bus's effects (resetting its state if the type changed):
+void set_bus_effect(Bus &bus, uint32_t slot, Sound::Effect const &effect) {
+	assert(slot < Sound::MAX_BUS_EFFECTS);
+	bool changed = (bus.effects[slot].type != effect.type);
+	bus.effects[slot] = effect;
+	if (effect.type == Sound::Effect::LowPass || effect.type == Sound::Effect::HighPass) {
+		if (changed) std::fill(bus.biquad_states[slot], bus.biquad_states[slot] + 2 * Sound::MAX_OUTPUT_CHANNELS, 0.0f);
+		if (effect.type == Sound::Effect::LowPass) bus.biquads[slot] = biquad_low_pass(effect.frequency, effect.q, float(AUDIO_RATE));
+		else bus.biquads[slot] = biquad_high_pass(effect.frequency, effect.q, float(AUDIO_RATE));
+	} else if (effect.type == Sound::Effect::Reverb) {
+		if (changed) {
+			std::fill(bus.reverb_lines.begin(), bus.reverb_lines.end(), 0.0f);
+			std::fill(bus.reverb.filter, bus.reverb.filter + 4, 0.0f);
 		}
-		start_pan.l *= start_volume * playing_sample.volume.value;
-		start_pan.r *= start_volume * playing_sample.volume.value;
+		float scale = 0.25f + 0.75f * std::max(0.0f, std::min(1.0f, effect.room_size));
+		for (uint32_t k = 0; k < 4; ++k) {
+			bus.reverb.length[k] = std::max(1U, uint32_t(REVERB_LENGTHS[k] * scale));
+			//(each trip through line k takes length[k] samples, so this gain falls by 60dB in 'decay' seconds)
+			bus.reverb.gain[k] = std::pow(10.0f, -3.0f * bus.reverb.length[k] / (std::max(0.01f, effect.decay) * AUDIO_RATE));
+		}
+		bus.reverb.damping = std::max(0.0f, std::min(0.99f, effect.damping));
+	} else if (effect.type == Sound::Effect::Convolution) {
+		if (changed) bus.convolver->reset();
+	}
+}
+
+//helper: apply all commands sent since the last callback:
+void apply_commands() {
+	Command command;
+	while (commands.pop(&command)) {
+		Voice *voice = nullptr;
+		switch (command.type) {
+			case Command::Play:
+				start_voice_playing(command);
+				break;
+			case Command::SetVolume:
+				if ((voice = command_voice(command)) && !voice->stopping) voice->volume.set(command.value, command.ramp);
+				break;
+			case Command::SetPan:
+				if ((voice = command_voice(command))) voice->pan.set(command.value, command.ramp);
+				break;
+			case Command::SetPosition:
+				if ((voice = command_voice(command))) voice->position.set(command.vec, command.ramp);
+				break;
+			case Command::SetHalfVolumeRadius:
+				if ((voice = command_voice(command))) voice->half_volume_radius.set(command.value, command.ramp);
+				break;
+			case Command::Stop:
+				if (!(voice = command_voice(command))) break;
+				if (voice->scheduled && voice->start > mix_clock) {
+					//(stopped before it started)
+					cancel_scheduled_voice(uint32_t(std::find(scheduled_voices.begin(), scheduled_voices.end(), command.voice) - scheduled_voices.begin()));
+				} else {
+					stop_voice(*voice, command.ramp);
+				}
+				break;
+			case Command::StopAll:
+				for (uint32_t a = 0; a < active_count; ++a) {
+					stop_voice(voices[active_voices[a]], command.ramp);
+				}
+				for (uint32_t s = 0; s < scheduled_voices.size(); /* later */) {
+					if (voices[scheduled_voices[s]].start > mix_clock) {
+						cancel_scheduled_voice(s);
+					} else {
+						stop_voice(voices[scheduled_voices[s]], command.ramp);
+						++s;
+					}
+				}
+				break;
+			case Command::SetGlobalVolume:
+				Sound::volume.set(command.value, command.ramp);
+				break;
+			case Command::SetListener:
+				Sound::listener.position.set(command.vec, command.ramp);
+				Sound::listener.right.set(command.vec2, command.ramp);
+				break;
+			case Command::SetListenerUp:
+				Sound::listener.up.set(command.vec, command.ramp);
+				break;
+			case Command::SetPriority:
+				if ((voice = command_voice(command))) voice->priority = command.value;
+				break;
+			case Command::SetBus:
+				if ((voice = command_voice(command))) voice->bus = command.bus;
+				break;
+			case Command::SetRate:
+				if ((voice = command_voice(command))) {
+					if (!voice->resampling) start_resampling(*voice);
+					voice->rate.set(std::max(0.0f, std::min(MAX_RATE, command.value)), command.ramp);
+				}
+				break;
+			case Command::SetVirtualization:
+				max_real_voices = std::min(command.voice, MAX_VOICES);
+				audibility_threshold = command.value;
+				break;
+			case Command::AddBus:
+				buses[command.bus].active = true;
+				buses[command.bus].parent = command.to_bus;
+				break;
+			case Command::SetBusEffect:
+				if (command.convolver) buses[command.bus].convolver = command.convolver;
+				set_bus_effect(buses[command.bus], command.slot, command.effect);
+				break;
+			case Command::SetBusVolume:
+				buses[command.bus].volume.set(command.value, command.ramp);
+				break;
+			case Command::SetBusSend:
+				buses[command.bus].send = (command.value == 0.0f ? -1U : command.to_bus);
+				buses[command.bus].send_level = command.value;
+				break;
+			case Command::SetDistanceLowPass:
+				low_pass_half_distance = command.value;
+				break;
+			case Command::SetHRTF:
+				hrtf_set = static_cast< HRTFSet const * >(command.data);
+				break;
+			case Command::SetHRTFBudget:
+				max_hrtf_voices = command.voice;
+				hrtf_cpu_fraction = command.value;
+				break;
+		}
+	}
+}
+
+//helper: step all of a voice's ramps by 'step' seconds:
+void step_voice_ramps(Voice &voice, float step) {
+	if (voice.is_3D) {
+		step_position_ramp(voice.position, step);
+		step_value_ramp(voice.half_volume_radius, step);
+	} else {
+		step_value_ramp(voice.pan, step);
+	}
+	step_value_ramp(voice.volume, step);
+	step_value_ramp(voice.rate, step);
+}
+
+//global values that affect every voice's gain:
+struct Globals {
+	float volume;
+	glm::vec3 position;
+	glm::vec3 right;
+	glm::vec3 up;
+};
+
+//helper: current global values (stepping their ramps by 'step' seconds afterward if 'advance' is true):
+Globals step_globals(float step, bool advance) {
+	Globals ret;
+	ret.volume = Sound::volume.value;
+	ret.position = Sound::listener.position.value;
+	ret.right = Sound::listener.right.value;
+	ret.up = Sound::listener.up.value;
+	if (advance) {
+		step_value_ramp(Sound::volume, step);
+		step_position_ramp(Sound::listener.position, step);
+		step_direction_ramp(Sound::listener.right, step);
+		step_direction_ramp(Sound::listener.up, step);
+	}
+	return ret;
+}
 
-		step_value_ramp(playing_sample.volume);
+//helper: the global values 'step' seconds from now (without changing them):
+Globals peek_globals(float step) {
+	Sound::Ramp< float > volume;
+	Sound::Ramp< glm::vec3 > position, right, up;
+	volume = Sound::volume;
+	position = Sound::listener.position;
+	right = Sound::listener.right;
+	up = Sound::listener.up;
+	step_value_ramp(volume, step);
+	step_position_ramp(position, step);
+	step_direction_ramp(right, step);
+	step_direction_ramp(up, step);
+	return Globals{ volume.value, position.value, right.value, up.value };
+}
 
-		//..and end of the mix period:
-		LR end_pan;
-		if (!(playing_sample.pan.value == playing_sample.pan.value)) {
+//helper: figure out the gains of some playing voices over the next 'samples' samples ('step' seconds), given global values at the start and end:
+// fills in the VoiceMix of each active position in slots[0, count) (or in [0, count) if slots is null).
+// If 'advance' is true, voices' ramps are stepped to the end of the block; otherwise, they are left unchanged (for looking ahead).
+void compute_gains(uint32_t const *slots, uint32_t count, Globals const &start, Globals const &end, float step, uint32_t samples, bool advance) {
+	//gather each voice's panning parameters at the start and end of the block:
+	uint32_t count_3D = 0;
+	uint32_t count_2D = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t a = (slots ? slots[i] : i);
+		Voice &voice = voices[active_voices[a]];
+		VoiceMix &mix = voice_mixes[a];
+
+		//(when looking ahead, step copies of the ramps instead)
+		Sound::Ramp< glm::vec3 > position_copy;
+		Sound::Ramp< float > half_volume_radius_copy, pan_copy, volume_copy, rate_copy;
+		Sound::Ramp< glm::vec3 > &position = (advance ? voice.position : (position_copy = voice.position));
+		Sound::Ramp< float > &half_volume_radius = (advance ? voice.half_volume_radius : (half_volume_radius_copy = voice.half_volume_radius));
+		Sound::Ramp< float > &pan = (advance ? voice.pan : (pan_copy = voice.pan));
+		Sound::Ramp< float > &volume = (advance ? voice.volume : (volume_copy = voice.volume));
+		Sound::Ramp< float > &rate = (advance ? voice.rate : (rate_copy = voice.rate));
+
+		if (voice.is_3D) {
 			//3D panning
-			compute_pan_from_listener_and_position(
-				end_position, end_right,
-				playing_sample.position.value,
-				playing_sample.half_volume_radius.value,
-				&end_pan.l, &end_pan.r);
+			uint32_t e = count_3D;
+			count_3D += 1;
+			spatial.x[e] = position.value.x;
+			spatial.y[e] = position.value.y;
+			spatial.z[e] = position.value.z;
+			spatial.half_radius[e] = half_volume_radius.value;
+
+			step_position_ramp(position, step);
+			step_value_ramp(half_volume_radius, step);
+
+			spatial.x[e + MAX_VOICES] = position.value.x;
+			spatial.y[e + MAX_VOICES] = position.value.y;
+			spatial.z[e + MAX_VOICES] = position.value.z;
+			spatial.half_radius[e + MAX_VOICES] = half_volume_radius.value;
+			mix.entry = e;
 		} else {
 			//2D panning
-			compute_pan_weights(playing_sample.pan.value, &end_pan.l, &end_pan.r);
+			count_2D += 1;
+			uint32_t e = MAX_VOICES - count_2D;
+			spatial.pan[e] = pan.value;
+
+			step_value_ramp(pan, step);
+
+			spatial.pan[e + MAX_VOICES] = pan.value;
+			mix.entry = e;
 		}
 
-		end_pan.l *= end_volume * playing_sample.volume.value;
-		end_pan.r *= end_volume * playing_sample.volume.value;
+		mix.start_volume = start.volume * volume.value;
+		step_value_ramp(volume, step);
+		mix.end_volume = end.volume * volume.value;
 
-		//figure out a step to add at each sample so that pan will move smoothly from start to end:
-		LR pan = start_pan;
-		LR pan_step;
-		pan_step.l = (end_pan.l - start_pan.l) / MIX_SAMPLES;
-		pan_step.r = (end_pan.r - start_pan.r) / MIX_SAMPLES;
+		mix.start_rate = rate.value;
+		step_value_ramp(rate, step);
+		mix.end_rate = rate.value;
+	}
+
+	//compute panning gains for every voice at once:
+	float listener_start[3] = { start.position.x, start.position.y, start.position.z };
+	float listener_start_right[3] = { start.right.x, start.right.y, start.right.z };
+	float listener_end[3] = { end.position.x, end.position.y, end.position.z };
+	float listener_end_right[3] = { end.right.x, end.right.y, end.right.z };
+	float listener_start_up[3] = { start.up.x, start.up.y, start.up.z };
+	float listener_end_up[3] = { end.up.x, end.up.y, end.up.z };
+	for (uint32_t half : { 0U, MAX_VOICES }) {
+		if (output_channels == 2) {
+			spatialize(
+				&spatial.x[half], &spatial.y[half], &spatial.z[half], &spatial.half_radius[half], count_3D,
+				(half == 0 ? listener_start : listener_end), (half == 0 ? listener_start_right : listener_end_right),
+				&spatial.gains[0][half], &spatial.gains[1][half]
+			);
+		} else {
+			float *gains[Sound::MAX_OUTPUT_CHANNELS];
+			for (uint32_t c = 0; c < output_channels; ++c) {
+				gains[c] = &spatial.gains[c][half];
+			}
+			vbap_spatialize(
+				&spatial.x[half], &spatial.y[half], &spatial.z[half], &spatial.half_radius[half], count_3D,
+				(half == 0 ? listener_start : listener_end), (half == 0 ? listener_start_right : listener_end_right),
+				(half == 0 ? listener_start_up : listener_end_up), output_layout, gains
+			);
+		}
+		//(2D voices play from the front left and right)
+		uint32_t first_2D = half + MAX_VOICES - count_2D;
+		equal_power_pan(&spatial.pan[first_2D], count_2D, &spatial.gains[0][first_2D], &spatial.gains[1][first_2D]);
+		for (uint32_t c = 2; c < output_channels; ++c) {
+			std::fill(&spatial.gains[c][first_2D], &spatial.gains[c][first_2D] + count_2D, 0.0f);
+		}
+	}
 
-		assert(playing_sample.i < playing_sample.data.size());
+	//figure out the gain of each voice over the block:
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t a = (slots ? slots[i] : i);
+		Voice &voice = voices[active_voices[a]];
+		VoiceMix &mix = voice_mixes[a];
 
-		for (uint32_t i = 0; i < MIX_SAMPLES; ++i) {
-			//mix one sample based on current pan values:
-			buffer[i].l += pan.l * playing_sample.data[playing_sample.i];
-			buffer[i].r += pan.r * playing_sample.data[playing_sample.i];
+		float loudness = 0.0f;
+		for (uint32_t c = 0; c < output_channels; ++c) {
+			//sample panning/volume at start and end of the mix period:
+			float start_pan = spatial.gains[c][mix.entry] * mix.start_volume;
+			float end_pan = spatial.gains[c][mix.entry + MAX_VOICES] * mix.end_volume;
 
-			//update position in sample:
-			playing_sample.i += 1;
-			if (playing_sample.i == playing_sample.data.size()) {
-				if (playing_sample.loop) {
-					playing_sample.i = 0;
+			mix.gain[c] = start_pan;
+			//figure out a step to add at each sample so that pan will move smoothly from start to end:
+			mix.gain_step[c] = (end_pan - start_pan) / samples;
+
+			float louder = std::max(start_pan, end_pan);
+			loudness = (c == 0 ? louder : std::max(loudness, louder));
+		}
+		mix.score = voice.priority * loudness;
+	}
+}
+
+//helper: has a voice finished playing?
+bool voice_finished(Voice const &voice) {
+	//(looping voices can end a block exactly at the end of their data; they wrap around at the start of the next one)
+	return (!voice.loop && voice.i >= voice.size && voice.stream_ended)
+	    || (voice.stopping && voice.volume.value == 0.0f);
+}
+
+//helper: a bus's mix buffer (interleaved output_channels; not for the master bus, which mixes straight into the output):
+float *bus_mix(uint32_t bus) {
+	assert(bus != Sound::MASTER_BUS && bus < Sound::MAX_BUSES);
+	return bus_mixes.data() + bus * MAX_MIX_SAMPLES * output_channels;
+}
+
+//helper: fold a surround mix down to stereo 'lr' (by fold_gains):
+void fold_to_stereo(float const *mix, uint32_t samples, float *lr) {
+	for (uint32_t s = 0; s < samples; ++s) {
+		float l = 0.0f, r = 0.0f;
+		for (uint32_t c = 0; c < output_channels; ++c) {
+			l += mix[output_channels * s + c] * fold_gains[c][0];
+			r += mix[output_channels * s + c] * fold_gains[c][1];
+		}
+		lr[2 * s] = l;
+		lr[2 * s + 1] = r;
+	}
+}
+
+//helper: add stereo 'lr' times 'gain' into a surround mix (by spread_gains):
+void spread_stereo(float const *lr, uint32_t samples, float gain, float *mix) {
+	for (uint32_t s = 0; s < samples; ++s) {
+		for (uint32_t c = 0; c < output_channels; ++c) {
+			mix[output_channels * s + c] += gain * (lr[2 * s] * spread_gains[c][0] + lr[2 * s + 1] * spread_gains[c][1]);
+		}
+	}
+}
+
+//helper: run each bus's effects and add it into its parent (and send) bus, ending with the master bus in 'buffer':
+void mix_buses(float *buffer, uint32_t samples) {
+	for (uint32_t b = Sound::MAX_BUSES - 1; b < Sound::MAX_BUSES; --b) {
+		Bus &bus = buses[b];
+		if (!bus.active) continue;
+		auto bus_start = std::chrono::steady_clock::now();
+
+		float *mix = (b == Sound::MASTER_BUS ? buffer : bus_mix(b));
+		for (uint32_t e = 0; e < Sound::MAX_BUS_EFFECTS; ++e) {
+			Sound::Effect const &effect = bus.effects[e];
+			if (effect.type == Sound::Effect::LowPass || effect.type == Sound::Effect::HighPass) {
+				biquad_channels(bus.biquads[e], bus.biquad_states[e], samples, output_channels, mix);
+			} else if (effect.type == Sound::Effect::Reverb) {
+				if (output_channels == 2) {
+					fdn_reverb(bus.reverb, effect.wet, samples, mix);
 				} else {
-					break;
+					//(reverberate the fold-down entirely wet, then add that to the dry mix)
+					fold_to_stereo(mix, samples, surround_fold);
+					fdn_reverb(bus.reverb, 1.0f, samples, surround_fold);
+					for (uint32_t s = 0; s < output_channels * samples; ++s) {
+						mix[s] *= 1.0f - effect.wet;
+					}
+					spread_stereo(surround_fold, samples, effect.wet, mix);
+				}
+			} else if (effect.type == Sound::Effect::Convolution) {
+				float const *input = mix;
+				if (output_channels != 2) {
+					fold_to_stereo(mix, samples, surround_fold);
+					input = surround_fold;
 				}
+				std::fill(convolution_output, convolution_output + 2 * samples, 0.0f);
+				bus.convolver->process(*effect.impulse_response->filter, input, samples, convolution_output);
+				for (uint32_t s = 0; s < output_channels * samples; ++s) {
+					mix[s] *= 1.0f - effect.wet;
+				}
+				if (output_channels == 2) mix_stereo(convolution_output, samples, effect.wet, 0.0f, mix);
+				else spread_stereo(convolution_output, samples, effect.wet, mix);
+			}
+		}
+
+		if (b != Sound::MASTER_BUS) {
+			float *parent = (bus.parent == Sound::MASTER_BUS ? buffer : bus_mix(bus.parent));
+			float *send = (bus.send == -1U ? nullptr : (bus.send == Sound::MASTER_BUS ? buffer : bus_mix(bus.send)));
+			//(volume ramps step with the same period as voices' ramps, so they sound the same whatever the block size)
+			for (uint32_t mixed = 0; mixed < samples; mixed += CONTROL_SAMPLES) {
+				uint32_t count = std::min(CONTROL_SAMPLES, samples - mixed);
+				float gain = bus.volume.value;
+				step_value_ramp(bus.volume, float(count) / float(AUDIO_RATE));
+				float gain_step = (bus.volume.value - gain) / count;
+				float const *from = mix + output_channels * mixed;
+				mix_channels(from, count, output_channels, gain, gain_step, parent + output_channels * mixed);
+				if (send) mix_channels(from, count, output_channels, gain * bus.send_level, gain_step * bus.send_level, send + output_channels * mixed);
 			}
+		}
+
+		auto bus_end = std::chrono::steady_clock::now();
+		stats_add(stats.bus_nanoseconds[b], uint64_t(std::chrono::duration_cast< std::chrono::nanoseconds >(bus_end - bus_start).count()));
+	}
+}
+
+//helper: the HRIR pair in hrtf_set nearest the direction from the listener to 'position':
+ConvolutionFilter const &nearest_hrir(glm::vec3 const &position, Globals const &globals) {
+	assert(hrtf_set && !hrtf_set->directions.empty());
+	//(listener's axes, with up made perpendicular to right in case their ramps disagree)
+	glm::vec3 up = globals.up - globals.right * glm::dot(globals.up, globals.right);
+	glm::vec3 forward = glm::cross(up, globals.right);
+	glm::vec3 to = position - globals.position;
+	glm::vec3 direction = glm::vec3(glm::dot(to, globals.right), glm::dot(to, forward), glm::dot(to, up));
+
+	uint32_t best = 0;
+	float best_dot = -std::numeric_limits< float >::infinity();
+	for (uint32_t d = 0; d < hrtf_set->directions.size(); ++d) {
+		float dot = glm::dot(direction, hrtf_set->directions[d]);
+		if (dot > best_dot) {
+			best = d;
+			best_dot = dot;
+		}
+	}
+	return hrtf_set->filters[best];
+}
+
+//helper: mix 'samples' samples (any block size) into 'buffer':
+// Which voices are real (see Sound::set_virtualization) is decided once for the whole block, from their gains at its start and end.
+// Real voices are then mixed in CONTROL_SAMPLES pieces, stepping their ramps after each, so they follow the same path whatever the block size;
+// virtual voices just jump ahead.
+void mix_block(float *buffer, uint32_t samples) {
+	float const step = float(samples) / float(AUDIO_RATE); //(seconds of audio in this block, for stepping ramps)
+
+	//zero the output buffer and bus buffers:
+	std::fill(buffer, buffer + output_channels * samples, 0.0f);
+	for (uint32_t b = 1; b < Sound::MAX_BUSES; ++b) {
+		if (buses[b].active) std::fill(bus_mix(b), bus_mix(b) + output_channels * samples, 0.0f);
+	}
+
+	//figure out how loud each playing sample will be over the block (without changing anything yet):
+	compute_gains(nullptr, active_count, step_globals(0.0f, false), peek_globals(step), step, samples, false);
+
+	//(voices on quieter buses are less audible)
+	float bus_gains[Sound::MAX_BUSES];
+	for (uint32_t b = 0; b < Sound::MAX_BUSES; ++b) {
+		bus_gains[b] = (b == Sound::MASTER_BUS ? 1.0f : buses[b].volume.value * bus_gains[buses[b].parent]);
+	}
 
-			//update pan values:
-			pan.l += pan_step.l;
-			pan.r += pan_step.r;
+	uint32_t audible_count = 0;
+	for (uint32_t a = 0; a < active_count; ++a) {
+		VoiceMix &mix = voice_mixes[a];
+		mix.real = false;
+		mix.finished = false;
+		mix.hrtf = false;
+		float bus_gain = bus_gains[voices[active_voices[a]].bus];
+		mix.score *= bus_gain;
+		float loudest = std::max(mix.gain[0], mix.gain[0] + samples * mix.gain_step[0]);
+		for (uint32_t c = 1; c < output_channels; ++c) {
+			loudest = std::max(loudest, std::max(mix.gain[c], mix.gain[c] + samples * mix.gain_step[c]));
 		}
+		if (bus_gain * loudest >= audibility_threshold) {
+			audible[audible_count] = a;
+			audible_count += 1;
+		}
+	}
 
-		if (playing_sample.i >= playing_sample.data.size()
-		 || (playing_sample.stopping && playing_sample.volume.value == 0.0f)) { //sample has finished
-		 	playing_sample.stopped = true;
-			//erase from list:
-			auto old = si;
-			++si;
-			playing_samples.erase(old);
+	//keep only the highest-scoring audible voices:
+	if (audible_count > max_real_voices) {
+		std::nth_element(audible.begin(), audible.begin() + max_real_voices, audible.begin() + audible_count,
+			[](uint32_t a, uint32_t b) { return voice_mixes[a].score > voice_mixes[b].score; });
+		audible_count = max_real_voices;
+	}
+	for (uint32_t i = 0; i < audible_count; ++i) {
+		voice_mixes[audible[i]].real = true;
+	}
+
+	//render the highest-scoring real 3D voices binaurally (see Sound::set_hrtf_budget; only for stereo output):
+	if (hrtf_set && output_channels == 2) {
+		uint32_t candidate_count = 0;
+		for (uint32_t i = 0; i < audible_count; ++i) {
+			if (!voices[active_voices[audible[i]]].is_3D) continue;
+			hrtf_candidates[candidate_count] = audible[i];
+			candidate_count += 1;
+		}
+		uint32_t limit = max_hrtf_voices;
+		if (hrtf_cpu_fraction < 1.0f && hrtf_nanoseconds_per_sample > 0.0) {
+			//(as many voices as fit in the budget, going by how long they've been taking)
+			double budget = hrtf_cpu_fraction * 1e9 / double(AUDIO_RATE);
+			limit = uint32_t(std::min(double(limit), budget / hrtf_nanoseconds_per_sample));
+		}
+		if (candidate_count > limit) {
+			std::nth_element(hrtf_candidates.begin(), hrtf_candidates.begin() + limit, hrtf_candidates.begin() + candidate_count,
+				[](uint32_t a, uint32_t b) { return voice_mixes[a].score > voice_mixes[b].score; });
+			candidate_count = limit;
+		}
+		for (uint32_t i = 0; i < candidate_count; ++i) {
+			voice_mixes[hrtf_candidates[i]].hrtf = true;
+		}
+	}
+	stats.active_voices.store(active_count, std::memory_order_relaxed);
+	stats.real_voices.store(audible_count, std::memory_order_relaxed);
+	stats_max(stats.max_active_voices, active_count);
+	stats_max(stats.max_real_voices, audible_count);
+
+	//advance virtual voices over the whole block, and list the voices to mix (real ones, and ones fading out as they become virtual):
+	uint32_t mixing_count = 0;
+	for (uint32_t a = 0; a < active_count; ++a) {
+		Voice &voice = voices[active_voices[a]];
+		VoiceMix &mix = voice_mixes[a];
+
+		assert(voice.i < voice.size || voice.loop || voice.stream != -1U);
+
+		if (mix.real || voice.real) {
+			mixing[mixing_count] = a;
+			mixing_count += 1;
+
+			//voices crossfade between panned and binaural over the block (except when fading in from silence anyway):
+			bool had_hrtf = (voice.hrtf != -1U);
+			if (!mix.real && had_hrtf) mix.hrtf = true; //(fade out as it was)
+			if (mix.hrtf && !had_hrtf) {
+				if (!free_hrtf_convolvers.empty()) {
+					voice.hrtf = free_hrtf_convolvers.back();
+					free_hrtf_convolvers.pop_back();
+					hrtf_convolvers[voice.hrtf].reset();
+				} else {
+					mix.hrtf = false; //(the last block's binaural voices haven't all faded out yet)
+				}
+			}
+			mix.hrtf_start = (had_hrtf || (mix.hrtf && (voice.fresh || !voice.real)) ? 1.0f : 0.0f);
+			mix.hrtf_end = (mix.hrtf ? 1.0f : 0.0f);
+			continue;
+		}
+		step_voice_ramps(voice, step);
+		if (voice.resampling) {
+			resample_voice(voice, samples - voice.delay, mix.start_rate, mix.end_rate, false);
+		} else {
+			advance_voice(voice, samples - voice.delay);
+		}
+		voice.fresh = false;
+		voice.delay = 0;
+		mix.finished = voice_finished(voice);
+	}
+
+	//add audio from each voice being mixed into the buffer:
+	uint64_t hrtf_nanoseconds = 0;
+	uint32_t hrtf_samples = 0;
+	for (uint32_t mixed = 0; mixed < samples; mixed += CONTROL_SAMPLES) {
+		uint32_t count = std::min(CONTROL_SAMPLES, samples - mixed);
+		float control_step = float(count) / float(AUDIO_RATE);
+		Globals start = step_globals(control_step, true);
+		Globals end = step_globals(0.0f, false);
+		compute_gains(mixing.data(), mixing_count, start, end, control_step, count, true);
+
+		//(voices changing between real and virtual fade over the whole block)
+		float fade_start = float(mixed) / float(samples);
+		float fade_end = float(mixed + count) / float(samples);
+
+		for (uint32_t i = 0; i < mixing_count; ++i) {
+			Voice &voice = voices[active_voices[mixing[i]]];
+			VoiceMix &mix = voice_mixes[mixing[i]];
+			if (mix.finished) continue;
+
+			float fade_from = 1.0f, fade_to = 1.0f;
+			if (!voice.real && !voice.fresh) {
+				//becoming real, so fade in from silence:
+				fade_from = fade_start;
+				fade_to = fade_end;
+			} else if (!mix.real) {
+				//becoming virtual, so fade out to silence:
+				fade_from = 1.0f - fade_start;
+				fade_to = 1.0f - fade_end;
+			}
+			float gain[Sound::MAX_OUTPUT_CHANNELS], gain_step[Sound::MAX_OUTPUT_CHANNELS];
+			for (uint32_t c = 0; c < output_channels; ++c) {
+				gain[c] = mix.gain[c] * fade_from;
+				gain_step[c] = ((mix.gain[c] + count * mix.gain_step[c]) * fade_to - gain[c]) / count;
+			}
+
+			//scheduled voices may start partway through the block:
+			uint32_t offset = 0;
+			if (voice.delay >= count) {
+				voice.delay -= count;
+				continue;
+			} else if (voice.delay > 0) {
+				offset = voice.delay;
+				voice.delay = 0;
+				for (uint32_t c = 0; c < output_channels; ++c) {
+					gain[c] += offset * gain_step[c];
+				}
+			}
+
+			float *piece = (voice.bus == Sound::MASTER_BUS ? buffer : bus_mix(voice.bus)) + output_channels * mixed;
+			float *out = piece + output_channels * offset;
+			uint32_t n = count - offset;
+			bool low_pass = (voice.is_3D && low_pass_half_distance != std::numeric_limits< float >::infinity());
+
+			if (voice.hrtf == -1U && !low_pass && !voice.resampling) {
+				mix_voice(voice, n, gain, gain_step, out);
+				mix.finished = voice_finished(voice);
+				continue;
+			}
+			auto voice_start = std::chrono::steady_clock::now();
+
+			float *samples_in = voice_buffer;
+			if (voice.resampling) {
+				resample_voice(voice, n, mix.start_rate, mix.end_rate, true);
+				samples_in = resample_output;
+			} else {
+				read_voice(voice, voice_buffer, n);
+			}
+			if (low_pass) {
+				//distance low-pass (see Sound::set_distance_low_pass):
+				float distance = glm::length(voice.position.value - Sound::listener.position.value);
+				float coefficient = one_pole_coefficient(20000.0f / (1.0f + distance / low_pass_half_distance), float(AUDIO_RATE));
+				one_pole_low_pass(samples_in, n, coefficient, &voice.low_pass_state);
+			}
+
+			if (voice.hrtf == -1U) {
+				mix_mono_to_channels(samples_in, n, output_channels, gain, gain_step, out);
+			} else {
+				assert(output_channels == 2);
+				float l = gain[0], r = gain[1];
+				float l_step = gain_step[0], r_step = gain_step[1];
+				//split between panned and binaural (by mix.hrtf_start/end, over the whole block):
+				float share_from = mix.hrtf_start + (mix.hrtf_end - mix.hrtf_start) * (float(mixed + offset) / float(samples));
+				float share_to = mix.hrtf_start + (mix.hrtf_end - mix.hrtf_start) * fade_end;
+				float l_to = l + n * l_step;
+				float r_to = r + n * r_step;
+				if (share_from < 1.0f || share_to < 1.0f) {
+					mix_mono_to_stereo(samples_in, n, l * (1.0f - share_from), r * (1.0f - share_from),
+						(l_to * (1.0f - share_to) - l * (1.0f - share_from)) / n, (r_to * (1.0f - share_to) - r * (1.0f - share_from)) / n, out);
+				}
+				//(the HRIRs do the panning, so the binaural part gets the panned gains' combined power)
+				float gain = std::sqrt(l * l + r * r) * share_from;
+				float gain_step = (std::sqrt(l_to * l_to + r_to * r_to) * share_to - gain) / n;
+				std::fill(hrtf_input, hrtf_input + 2 * offset, 0.0f);
+				for (uint32_t s = 0; s < n; ++s) {
+					hrtf_input[2 * (offset + s)] = samples_in[s] * gain;
+					hrtf_input[2 * (offset + s) + 1] = 0.0f;
+					gain += gain_step;
+				}
+				hrtf_convolvers[voice.hrtf].process(nearest_hrir(voice.position.value, end), hrtf_input, count, piece);
+				hrtf_samples += count;
+			}
+
+			if (voice.hrtf != -1U) {
+				auto voice_end = std::chrono::steady_clock::now();
+				hrtf_nanoseconds += uint64_t(std::chrono::duration_cast< std::chrono::nanoseconds >(voice_end - voice_start).count());
+			}
+			mix.finished = voice_finished(voice);
+		}
+	}
+
+	uint32_t hrtf_count = 0;
+	for (uint32_t i = 0; i < mixing_count; ++i) {
+		Voice &voice = voices[active_voices[mixing[i]]];
+		VoiceMix const &mix = voice_mixes[mixing[i]];
+		voice.real = mix.real;
+		voice.fresh = false;
+		if (voice.hrtf == -1U) continue;
+		if (mix.hrtf && mix.real) {
+			hrtf_count += 1;
 		} else {
-			++si;
+			//(finished fading to panned or to silence)
+			free_hrtf_convolvers.emplace_back(voice.hrtf);
+			voice.hrtf = -1U;
 		}
 	}
 
+	//keep track of the time binaural voices take (see hrtf_cpu_fraction):
+	if (hrtf_samples > 0) {
+		double per_sample = double(hrtf_nanoseconds) / double(hrtf_samples);
+		hrtf_nanoseconds_per_sample = (hrtf_nanoseconds_per_sample == 0.0 ? per_sample : 0.9 * hrtf_nanoseconds_per_sample + 0.1 * per_sample);
+	}
+	stats.hrtf_voices.store(hrtf_count, std::memory_order_relaxed);
+	stats_max(stats.max_hrtf_voices, hrtf_count);
+	stats_add(stats.hrtf_nanoseconds, hrtf_nanoseconds);
+
+	mix_buses(buffer, samples);
+
+	//return finished voices to the pool:
+	// (in reverse, so the voice finish_voice moves into each slot has already been checked)
+	for (uint32_t a = active_count - 1; a < active_count; --a) {
+		if (voice_mixes[a].finished) finish_voice(active_voices[a]);
+	}
+}
+
+//The audio callback -- invoked by SDL when it needs more sound to play:
+void mix_audio(void *, Uint8 *buffer_, int len) {
+	auto callback_start = std::chrono::steady_clock::now();
+
+	assert(buffer_); //should always have some audio buffer
+
+	uint32_t const frame = uint32_t(output_channels * sizeof(float)); //(bytes per sample of interleaved output)
+	assert(len % frame == 0 && len <= int(MAX_MIX_SAMPLES * frame)); //should always have a whole number of samples, within the block size limit
+	float *buffer = reinterpret_cast< float * >(buffer_);
+	uint32_t const samples = uint32_t(len / frame);
+
+	//a callback that starts more than two blocks after the previous one probably means the device ran dry:
+	if (!offline && previous_callback != std::chrono::steady_clock::time_point()
+	 && callback_start - previous_callback > std::chrono::duration< float >(2.0f * samples / float(AUDIO_RATE))) {
+		stats_add(stats.late, uint64_t(1));
+	}
+	previous_callback = callback_start;
+
+	//bring voice state up to date with the game thread:
+	apply_commands();
+	start_scheduled_voices(samples);
+
+	mix_block(buffer, samples);
+
+	mix_clock += samples;
+	audio_clock.store(mix_clock, std::memory_order_relaxed);
+
+	//record output level and callback duration:
+	float peak = 0.0f;
+	for (uint32_t s = 0; s < output_channels * samples; ++s) {
+		peak = std::max(peak, std::abs(buffer[s]));
+	}
+	stats.last_peak.store(peak, std::memory_order_relaxed);
+	stats_max(stats.peak, peak);
+
+	uint32_t microseconds = uint32_t(std::chrono::duration_cast< std::chrono::microseconds >(std::chrono::steady_clock::now() - callback_start).count());
+	uint32_t bin = 0;
+	while (bin + 1 < Sound::Stats::HISTOGRAM_BINS && (1U << bin) <= microseconds) {
+		bin += 1;
+	}
+	stats_add(stats.histogram[bin], uint64_t(1));
+	stats_add(stats.callbacks, uint64_t(1));
+	stats.block_samples.store(samples, std::memory_order_relaxed);
+	if (uint64_t(microseconds) * AUDIO_RATE > 1000000ULL * samples) {
+		stats_add(stats.over_budget, uint64_t(1));
+	}
+	stats_max(stats.max_microseconds, microseconds);
+
 	/*//DEBUG: report output power:
 	float max_power = 0.0f;
-	for (uint32_t s = 0; s < MIX_SAMPLES; ++s) {
-		max_power = std::max(max_power, (buffer[s].l * buffer[s].l + buffer[s].r * buffer[s].r));
+	for (uint32_t s = 0; s < samples; ++s) {
+		float power = 0.0f;
+		for (uint32_t c = 0; c < output_channels; ++c) {
+			power += buffer[output_channels * s + c] * buffer[output_channels * s + c];
+		}
+		max_power = std::max(max_power, power);
 	}
-	std::cout << "Max Power: " << std::sqrt(max_power) << "; playing samples: " << playing_samples.size() << std::endl; //DEBUG
+	std::cout << "Max Power: " << std::sqrt(max_power) << "; playing samples: " << active_count << std::endl; //DEBUG
 	*/
 
 }
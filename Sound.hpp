@@ -1,30 +1,99 @@
 #pragma once
 
+#include "ByteSpan.hpp"
+#include "MappedFile.hpp"
+
 #include <glm/glm.hpp>
 
 #include <memory>
 #include <vector>
 #include <string>
 #include <cmath>
+#include <cstdint>
 
 //Game audio system. Simplified from f18-base3.
 //Uses 48kHz sampling rate.
 
+struct ConvolutionFilter; //(see convolve.hpp)
+
 namespace Sound {
 
 //Sample objects hold mono (one-channel) audio.
-struct Sample {
+//Playbacks read straight from their Sample, so it must outlive them -- unless it is owned by a std::shared_ptr
+// (e.g., from Sound::load_sample), in which case each playback keeps it alive until it finishes.
+struct Sample : std::enable_shared_from_this< Sample > {
+	//Samples can be kept in memory in a more compact form, at some cost in quality and mixing time:
+	// (run bench-mix to see the mixing cost of each)
+	enum Encoding : uint8_t {
+		Float, //32-bit floating point (4 bytes per sample; the default)
+		Int16, //16-bit integer (2 bytes per sample)
+		ADPCM, //IMA ADPCM (4.5 bits per sample -- see ima_adpcm.hpp; good for sound effects, noisy on pure tones)
+	};
+
 	//Load from a '.wav' or '.opus' file.
 	//  will warn and convert if sound is not already 48kHz mono:
-	Sample(std::string const &filename);
+	Sample(std::string const &filename, Encoding encoding = Float);
+
+	//Load from '.wav' or '.opus' file contents already in memory (e.g., an embedded asset):
+	//  'name' is used to determine the file type (by extension) and in messages.
+	Sample(ByteSpan const &bytes, std::string const &name, Encoding encoding = Float);
 	
 	//Directly supply an audio buffer:
 	Sample(std::vector< float > const &data);
 
+	//Stream an '.opus' file during playback instead of decoding it all now (good for music and ambience):
+	//  only the first STREAM_PREFIX seconds are decoded up front (so playback can start instantly);
+	//  the rest is decoded in the background into a small per-voice buffer (see OpusStream.hpp).
+	struct Stream { };
+	Sample(std::string const &filename, Stream);
+	//  (streaming from memory reads directly from 'bytes', so they must outlive the Sample)
+	Sample(ByteSpan const &bytes, std::string const &name, Stream);
+	static constexpr float const STREAM_PREFIX = 0.25f;
+
 	//sample data is stored as 48kHz, mono, floating-point:
+	// (for streamed samples, this is just the beginning of the sample)
 	std::vector< float > data;
+
+	//...except for samples memory-mapped from the decoded audio cache (see AudioCache.hpp)
+	// or from a '.wav' file already in that format (see map_wav in load_wav.hpp),
+	// which leave 'data' empty and refer to samples in 'mapped' instead:
+	std::shared_ptr< MappedFile const > mapped;
+	float const *mapped_samples = nullptr;
+	size_t mapped_count = 0;
+
+	//...except for samples that have been converted to another encoding, which leave 'data' empty
+	// and store their samples in 'data_int16' or 'data_adpcm' instead:
+	Encoding encoding = Float;
+	std::vector< int16_t > data_int16;
+	std::vector< uint8_t > data_adpcm;
+	size_t adpcm_count = 0; //(number of samples in 'data_adpcm')
+
+	//convert a Float sample to another encoding (reports the memory saved):
+	// (streamed samples always stay Float, since their data is just the start of the sample)
+	void convert(Encoding new_encoding);
+
+	//the samples, wherever they are stored:
+	// (samples() is only valid for Float samples)
+	float const *samples() const { return mapped ? mapped_samples : data.data(); }
+	size_t size() const;
+	//memory used by the samples:
+	size_t bytes() const;
+
+	//streamed samples also remember where the rest of the audio comes from:
+	bool streamed = false;
+	std::string stream_filename; //file to stream from, unless stream_bytes is set (also used as the name in messages)
+	ByteSpan stream_bytes; //memory to stream from (samples loaded from memory; stream_filename is then just a name)
 };
 
+//Shared samples -- so a file used in several places (e.g., a sound effect played by many modes) is decoded and stored once:
+// load_sample returns the Sample for 'filename' in 'encoding', loading it only if nothing still holds it from an earlier call
+// (files are matched by the 'filename' string itself, so use the same path -- e.g., from data_path -- everywhere).
+// Shared samples are immutable (each playback's bus and priority are set on its PlayingSample, not on the Sample);
+// they are freed once the last pointer is dropped and the last playback finishes.
+// Safe to call from several threads at once: a request for a file that is already loading waits for that load, rather than repeating it.
+// (throws on error, as Sample's constructor does)
+std::shared_ptr< Sample const > load_sample(std::string const &filename, Sample::Encoding encoding = Sample::Float);
+
 //Ramp<> manages values that should be smoothly interpolated
 //  to a target over a certain amount of time:
 template< typename T >
@@ -48,9 +117,9 @@ struct Ramp {
 	float ramp = 0.0f;
 };
 
-// 'PlayingSample' objects book-keep samples that are currently playing:
+// 'PlayingSample' objects are handles to samples that are currently playing:
 struct PlayingSample {
-	//change the panning or volume of a playing sample (and do proper locking);
+	//change the panning or volume of a playing sample (by sending a command to the audio thread);
 	// value will change over 'ramp' seconds to avoid creating audible artifacts:
 	void set_volume(float new_volume, float ramp = 1.0f / 60.0f);
 	//set the panning of a sample (use only on samples in "2D" mode; no effect on "3D" samples):
@@ -60,31 +129,36 @@ struct PlayingSample {
 	//set the half-volume radius (use only on "3D" playing sounds):
 	void set_half_volume_radius(float new_radius, float ramp = 1.0f / 60.0f);
 
+	//set playback rate (1 == normal; 2 == twice as fast and an octave higher; clamped to [0,4]) -- e.g., for pitch variation or Doppler:
+	// (the sample is resampled as it plays; for a sample that should start at another rate, call this right after play())
+	void set_rate(float new_rate, float ramp = 1.0f / 60.0f);
+
+	//set playback priority -- when more samples are audible than can be mixed, higher-priority ones are kept (see set_virtualization):
+	// (playbacks start at priority 1; for a sample that should start at another priority, call this right after play())
+	void set_priority(float new_priority);
+
+	//move playback to another bus (see Sound::add_bus):
+	// (playbacks start on MASTER_BUS; for a sample that should play on another bus from the start, call this right after play())
+	void set_bus(uint32_t new_bus);
+
 	//'stop' will fade sample out over 'ramp' seconds and then remove it from the active samples:
 	void stop(float ramp = 1.0f / 60.0f);
 
+	//was playback stopped (either by running out of sample, or by stop())?
+	// (becomes true during the Sound::update() or play*() call after the audio thread finishes the sample)
+	bool stopped() const;
+
 	//internals:
-	//NOTE: PlayingSample is used in a separate thread; so setting these values directly
-	// may result in bad results. Instead, use the functions above, which perform locking!
-	std::vector< float > const &data; //reference to sample data being played
-	uint32_t i = 0; //next data value to read
-	bool loop = false; //should playback loop after data runs out?
-	bool stopping = false; //is playing stopping?
-	bool stopped = false; //was playback stopped (either by running out of sample, or by stop())?
-
-	Ramp< float > volume = Ramp< float >(1.0f);
-
-	//2D playback panning control: ('NaN' if sound played in 3D mode)
-	Ramp< float > pan = Ramp< float >(std::numeric_limits< float >::quiet_NaN());
-
-	//3D playback panning control: ('NaN' if sound played in 2D mode)
-	Ramp< glm::vec3 > position = Ramp< glm::vec3 >(std::numeric_limits< float >::quiet_NaN());
-	Ramp< float > half_volume_radius = std::numeric_limits< float >::quiet_NaN();
-
-	PlayingSample(Sample const &sample_, float volume_, float pan_, bool loop_)
-		: data(sample_.data), loop(loop_), volume(volume_), pan(pan_) { }
-	PlayingSample(Sample const &sample_, float volume_, glm::vec3 const &position_, float half_volume_radius_, bool loop_)
-		: data(sample_.data), loop(loop_), volume(volume_), position(position_), half_volume_radius(half_volume_radius_) { }
+	//Playback state lives in a 'voice' in a fixed-size pool owned by the audio thread.
+	//Voices are reused, so the handle also records which use ('generation') of the voice it refers to;
+	// once that playback finishes, the handle is stale and the functions above do nothing.
+	//(Dropping the handle does not stop playback.)
+	uint32_t const voice = -1U; //index in the voice pool (-1U if no voice was available)
+	uint32_t const generation = 0;
+	bool const is_3D = false; //was this sample played with a position (rather than a pan)?
+
+	PlayingSample(uint32_t voice_, uint32_t generation_, bool is_3D_)
+		: voice(voice_), generation(generation_), is_3D(is_3D_) { }
 };
 
 // ------- global functions -------
@@ -93,6 +167,47 @@ void init(); //call Sound::init() from main.cpp before using any member function
 
 void shutdown(); //call Sound::shutdown() from main.cpp to gracefully(-ish) exit
 
+void update(); //call Sound::update() once per frame from main.cpp (forwards any commands that didn't fit in the command queue)
+
+//Audio is mixed in blocks of a power-of-two number of samples, between MIN_BLOCK_SAMPLES and MAX_BLOCK_SAMPLES:
+// smaller blocks mean lower output latency (commands also take effect sooner), but leave the audio thread less slack
+// before a delay makes output drop out. Ramps (e.g., PlayingSample::set_volume's) take the same time whatever the block size.
+constexpr uint32_t const MIN_BLOCK_SAMPLES = 128; //~2.7ms
+constexpr uint32_t const DEFAULT_BLOCK_SAMPLES = 1024; //~21ms
+constexpr uint32_t const MAX_BLOCK_SAMPLES = 4096; //~85ms
+
+//set the block size (call before Sound::init(), or later to reopen the audio device -- with a short gap in output):
+// 'samples' is rounded up to a power of two in range.
+// If 'adaptive' is set, 'samples' is just the smallest size used: Sound::update() doubles the block size
+// after the audio callback overruns or is delayed, and halves it again after a while with plenty of headroom.
+// (If the device won't reopen with a new size, it is reopened with the previous one and adaptive mode is turned off.)
+void set_block_samples(uint32_t samples, bool adaptive = false);
+uint32_t get_block_samples(); //(current block size)
+
+//Output channels -- stereo, or surround for devices that have it:
+// 2 (left, right), 4 (front left, front right, back left, back right),
+// 6 (5.1: front left, front right, center, LFE, back left, back right), or
+// 8 (7.1: as 5.1, then side left, side right) -- interleaved in that (SDL's) order.
+//"3D" samples are panned between the pair of speakers around their direction (vector-base amplitude panning),
+// blending toward all speakers as they move overhead or underfoot; 2D samples play from the front left and right.
+//HRTF rendering (see load_hrtf) is for headphones, so only happens with stereo output.
+//Reverb and Convolution effects on surround output hear a stereo fold-down, and spread their output over the left and right speakers.
+constexpr uint32_t const MAX_OUTPUT_CHANNELS = 8;
+//set the channel count (call before Sound::init()); 0 (the default) uses the default device's count if it is one of those above, otherwise stereo:
+void set_output_channels(uint32_t channels);
+uint32_t get_output_channels(); //(channel count being mixed)
+
+//Offline rendering drives the mixer directly, with no audio device (for benchmarks and repeatable tests; see render-audio.cpp):
+// call Sound::init_offline() instead of Sound::init(), then call Sound::render() (from the game thread) for each block of audio:
+// it applies the commands queued since the last call (just like the audio callback) and mixes the next
+// 'samples' (at most MAX_BLOCK_SAMPLES) frames of 48kHz audio into 'out' ('channels' * samples floats, interleaved as above).
+void init_offline(uint32_t channels = 2);
+void render(float *out, uint32_t samples = DEFAULT_BLOCK_SAMPLES);
+
+//NOTE: the functions below (and the PlayingSample / Listener member functions) never block on the audio thread;
+// they queue commands that mix_audio applies at the start of its next callback.
+// They must all be called from the same thread (the game thread).
+
 //Call 'Sound::play' to play a sample once.
 //  if you hang on to the return value, you can change the panning, volume, or stop playback early.
 std::shared_ptr< PlayingSample > play(
@@ -123,26 +238,165 @@ std::shared_ptr< PlayingSample > loop_3D(
 	float half_volume_radius = std::numeric_limits< float >::infinity()
 );
 
+//The audio clock counts samples (at 48kHz) mixed since Sound::init(); it never goes backward, even when the block size changes.
+// get_audio_clock() is the time of the first sample of the next block to be mixed, so it advances a whole block at a time:
+// to keep events evenly spaced, compute their times from a fixed starting point (e.g., beat n at start + n * samples_per_beat)
+// rather than from each new reading.
+uint64_t get_audio_clock();
+
+//The '_at' versions of the play functions start playback at exactly audio clock time 'when' (e.g., for music or rhythm
+// events), rather than at the start of the next block. Queue events a little ahead of time -- say, everything in the next
+// 100ms each frame -- so they reach the audio thread before their block is mixed; ones that arrive late start right away
+// (and are counted in Stats::late_starts). Each waiting playback holds a voice, so don't queue a whole song at once.
+// (stopping a playback before it starts cancels it)
+std::shared_ptr< PlayingSample > play_at(Sample const &sample, uint64_t when, float volume = 1.0f, float pan = 0.0f);
+std::shared_ptr< PlayingSample > play_3D_at(Sample const &sample, uint64_t when, float volume, glm::vec3 const &position, float half_volume_radius = std::numeric_limits< float >::infinity());
+std::shared_ptr< PlayingSample > loop_at(Sample const &sample, uint64_t when, float volume = 1.0f, float pan = 0.0f);
+std::shared_ptr< PlayingSample > loop_3D_at(Sample const &sample, uint64_t when, float volume, glm::vec3 const &position, float half_volume_radius = std::numeric_limits< float >::infinity());
+
 //Listener controls the panning of "3D" samples (ones played using the "position" version of the play functions):
 struct Listener {
 	void set_position_right(glm::vec3 const &new_position, glm::vec3 const &new_right, float ramp = 1.0f / 60.0f);
+	//(HRTF rendering also needs to know which way is up -- see Sound::load_hrtf; otherwise, up stays +z)
+	void set_position_right_up(glm::vec3 const &new_position, glm::vec3 const &new_right, glm::vec3 const &new_up, float ramp = 1.0f / 60.0f);
 
-	//internals:
+	//internals (owned by the audio thread):
 	Ramp< glm::vec3 > position = Ramp< glm::vec3 >(0.0f); //listener's location
 	Ramp< glm::vec3 > right = Ramp< glm::vec3 >(1.0f, 0.0f, 0.0f); //unit vector pointing to listener's right
+	Ramp< glm::vec3 > up = Ramp< glm::vec3 >(0.0f, 0.0f, 1.0f); //unit vector pointing to listener's up
 };
 extern struct Listener listener;
 
+//Voice virtualization -- bounds mixing cost when many samples are playing:
+// each audio block, only the (at most) 'max_real_voices' playing samples with the highest priority x gain
+// among those with gain of at least 'audibility_threshold' are mixed; the others are "virtual":
+// they keep their playback position up to date but cost almost nothing. Voices fade in when they become real.
+// (defaults: 256 real voices, threshold 0.001 (-60dB))
+void set_virtualization(uint32_t max_real_voices, float audibility_threshold);
+
+//HRTF rendering -- makes "3D" samples seem to come from their direction (including above, below, and behind) over headphones,
+// by filtering each through the pair of head-related impulse responses (HRIRs) measured nearest that direction.
+//It costs much more than panning, so only the highest-scoring real 3D samples get it (see set_hrtf_budget);
+// the rest are panned, and samples crossfade between the two as they gain or lose a place.
+//load_hrtf loads a set of HRIRs (replacing any earlier set; until a set is loaded, everything is panned) from a text file of lines:
+//  <azimuth> <elevation> <left.wav> <right.wav>
+// giving the direction in degrees (azimuth clockwise from straight ahead, so 90 is to the right; elevation up from level)
+// and each ear's response as a mono '.wav' file (relative to the set's file; cut short after MAX_HRIR_SAMPLES at 48kHz).
+// Directions are relative to the listener's right and up (see Listener::set_position_right_up); throws on error.
+constexpr uint32_t const MAX_HRIR_SAMPLES = 512;
+void load_hrtf(std::string const &filename);
+
+//render at most 'max_voices' (up to MAX_HRTF_VOICES) samples binaurally at once; if 'cpu_fraction' is less than 1,
+// use fewer whenever that many would take longer than that fraction of each block's time to render:
+// (defaults: 16 voices, no time limit -- so output doesn't depend on timing)
+constexpr uint32_t const MAX_HRTF_VOICES = 64;
+void set_hrtf_budget(uint32_t max_voices, float cpu_fraction = 1.0f);
+
+//Buses -- playing samples are mixed into buses (see PlayingSample::set_bus), each of which runs a chain of effects on its mix
+// and adds the result to its parent bus (and, optionally, some of it to a 'send' bus -- e.g., one with a reverb).
+//Effects run once per bus rather than once per sample, so they cost the same however many samples are playing.
+//Bus 0 (MASTER_BUS) is the output.
+constexpr uint32_t const MASTER_BUS = 0;
+constexpr uint32_t const MAX_BUSES = 8;
+constexpr uint32_t const MAX_BUS_EFFECTS = 4;
+
+//impulse response for a Convolution effect (e.g., a recording of a room's response to a click):
+struct ImpulseResponse {
+	//load from a '.wav' file (mixed down to mono and converted to 48kHz; cut short after MAX_IMPULSE_RESPONSE_SECONDS):
+	ImpulseResponse(std::string const &filename);
+	//directly supply 48kHz samples:
+	ImpulseResponse(std::vector< float > const &data);
+
+	//(the response, split up and transformed for the convolution engine)
+	std::shared_ptr< ConvolutionFilter const > filter;
+};
+constexpr float const MAX_IMPULSE_RESPONSE_SECONDS = 3.0f;
+
+struct Effect {
+	enum Type : uint8_t {
+		None,
+		LowPass, //12dB/octave biquad low-pass at 'frequency' Hz with resonance 'q' (0.7071 == no resonant peak)
+		HighPass, //12dB/octave biquad high-pass (same parameters)
+		Reverb, //feedback delay network reverb (see fdn_reverb in mix_kernels.hpp); at most one per bus
+		Convolution, //convolution with an impulse response (see convolve.hpp); at most one per bus
+	} type = None;
+	float frequency = 1000.0f, q = 0.7071f; //(LowPass, HighPass)
+	//(Reverb) 'room_size' in [0,1] scales the delay lengths; 'decay' is the time (seconds) to fall by 60dB;
+	// 'damping' in [0,1) makes the tail darker; (Reverb, Convolution) 'wet' is the fraction of output that is reverb (1 for a send bus):
+	float room_size = 0.5f, decay = 1.5f, damping = 0.3f, wet = 1.0f;
+	//(Convolution) must outlive every bus using it:
+	ImpulseResponse const *impulse_response = nullptr;
+
+	static Effect low_pass(float frequency, float q = 0.7071f);
+	static Effect high_pass(float frequency, float q = 0.7071f);
+	static Effect reverb(float room_size = 0.5f, float decay = 1.5f, float damping = 0.3f, float wet = 1.0f);
+	static Effect convolution(ImpulseResponse const &impulse_response, float wet = 1.0f);
+};
+
+//make a new bus that adds its output to 'parent' (returns its index, or MASTER_BUS if all MAX_BUSES are in use):
+// (call after Sound::init())
+uint32_t add_bus(uint32_t parent = MASTER_BUS);
+//replace a bus's effects (at most MAX_BUS_EFFECTS, run in order; effect state -- e.g., a reverb's tail -- is kept when the type is unchanged):
+void set_bus_effects(uint32_t bus, std::vector< Effect > const &effects);
+//set the volume of a bus (for MASTER_BUS, this is Sound::set_volume):
+void set_bus_volume(uint32_t bus, float new_volume, float ramp = 1.0f / 60.0f);
+//also add 'level' times a bus's output to bus 'send' (level 0 to stop); 'send' must have been added before 'bus',
+// so (e.g.) add a reverb bus first and then the buses that send to it:
+void set_bus_send(uint32_t bus, uint32_t send, float level);
+
+//Distance low-pass -- makes far-away "3D" samples duller, like sound traveling through air:
+// 3D samples are low-pass filtered with a cutoff of 20kHz / (1 + distance / half_cutoff_distance)
+// (so 10kHz at half_cutoff_distance); infinity (the default) turns this off.
+void set_distance_low_pass(float half_cutoff_distance);
+
+//Audio callback statistics -- recorded by the audio thread without locking, so get_stats() is cheap enough to call every frame.
+// (each value is updated separately, so a snapshot may mix values from adjacent callbacks)
+struct Stats {
+	//callback durations: histogram[0] counts callbacks that took under 1us, histogram[b] those that took [2^(b-1), 2^b) us,
+	// and the last bin everything longer:
+	static constexpr uint32_t const HISTOGRAM_BINS = 17;
+	uint64_t histogram[HISTOGRAM_BINS] = {};
+	uint64_t callbacks = 0; //blocks mixed
+	uint64_t over_budget = 0; //callbacks that took longer than the audio they mixed (each is likely an audible dropout)
+	uint64_t late = 0; //callbacks that started more than two blocks after the previous one (the device probably ran dry)
+	uint64_t late_starts = 0; //playbacks started with play_at (etc.) that reached the audio thread after their start time
+	uint32_t block_samples = 0; //size of the most recent block
+	uint32_t budget_microseconds = 0; //length of the audio in the most recent block
+	uint32_t max_microseconds = 0; //slowest callback
+
+	//voices in the most recent callback (virtual voices are active_voices - real_voices; see set_virtualization), and the most seen at once:
+	uint32_t active_voices = 0, real_voices = 0;
+	uint32_t max_active_voices = 0, max_real_voices = 0;
+
+	//largest absolute output sample (anything over 1.0 clips), in the most recent callback and overall:
+	float last_peak = 0.0f, peak = 0.0f;
+
+	uint32_t stream_underruns = 0; //times a streamed sample's decoder fell behind
+
+	//average time per callback spent running each bus's effects and adding it to its parent and send buses:
+	float bus_microseconds[MAX_BUSES] = {};
+
+	//samples rendered binaurally (see load_hrtf) in the most recent callback, and the most at once:
+	uint32_t hrtf_voices = 0, max_hrtf_voices = 0;
+	//average time per callback spent mixing them:
+	float hrtf_microseconds = 0.0f;
+};
+Stats get_stats();
+
+//write get_stats() to a text file (e.g., from a production build, to catch dropouts under load):
+// (Sound::shutdown() also does this if the AUDIO_STATS environment variable is set -- to a filename, or to 1 for 'audio-stats.txt')
+void write_stats(std::string const &filename);
+
 //"panic button" to shut off all currently playing sounds:
 void stop_all_samples();
 
 //set global volume:
 void set_volume(float new_volume, float ramp = 1.0f / 60.0f);
-extern Ramp< float > volume;
+extern Ramp< float > volume; //(owned by the audio thread)
 
 //the audio callback doesn't run between Sound::lock() and Sound::unlock()
-// the set_*/stop/play/... functions already use these helpers, so you shouldn't need
-// to call them unless your code is modifying values directly:
+// the set_*/stop/play/... functions don't need these (they queue commands instead), so you should
+// only call them if your code is modifying audio-thread-owned values directly (and only briefly!):
 void lock();
 void unlock();
 
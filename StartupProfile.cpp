@@ -0,0 +1,167 @@
+#include "StartupProfile.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//local (to this file) data used by the profiler:
+namespace {
+	std::string output_base() {
+		//(on unless turned off with STARTUP_PROFILE=0)
+		char const *var = std::getenv("STARTUP_PROFILE");
+		if (var != nullptr && std::string(var) == "0") return "";
+		if (var == nullptr || var[0] == '\0' || std::string(var) == "1") return "startup-profile";
+		return var;
+	}
+
+	//times are relative to when the program started (well, when static initialization got here):
+	auto const start_time = std::chrono::steady_clock::now();
+
+	struct Event {
+		char const *name;
+		char const *category;
+		char const *file;
+		uint32_t line;
+		char const *detail;
+		uint32_t depth; //number of enclosing events
+		double begin_us = 0.0;
+		double end_us = 0.0;
+		size_t bytes_read = 0;
+		size_t bytes_uploaded = 0;
+	};
+	std::vector< Event > events;
+	std::vector< uint32_t > open_events; //stack of indices into 'events'
+	bool finished = false;
+
+	double now_us() {
+		return std::chrono::duration< double, std::micro >(std::chrono::steady_clock::now() - start_time).count();
+	}
+
+	//JSON-escape a string:
+	std::string json_string(char const *str) {
+		std::string ret = "\"";
+		for (char const *c = str; *c != '\0'; ++c) {
+			if (*c == '"' || *c == '\\') ret += '\\';
+			if (uint8_t(*c) < 0x20) {
+				ret += ' ';
+			} else {
+				ret += *c;
+			}
+		}
+		ret += '"';
+		return ret;
+	}
+}
+
+bool StartupProfile::enabled = !output_base().empty();
+
+void StartupProfile::Scope::begin(char const *name, char const *category, char const *file, uint32_t line, char const *detail) {
+	if (finished) return;
+	index = uint32_t(events.size());
+	events.emplace_back();
+	Event &event = events.back();
+	event.name = name;
+	event.category = category;
+	event.file = file;
+	event.line = line;
+	event.detail = detail;
+	event.depth = uint32_t(open_events.size());
+	event.begin_us = now_us();
+	open_events.emplace_back(index);
+}
+
+void StartupProfile::Scope::end() {
+	if (index == -1U) return;
+	//(a Scope still open when finish() was called was closed -- and its event freed -- by finish()):
+	if (finished) {
+		index = -1U;
+		return;
+	}
+	events[index].end_us = now_us();
+	assert(!open_events.empty() && open_events.back() == index && "Scopes should be properly nested.");
+	open_events.pop_back();
+}
+
+void StartupProfile::add_bytes_read(size_t bytes) {
+	if (open_events.empty()) return;
+	events[open_events.back()].bytes_read += bytes;
+}
+
+void StartupProfile::add_bytes_uploaded(size_t bytes) {
+	if (open_events.empty()) return;
+	events[open_events.back()].bytes_uploaded += bytes;
+}
+
+void StartupProfile::finish() {
+	if (!enabled || finished) return;
+	finished = true;
+
+	double finish_us = now_us();
+	//close anything still open (e.g., if finish() is called from within a Scope):
+	for (uint32_t index : open_events) {
+		events[index].end_us = finish_us;
+	}
+
+	std::string base = output_base();
+
+	{ //trace events, as described in https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+		std::ofstream json(base + ".json", std::ios::binary);
+		json << "{\"traceEvents\":[\n";
+		for (auto const &event : events) {
+			if (&event != &events[0]) json << ",\n";
+			std::string location = (event.file ? std::string(event.file) + ":" + std::to_string(event.line) : std::string());
+			//label with location so that, e.g., different load functions can be told apart:
+			std::string name = event.name;
+			if (!location.empty()) name += " " + location;
+			json << "{\"name\":" << json_string(name.c_str())
+			     << ",\"cat\":" << json_string(event.category)
+			     << ",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+			     << std::fixed << std::setprecision(3)
+			     << ",\"ts\":" << event.begin_us
+			     << ",\"dur\":" << (event.end_us - event.begin_us)
+			     << ",\"args\":{";
+			json << "\"phase\":" << json_string(event.name);
+			if (event.detail) json << ",\"detail\":" << json_string(event.detail);
+			if (!location.empty()) json << ",\"location\":" << json_string(location.c_str());
+			json << ",\"bytes_read\":" << event.bytes_read;
+			json << ",\"bytes_uploaded\":" << event.bytes_uploaded;
+			json << "}}";
+		}
+		json << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	}
+
+	{ //summary, slowest first:
+		std::vector< Event const * > sorted;
+		sorted.reserve(events.size());
+		for (auto const &event : events) sorted.emplace_back(&event);
+		std::stable_sort(sorted.begin(), sorted.end(), [](Event const *a, Event const *b) {
+			return (a->end_us - a->begin_us) > (b->end_us - b->begin_us);
+		});
+
+		std::ofstream txt(base + ".txt", std::ios::binary);
+		txt << "Startup took " << std::fixed << std::setprecision(3) << finish_us / 1000.0 << " ms; phases by (inclusive) duration:\n";
+		txt << "        ms  depth      bytes read  bytes uploaded  phase\n";
+		for (Event const *event : sorted) {
+			txt << std::setw(10) << (event->end_us - event->begin_us) / 1000.0
+			    << std::setw(7) << event->depth
+			    << std::setw(16) << event->bytes_read
+			    << std::setw(16) << event->bytes_uploaded
+			    << "  " << event->name;
+			if (event->detail) txt << " [" << event->detail << "]";
+			if (event->file) txt << " (" << event->file << ":" << event->line << ")";
+			txt << "\n";
+		}
+	}
+
+	std::cout << "Wrote startup profile to '" << base << ".json' and '" << base << ".txt'." << std::endl;
+
+	events.clear();
+	events.shrink_to_fit();
+	open_events.clear();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+/*
+ * StartupProfile -- times the phases of startup (SDL init, context creation,
+ *  Sound::init, each Load<> function, initial Mode construction, ...).
+ *
+ * Profiling is on by default; the STARTUP_PROFILE environment variable picks where
+ *  the results go, or turns it off:
+ *   $ dist/game                                #writes startup-profile.json + startup-profile.txt
+ *   $ STARTUP_PROFILE=/tmp/run3 dist/game      #writes /tmp/run3.json + /tmp/run3.txt
+ *   $ STARTUP_PROFILE=0 dist/game              #no profiling
+ *
+ * The '.json' file is in Chrome's trace event format (open with chrome://tracing
+ *  or https://ui.perfetto.dev); the '.txt' file lists phases sorted by duration.
+ *
+ * When STARTUP_PROFILE=0, every function here returns after checking a single bool.
+ *
+ */
+
+#include <cstdint>
+#include <cstddef>
+
+namespace StartupProfile {
+
+//set from the STARTUP_PROFILE environment variable before main() runs:
+extern bool enabled;
+
+//times the enclosing block as one phase:
+// 'name', 'category', 'file', and 'detail' should be string literals (or otherwise outlive the profile).
+struct Scope {
+	Scope(char const *name, char const *category = "startup", char const *file = nullptr, uint32_t line = 0, char const *detail = nullptr) {
+		if (enabled) begin(name, category, file, line, detail);
+	}
+	~Scope() {
+		if (enabled) end();
+	}
+	Scope(Scope const &) = delete;
+	Scope &operator=(Scope const &) = delete;
+private:
+	void begin(char const *name, char const *category, char const *file, uint32_t line, char const *detail);
+	void end();
+	uint32_t index = -1U;
+};
+
+//credit bytes read from storage / uploaded to the GPU to the innermost open Scope:
+void add_bytes_read(size_t bytes);
+void add_bytes_uploaded(size_t bytes);
+inline void note_bytes_read(size_t bytes) { if (enabled) add_bytes_read(bytes); }
+inline void note_bytes_uploaded(size_t bytes) { if (enabled) add_bytes_uploaded(bytes); }
+
+//write the trace and summary files (call once startup is complete; later Scopes are ignored):
+void finish();
+
+} //namespace StartupProfile
+
+//convenience macro to time the rest of the current block:
+#define STARTUP_PROFILE_SCOPE_CONCAT2(A,B) A ## B
+#define STARTUP_PROFILE_SCOPE_CONCAT(A,B) STARTUP_PROFILE_SCOPE_CONCAT2(A,B)
+#define STARTUP_PROFILE_SCOPE(NAME) StartupProfile::Scope STARTUP_PROFILE_SCOPE_CONCAT(startup_profile_scope_, __LINE__)(NAME, "startup", __FILE__, __LINE__)
@@ -0,0 +1,177 @@
+#include "convolve.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//This file checks the partitioned FFT convolution engine (see convolve.hpp) against direct convolution,
+// and measures what it costs the mixer for HRTF voices and impulse-response reverb (see Sound.cpp):
+// $ ./bench-convolve
+//Costs are per voice (or per bus) per audio block, and as a share of the block's length.
+
+//same as Sound.cpp:
+constexpr uint32_t const AUDIO_RATE = 48000;
+constexpr uint32_t const BLOCK_SAMPLES = 1024; //(Sound::DEFAULT_BLOCK_SAMPLES)
+constexpr uint32_t const CONTROL_SAMPLES = 128; //(HRTF voices are convolved in pieces this long, partitioned this long too)
+constexpr uint32_t const IMPULSE_RESPONSE_BLOCK = 1024; //(reverb impulse responses are partitioned this long)
+
+std::vector< float > make_noise(uint32_t count, uint32_t seed, float scale = 1.0f) {
+	std::mt19937 mt(seed);
+	std::uniform_real_distribution< float > dist(-scale, scale);
+	std::vector< float > noise(count);
+	for (auto &v : noise) v = dist(mt);
+	return noise;
+}
+
+//a decaying noise burst, roughly like an HRIR or a room's impulse response:
+std::vector< float > make_response(uint32_t count, uint32_t seed) {
+	std::vector< float > response = make_noise(count, seed);
+	for (uint32_t i = 0; i < count; ++i) {
+		response[i] *= std::exp(-5.0f * float(i) / float(count));
+	}
+	return response;
+}
+
+//direct convolution of interleaved stereo 'in' (left + i right) with 'left' + i 'right' (right may be null), as the engine computes it:
+std::vector< float > direct_convolve(std::vector< float > const &in, std::vector< float > const &left, std::vector< float > const *right) {
+	uint32_t count = uint32_t(in.size() / 2);
+	std::vector< float > out(in.size(), 0.0f);
+	for (uint32_t n = 0; n < count; ++n) {
+		double re = 0.0, im = 0.0;
+		for (uint32_t k = 0; k < left.size() && k <= n; ++k) {
+			double a = in[2 * (n - k)], b = in[2 * (n - k) + 1];
+			double c = left[k], d = (right ? (*right)[k] : 0.0f);
+			re += a * c - b * d;
+			im += a * d + b * c;
+		}
+		out[2 * n] = float(re);
+		out[2 * n + 1] = float(im);
+	}
+	return out;
+}
+
+//largest difference between 'a' and 'b', relative to the largest value in 'b':
+double relative_error(std::vector< float > const &a, std::vector< float > const &b) {
+	double error = 0.0, peak = 0.0;
+	for (uint32_t i = 0; i < a.size(); ++i) {
+		error = std::max(error, double(std::abs(a[i] - b[i])));
+		peak = std::max(peak, double(std::abs(b[i])));
+	}
+	return error / peak;
+}
+
+//run 'count' stereo samples of 'in' through 'convolver' in pieces of 'piece' samples:
+std::vector< float > run(Convolver &convolver, ConvolutionFilter const &filter, std::vector< float > const &in, uint32_t piece) {
+	std::vector< float > out(in.size(), 0.0f);
+	uint32_t count = uint32_t(in.size() / 2);
+	for (uint32_t s = 0; s < count; s += piece) {
+		convolver.process(filter, in.data() + 2 * s, std::min(piece, count - s), out.data() + 2 * s);
+	}
+	return out;
+}
+
+template< typename F >
+double seconds(F const &f) {
+	auto before = std::chrono::high_resolution_clock::now();
+	f();
+	auto after = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration< double >(after - before).count();
+}
+
+int main(int, char **) {
+	double block_seconds = double(BLOCK_SAMPLES) / double(AUDIO_RATE);
+
+	//--- correctness ---
+	std::cout << "Error relative to direct convolution (peak difference / peak output):" << std::endl;
+	{ //HRTF: mono input, stereo response, in mixer-sized pieces (and in odd ones, as for voices that start partway through a piece):
+		std::vector< float > left = make_response(512, 1), right = make_response(512, 2);
+		ConvolutionFilter filter(CONTROL_SAMPLES, left.data(), right.data(), 512);
+		std::vector< float > in = make_noise(2 * 4096, 3);
+		for (uint32_t i = 1; i < in.size(); i += 2) in[i] = 0.0f;
+		std::vector< float > expected = direct_convolve(in, left, &right);
+		for (uint32_t piece : { CONTROL_SAMPLES, 37U }) {
+			Convolver convolver(CONTROL_SAMPLES, 512 / CONTROL_SAMPLES);
+			std::cout << "  HRTF (512-sample HRIRs, " << piece << "-sample pieces): " << relative_error(run(convolver, filter, in, piece), expected) << std::endl;
+		}
+	}
+	{ //reverb: stereo input, mono response:
+		std::vector< float > response = make_response(AUDIO_RATE / 4, 4);
+		ConvolutionFilter filter(IMPULSE_RESPONSE_BLOCK, response.data(), nullptr, uint32_t(response.size()));
+		std::vector< float > in = make_noise(2 * 4 * IMPULSE_RESPONSE_BLOCK, 5);
+		std::vector< float > expected = direct_convolve(in, response, nullptr);
+		Convolver convolver(IMPULSE_RESPONSE_BLOCK, filter.partitions);
+		std::cout << "  reverb (0.25 s response, " << BLOCK_SAMPLES << "-sample blocks): " << relative_error(run(convolver, filter, in, BLOCK_SAMPLES), expected) << std::endl;
+	}
+
+	//--- HRTF cost ---
+	std::cout << "HRTF voices (" << CONTROL_SAMPLES << "-sample partitions and pieces, as used by the mixer):" << std::endl;
+	for (uint32_t length : { 128U, 256U, 512U }) {
+		std::vector< float > left = make_response(length, 6), right = make_response(length, 7);
+		ConvolutionFilter filter(CONTROL_SAMPLES, left.data(), right.data(), length);
+		Convolver convolver(CONTROL_SAMPLES, length / CONTROL_SAMPLES);
+		std::vector< float > in = make_noise(2 * 20 * BLOCK_SAMPLES, 8);
+		for (uint32_t i = 1; i < in.size(); i += 2) in[i] = 0.0f;
+
+		std::vector< float > out;
+		uint32_t repeats = 20;
+		double time = seconds([&](){
+			for (uint32_t repeat = 0; repeat < repeats; ++repeat) {
+				out = run(convolver, filter, in, CONTROL_SAMPLES);
+			}
+		});
+		double per_block = time / (repeats * 20);
+
+		//direct convolution (both ears) for comparison:
+		std::vector< float > mono(in.size() / 2), direct(in.size(), 0.0f);
+		for (uint32_t i = 0; i < mono.size(); ++i) mono[i] = in[2 * i];
+		double direct_time = seconds([&](){
+			for (uint32_t repeat = 0; repeat < repeats; ++repeat) {
+				for (uint32_t n = length; n < mono.size(); ++n) {
+					float l = 0.0f, r = 0.0f;
+					for (uint32_t k = 0; k < length; ++k) {
+						l += mono[n - k] * left[k];
+						r += mono[n - k] * right[k];
+					}
+					direct[2 * n] = l;
+					direct[2 * n + 1] = r;
+				}
+			}
+		});
+		double direct_per_block = direct_time / (repeats * 20);
+
+		//(both should agree once past the first HRIR's worth of samples, which the previous repeat affects)
+		std::fill(out.begin(), out.begin() + 2 * length, 0.0f);
+		std::cout << "  " << length << "-sample HRIRs: " << (per_block * 1e9) << " ns per voice per block (" << (100.0 * per_block / block_seconds) << "% of a "
+		          << (block_seconds * 1e3) << " ms block); direct convolution " << (direct_per_block * 1e9) << " ns (" << (direct_per_block / per_block) << "x slower; error "
+		          << relative_error(out, direct) << ")." << std::endl;
+	}
+
+	//--- reverb cost ---
+	std::cout << "Impulse-response reverb (" << IMPULSE_RESPONSE_BLOCK << "-sample partitions, one per bus):" << std::endl;
+	for (float length_seconds : { 1.0f, 2.0f, 3.0f }) {
+		uint32_t length = uint32_t(length_seconds * AUDIO_RATE);
+		std::vector< float > response = make_response(length, 9);
+		ConvolutionFilter filter(IMPULSE_RESPONSE_BLOCK, response.data(), nullptr, length);
+		std::vector< float > in = make_noise(2 * 20 * BLOCK_SAMPLES, 10);
+		std::cout << "  " << length_seconds << " s response:";
+		for (uint32_t piece : { BLOCK_SAMPLES, CONTROL_SAMPLES }) {
+			Convolver convolver(IMPULSE_RESPONSE_BLOCK, filter.partitions);
+			std::vector< float > out;
+			uint32_t repeats = 10;
+			double time = seconds([&](){
+				for (uint32_t repeat = 0; repeat < repeats; ++repeat) {
+					out = run(convolver, filter, in, piece);
+				}
+			});
+			double per_block = time / (repeats * 20);
+			std::cout << " " << (per_block * 1e6) << " us per block (" << (100.0 * per_block / block_seconds) << "%) in " << piece << "-sample blocks;";
+		}
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,187 @@
+#include "mix_kernels.hpp"
+#include "ima_adpcm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//This file measures the cost of the mixer's inner loop (see mix_audio in Sound.cpp) per voice:
+// $ ./bench-mix [voices] [blocks]
+//It mixes 'voices' looping samples of assorted lengths (so segments split at loop points, like in the game)
+// and compares the block kernel from mix_kernels.cpp with the old one-sample-at-a-time loop.
+//It then compares the memory used and mixing cost of each of Sound::Sample's encodings.
+
+//same as Sound.cpp:
+constexpr uint32_t const AUDIO_RATE = 48000;
+constexpr uint32_t const MIX_SAMPLES = 1024;
+
+//the same sample stored in each of Sound::Sample's encodings:
+enum Encoding { Float, Int16, ADPCM };
+struct Encoded {
+	std::vector< float > data;
+	std::vector< int16_t > data_int16;
+	std::vector< uint8_t > data_adpcm;
+};
+
+struct Voice {
+	Encoded const *sample;
+	uint32_t i = 0;
+	float l = 0.0f, r = 0.0f; //gain at start of block
+	float l_step = 0.0f, r_step = 0.0f; //change in gain per sample
+};
+
+//the per-sample loop mix_audio used before the block kernel:
+void mix_scalar(Voice &voice, float *buffer) {
+	float l = voice.l;
+	float r = voice.r;
+	std::vector< float > const &data = voice.sample->data;
+	for (uint32_t i = 0; i < MIX_SAMPLES; ++i) {
+		buffer[2*i+0] += l * data[voice.i];
+		buffer[2*i+1] += r * data[voice.i];
+		voice.i += 1;
+		if (voice.i == data.size()) voice.i = 0;
+		l += voice.l_step;
+		r += voice.r_step;
+	}
+}
+
+//mix_audio's current approach (decoding non-Float samples into a buffer before mixing, like voice_samples() does):
+float decode_buffer[MIX_SAMPLES];
+template< Encoding E >
+void mix_block(Voice &voice, float *buffer) {
+	Encoded const &sample = *voice.sample;
+	std::vector< float > const &data = sample.data;
+	for (uint32_t mixed = 0; mixed < MIX_SAMPLES; /* later */) {
+		uint32_t count = std::min< uint32_t >(MIX_SAMPLES - mixed, uint32_t(data.size()) - voice.i);
+		float const *src = decode_buffer;
+		if (E == Float) {
+			src = data.data() + voice.i;
+		} else if (E == Int16) {
+			int16_to_float(sample.data_int16.data() + voice.i, count, decode_buffer);
+		} else if (E == ADPCM) {
+			ima_adpcm_decode(sample.data_adpcm.data(), voice.i, count, decode_buffer);
+		}
+		mix_mono_to_stereo(src, count,
+			voice.l + mixed * voice.l_step, voice.r + mixed * voice.r_step,
+			voice.l_step, voice.r_step,
+			buffer + 2 * mixed);
+		mixed += count;
+		voice.i += count;
+		if (voice.i == data.size()) voice.i = 0;
+	}
+}
+
+template< typename F >
+double time_mix(std::vector< Voice > voices, uint32_t blocks, F const &mix, std::vector< float > *out) {
+	std::vector< float > buffer(2 * MIX_SAMPLES);
+	auto before = std::chrono::high_resolution_clock::now();
+	for (uint32_t b = 0; b < blocks; ++b) {
+		std::fill(buffer.begin(), buffer.end(), 0.0f);
+		for (auto &voice : voices) {
+			mix(voice, buffer.data());
+		}
+	}
+	auto after = std::chrono::high_resolution_clock::now();
+	*out = buffer;
+	return std::chrono::duration< double >(after - before).count();
+}
+
+int main(int argc, char **argv) {
+	uint32_t voice_count = (argc > 1 ? std::atoi(argv[1]) : 256);
+	uint32_t blocks = (argc > 2 ? std::atoi(argv[2]) : 2000);
+	if (voice_count == 0 || blocks == 0) {
+		std::cerr << "Usage:\n\t./bench-mix [voices] [blocks]" << std::endl;
+		return 1;
+	}
+
+	std::mt19937 mt(0xfeedf00d);
+
+	//a handful of samples, from shorter than a block (loops several times per block) to several seconds:
+	// (random walks rather than white noise, so ADPCM -- which assumes neighboring samples are similar -- is tested fairly)
+	std::vector< Encoded > samples;
+	for (uint32_t length : {300U, 1000U, 4801U, 48000U, 3U * 48000U + 17U}) {
+		samples.emplace_back();
+		Encoded &sample = samples.back();
+		sample.data.resize(length);
+		float at = 0.0f;
+		for (auto &s : sample.data) {
+			at = 0.99f * at + std::uniform_real_distribution< float >(-0.05f, 0.05f)(mt);
+			s = std::max(-1.0f, std::min(1.0f, at));
+		}
+		sample.data_int16.resize(length);
+		for (uint32_t i = 0; i < length; ++i) {
+			sample.data_int16[i] = int16_t(std::max(-32768.0f, std::min(32767.0f, std::round(sample.data[i] * 32768.0f))));
+		}
+		ima_adpcm_encode(sample.data.data(), length, &sample.data_adpcm);
+	}
+
+	std::vector< Voice > voices(voice_count);
+	for (uint32_t v = 0; v < voice_count; ++v) {
+		Voice &voice = voices[v];
+		voice.sample = &samples[v % samples.size()];
+		voice.i = mt() % voice.sample->data.size();
+		voice.l = std::uniform_real_distribution< float >(0.0f, 1.0f)(mt) / voice_count;
+		voice.r = std::uniform_real_distribution< float >(0.0f, 1.0f)(mt) / voice_count;
+		voice.l_step = std::uniform_real_distribution< float >(-1.0f, 1.0f)(mt) / (voice_count * MIX_SAMPLES);
+		voice.r_step = std::uniform_real_distribution< float >(-1.0f, 1.0f)(mt) / (voice_count * MIX_SAMPLES);
+	}
+
+	std::vector< float > scalar_out, block_out;
+	//warm up caches:
+	time_mix(voices, 10, mix_block< Float >, &block_out);
+
+	double scalar_time = time_mix(voices, blocks, mix_scalar, &scalar_out);
+	double block_time = time_mix(voices, blocks, mix_block< Float >, &block_out);
+
+	float max_error = 0.0f;
+	for (uint32_t i = 0; i < block_out.size(); ++i) {
+		max_error = std::max(max_error, std::abs(block_out[i] - scalar_out[i]));
+	}
+
+	double block_seconds = double(MIX_SAMPLES) / double(AUDIO_RATE);
+	auto report = [&](std::string const &name, double time) {
+		double per_voice = time / (double(blocks) * voice_count);
+		std::cout << "  " << name << ": " << (per_voice * 1e9) << " ns per voice per block; "
+		          << voice_count << " voices use " << (100.0 * time / blocks / block_seconds) << "% of a "
+		          << (block_seconds * 1e3) << " ms block." << std::endl;
+	};
+
+	std::cout << "Mixing " << voice_count << " voices x " << blocks << " blocks of " << MIX_SAMPLES << " samples:" << std::endl;
+	report("scalar", scalar_time);
+	report(" block", block_time);
+	std::cout << "  speedup: " << (scalar_time / block_time) << "x; max difference: " << max_error << std::endl;
+
+	//compare encodings (memory is for the whole set of samples; difference is from the Float mix):
+	size_t float_bytes = 0, int16_bytes = 0, adpcm_bytes = 0;
+	for (auto const &sample : samples) {
+		float_bytes += sample.data.size() * sizeof(float);
+		int16_bytes += sample.data_int16.size() * sizeof(int16_t);
+		adpcm_bytes += sample.data_adpcm.size();
+	}
+	auto report_encoding = [&](std::string const &name, double time, size_t bytes, std::vector< float > const &out) {
+		float max_difference = 0.0f;
+		for (uint32_t i = 0; i < out.size(); ++i) {
+			max_difference = std::max(max_difference, std::abs(out[i] - block_out[i]));
+		}
+		std::cout << "  " << name << ": " << (time / (double(blocks) * voice_count) * 1e9) << " ns per voice per block ("
+		          << (time / block_time) << "x Float); " << (bytes + 1023) / 1024 << "k of samples ("
+		          << (100.0 * bytes / float_bytes) << "% of Float); max difference: " << max_difference << std::endl;
+	};
+
+	std::vector< float > int16_out, adpcm_out;
+	double int16_time = time_mix(voices, blocks, mix_block< Int16 >, &int16_out);
+	double adpcm_time = time_mix(voices, blocks, mix_block< ADPCM >, &adpcm_out);
+
+	std::cout << "Encodings:" << std::endl;
+	report_encoding("Float", block_time, float_bytes, block_out);
+	report_encoding("Int16", int16_time, int16_bytes, int16_out);
+	report_encoding("ADPCM", adpcm_time, adpcm_bytes, adpcm_out);
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include "resample.hpp"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//This file compares resample() (used by load_wav) with SDL's audio converter, and measures the cost
+// of the real-time resampling the mixer does for voices with a playback rate (see Sound.cpp):
+// $ ./bench-resample
+//Quality is reported as THD+N: the power of everything except the test tone, relative to the tone.
+
+//same as Sound.cpp:
+constexpr uint32_t const AUDIO_RATE = 48000;
+constexpr uint32_t const BLOCK_SAMPLES = 1024; //(Sound::DEFAULT_BLOCK_SAMPLES)
+constexpr uint32_t const CONTROL_SAMPLES = 128; //(real voices are resampled in pieces this long)
+constexpr uint32_t const RESAMPLE_TAPS = 32;
+
+constexpr double const PI = 3.14159265358979323846;
+
+std::vector< float > make_tone(double frequency, uint32_t rate, uint32_t count) {
+	std::vector< float > tone(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		tone[i] = float(0.5 * std::sin(2.0 * PI * frequency * i / rate));
+	}
+	return tone;
+}
+
+//THD+N (in dB) of 'signal' (at 'rate') as a tone of 'frequency':
+// fits the best sinusoid of that frequency (by least squares) and compares what's left over to it.
+// (skips 'skip' samples at each end, to ignore filter start-up)
+double thd_n(std::vector< float > const &signal, double frequency, uint32_t rate, uint32_t skip) {
+	double ss = 0.0, sc = 0.0, cc = 0.0, ys = 0.0, yc = 0.0;
+	for (uint32_t i = skip; i + skip < signal.size(); ++i) {
+		double s = std::sin(2.0 * PI * frequency * i / rate);
+		double c = std::cos(2.0 * PI * frequency * i / rate);
+		ss += s * s; sc += s * c; cc += c * c;
+		ys += signal[i] * s; yc += signal[i] * c;
+	}
+	double det = ss * cc - sc * sc;
+	double a = (ys * cc - yc * sc) / det;
+	double b = (yc * ss - ys * sc) / det;
+
+	double noise = 0.0, power = 0.0;
+	for (uint32_t i = skip; i + skip < signal.size(); ++i) {
+		double fit = a * std::sin(2.0 * PI * frequency * i / rate) + b * std::cos(2.0 * PI * frequency * i / rate);
+		noise += (signal[i] - fit) * (signal[i] - fit);
+		power += fit * fit;
+	}
+	return 10.0 * std::log10(noise / power);
+}
+
+//convert with SDL the way load_wav used to (returns false if SDL can't):
+bool sdl_resample(std::vector< float > const &in, uint32_t in_rate, uint32_t out_rate, std::vector< float > *out) {
+	SDL_AudioCVT cvt;
+	if (SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, 1, int(in_rate), AUDIO_F32SYS, 1, int(out_rate)) < 0) return false;
+	cvt.len = int(in.size() * sizeof(float));
+	cvt.buf = (Uint8 *)SDL_malloc(cvt.len * cvt.len_mult);
+	SDL_memcpy(cvt.buf, in.data(), cvt.len);
+	if (SDL_ConvertAudio(&cvt) != 0) {
+		SDL_free(cvt.buf);
+		return false;
+	}
+	out->assign(reinterpret_cast< float * >(cvt.buf), reinterpret_cast< float * >(cvt.buf + cvt.len_cvt));
+	SDL_free(cvt.buf);
+	return true;
+}
+
+template< typename F >
+double seconds(F const &f) {
+	auto before = std::chrono::high_resolution_clock::now();
+	f();
+	auto after = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration< double >(after - before).count();
+}
+
+int main(int, char **) {
+	//--- load-time conversion ---
+	std::cout << "Load-time conversion to " << AUDIO_RATE << " Hz (THD+N; lower is better):" << std::endl;
+	for (uint32_t in_rate : { 22050U, 44100U, 96000U }) {
+		for (double frequency : { 100.0, 1000.0, 5000.0, 10000.0, 15000.0, 19000.0 }) {
+			if (frequency >= 0.45 * in_rate) continue;
+			std::vector< float > tone = make_tone(frequency, in_rate, in_rate); //(one second)
+			std::vector< float > ours, sdl;
+			resample(tone, in_rate, AUDIO_RATE, &ours);
+			std::cout << "  " << in_rate << " Hz, " << frequency << " Hz tone: resample() " << thd_n(ours, frequency, AUDIO_RATE, 1000) << " dB";
+			if (sdl_resample(tone, in_rate, AUDIO_RATE, &sdl)) {
+				std::cout << "; SDL " << thd_n(sdl, frequency, AUDIO_RATE, 1000) << " dB";
+			}
+			std::cout << std::endl;
+		}
+	}
+
+	{ //speed, on ten seconds of audio:
+		std::vector< float > tone = make_tone(1000.0, 44100, 10 * 44100);
+		std::vector< float > ours, sdl;
+		double ours_time = seconds([&](){ resample(tone, 44100, AUDIO_RATE, &ours); });
+		std::cout << "  speed (44100 Hz -> " << AUDIO_RATE << " Hz): resample() " << (ours.size() / ours_time * 1e-6) << " Msamples/s";
+		bool have_sdl = false;
+		double sdl_time = seconds([&](){ have_sdl = sdl_resample(tone, 44100, AUDIO_RATE, &sdl); });
+		if (have_sdl) {
+			std::cout << "; SDL " << (sdl.size() / sdl_time * 1e-6) << " Msamples/s";
+		}
+		std::cout << std::endl;
+	}
+
+	//--- real-time playback rate ---
+	std::cout << "Playback rate (" << RESAMPLE_TAPS << "-tap filters, as used by the mixer):" << std::endl;
+	double block_seconds = double(BLOCK_SAMPLES) / double(AUDIO_RATE);
+	for (float rate : { 0.5f, 0.9f, 1.5f, 2.5f }) {
+		//(same filter choice as Sound.cpp's resample_voice)
+		float max_rate = (rate <= 1.0f ? 1.0f : (rate <= 2.0f ? 2.0f : 4.0f));
+		ResampleFilter filter(RESAMPLE_TAPS, 256, (0.5f - 0.065f) / max_rate, 7.0f);
+
+		std::vector< float > tone = make_tone(1000.0, AUDIO_RATE, uint32_t(rate * 20 * BLOCK_SAMPLES) + 2 * RESAMPLE_TAPS);
+		std::vector< float > out(20 * BLOCK_SAMPLES);
+		uint32_t blocks = 0;
+		double time = seconds([&](){
+			for (uint32_t repeat = 0; repeat < 50; ++repeat) {
+				double position = 0.0;
+				for (uint32_t b = 0; b < 20; ++b) {
+					for (uint32_t c = 0; c < BLOCK_SAMPLES; c += CONTROL_SAMPLES) {
+						position = resample_block(filter, tone.data(), position, rate, 0.0f, CONTROL_SAMPLES, out.data() + b * BLOCK_SAMPLES + c);
+					}
+					blocks += 1;
+				}
+			}
+		});
+		double per_block = time / blocks;
+		std::cout << "  rate " << rate << ": THD+N " << thd_n(out, 1000.0 * rate, AUDIO_RATE, RESAMPLE_TAPS)
+		          << " dB; " << (per_block * 1e9) << " ns per voice per block (" << (100.0 * per_block / block_seconds) << "% of a "
+		          << (block_seconds * 1e3) << " ms block)." << std::endl;
+	}
+
+	return 0;
+}
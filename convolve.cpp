@@ -0,0 +1,306 @@
+#include "convolve.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define CONVOLVE_SSE
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define CONVOLVE_NEON
+#endif
+
+//FFT twiddle factors for every stage of transforms up to 2 * MAX_CONVOLUTION_BLOCK points:
+// the stage that combines pairs of 'half'-point transforms uses exp(-2 pi i j / (2 half)) for j in [0, half),
+// stored at [half, 2 half) -- so each stage's factors are contiguous, and the same table serves every size.
+struct Twiddles {
+	Twiddles() {
+		constexpr double const PI = 3.14159265358979323846;
+		re.assign(2 * MAX_CONVOLUTION_BLOCK, 0.0f);
+		im.assign(2 * MAX_CONVOLUTION_BLOCK, 0.0f);
+		for (uint32_t half = 1; half < 2 * MAX_CONVOLUTION_BLOCK; half *= 2) {
+			for (uint32_t j = 0; j < half; ++j) {
+				re[half + j] = float(std::cos(-PI * j / half));
+				im[half + j] = float(std::sin(-PI * j / half));
+			}
+		}
+	}
+	std::vector< float > re, im;
+};
+
+static Twiddles const &twiddles() {
+	static Twiddles const table; //(built on first use -- when the first filter is made)
+	return table;
+}
+
+//forward transform of 'n' complex values (decimation in frequency): natural order in, bit-reversed order out:
+static void fft_forward(float *re, float *im, uint32_t n) {
+	Twiddles const &tw = twiddles();
+	for (uint32_t half = n / 2; half > 0; half /= 2) {
+		float const *w_re = tw.re.data() + half;
+		float const *w_im = tw.im.data() + half;
+		for (uint32_t k = 0; k < n; k += 2 * half) {
+			float *a_re = re + k, *a_im = im + k;
+			float *b_re = re + k + half, *b_im = im + k + half;
+			uint32_t j = 0;
+
+			//a, b = a + b, (a - b) * w:
+			#if defined(CONVOLVE_SSE)
+			for (; j + 4 <= half; j += 4) {
+				__m128 ar = _mm_loadu_ps(a_re + j), ai = _mm_loadu_ps(a_im + j);
+				__m128 br = _mm_loadu_ps(b_re + j), bi = _mm_loadu_ps(b_im + j);
+				__m128 wr = _mm_loadu_ps(w_re + j), wi = _mm_loadu_ps(w_im + j);
+				__m128 dr = _mm_sub_ps(ar, br), di = _mm_sub_ps(ai, bi);
+				_mm_storeu_ps(a_re + j, _mm_add_ps(ar, br));
+				_mm_storeu_ps(a_im + j, _mm_add_ps(ai, bi));
+				_mm_storeu_ps(b_re + j, _mm_sub_ps(_mm_mul_ps(dr, wr), _mm_mul_ps(di, wi)));
+				_mm_storeu_ps(b_im + j, _mm_add_ps(_mm_mul_ps(dr, wi), _mm_mul_ps(di, wr)));
+			}
+			#elif defined(CONVOLVE_NEON)
+			for (; j + 4 <= half; j += 4) {
+				float32x4_t ar = vld1q_f32(a_re + j), ai = vld1q_f32(a_im + j);
+				float32x4_t br = vld1q_f32(b_re + j), bi = vld1q_f32(b_im + j);
+				float32x4_t wr = vld1q_f32(w_re + j), wi = vld1q_f32(w_im + j);
+				float32x4_t dr = vsubq_f32(ar, br), di = vsubq_f32(ai, bi);
+				vst1q_f32(a_re + j, vaddq_f32(ar, br));
+				vst1q_f32(a_im + j, vaddq_f32(ai, bi));
+				vst1q_f32(b_re + j, vmlsq_f32(vmulq_f32(dr, wr), di, wi));
+				vst1q_f32(b_im + j, vmlaq_f32(vmulq_f32(dr, wi), di, wr));
+			}
+			#endif
+
+			for (; j < half; ++j) {
+				float dr = a_re[j] - b_re[j], di = a_im[j] - b_im[j];
+				a_re[j] += b_re[j];
+				a_im[j] += b_im[j];
+				b_re[j] = dr * w_re[j] - di * w_im[j];
+				b_im[j] = dr * w_im[j] + di * w_re[j];
+			}
+		}
+	}
+}
+
+//forward transform of 'n' complex values (decimation in time): bit-reversed order in, natural order out:
+static void fft_forward_from_bit_reversed(float *re, float *im, uint32_t n) {
+	Twiddles const &tw = twiddles();
+	for (uint32_t half = 1; half < n; half *= 2) {
+		float const *w_re = tw.re.data() + half;
+		float const *w_im = tw.im.data() + half;
+		for (uint32_t k = 0; k < n; k += 2 * half) {
+			float *a_re = re + k, *a_im = im + k;
+			float *b_re = re + k + half, *b_im = im + k + half;
+			uint32_t j = 0;
+
+			//a, b = a + b * w, a - b * w:
+			#if defined(CONVOLVE_SSE)
+			for (; j + 4 <= half; j += 4) {
+				__m128 ar = _mm_loadu_ps(a_re + j), ai = _mm_loadu_ps(a_im + j);
+				__m128 br = _mm_loadu_ps(b_re + j), bi = _mm_loadu_ps(b_im + j);
+				__m128 wr = _mm_loadu_ps(w_re + j), wi = _mm_loadu_ps(w_im + j);
+				__m128 tr = _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+				__m128 ti = _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+				_mm_storeu_ps(a_re + j, _mm_add_ps(ar, tr));
+				_mm_storeu_ps(a_im + j, _mm_add_ps(ai, ti));
+				_mm_storeu_ps(b_re + j, _mm_sub_ps(ar, tr));
+				_mm_storeu_ps(b_im + j, _mm_sub_ps(ai, ti));
+			}
+			#elif defined(CONVOLVE_NEON)
+			for (; j + 4 <= half; j += 4) {
+				float32x4_t ar = vld1q_f32(a_re + j), ai = vld1q_f32(a_im + j);
+				float32x4_t br = vld1q_f32(b_re + j), bi = vld1q_f32(b_im + j);
+				float32x4_t wr = vld1q_f32(w_re + j), wi = vld1q_f32(w_im + j);
+				float32x4_t tr = vmlsq_f32(vmulq_f32(br, wr), bi, wi);
+				float32x4_t ti = vmlaq_f32(vmulq_f32(br, wi), bi, wr);
+				vst1q_f32(a_re + j, vaddq_f32(ar, tr));
+				vst1q_f32(a_im + j, vaddq_f32(ai, ti));
+				vst1q_f32(b_re + j, vsubq_f32(ar, tr));
+				vst1q_f32(b_im + j, vsubq_f32(ai, ti));
+			}
+			#endif
+
+			for (; j < half; ++j) {
+				float tr = b_re[j] * w_re[j] - b_im[j] * w_im[j];
+				float ti = b_re[j] * w_im[j] + b_im[j] * w_re[j];
+				b_re[j] = a_re[j] - tr;
+				b_im[j] = a_im[j] - ti;
+				a_re[j] += tr;
+				a_im[j] += ti;
+			}
+		}
+	}
+}
+
+//inverse transform (without the 1 / n scale) of a bit-reversed spectrum, back to natural order:
+// (swapping real and imaginary parts conjugates and scales by i, which turns the forward transform into the inverse)
+static void fft_inverse(float *re, float *im, uint32_t n) {
+	fft_forward_from_bit_reversed(im, re, n);
+}
+
+//multiply 'count' complex values x by h and add them to y:
+//  y_re[i] += x_re[i] * h_re[i] - x_im[i] * h_im[i]
+//  y_im[i] += x_re[i] * h_im[i] + x_im[i] * h_re[i]
+static void complex_multiply_add(float const *x_re, float const *x_im, float const *h_re, float const *h_im, uint32_t count, float *y_re, float *y_im) {
+	uint32_t i = 0;
+
+	#if defined(CONVOLVE_SSE) && defined(__AVX__)
+	for (; i + 8 <= count; i += 8) { //eight at a time:
+		__m256 xr = _mm256_loadu_ps(x_re + i), xi = _mm256_loadu_ps(x_im + i);
+		__m256 hr = _mm256_loadu_ps(h_re + i), hi = _mm256_loadu_ps(h_im + i);
+		_mm256_storeu_ps(y_re + i, _mm256_add_ps(_mm256_loadu_ps(y_re + i), _mm256_sub_ps(_mm256_mul_ps(xr, hr), _mm256_mul_ps(xi, hi))));
+		_mm256_storeu_ps(y_im + i, _mm256_add_ps(_mm256_loadu_ps(y_im + i), _mm256_add_ps(_mm256_mul_ps(xr, hi), _mm256_mul_ps(xi, hr))));
+	}
+	#endif
+
+	#if defined(CONVOLVE_SSE)
+	for (; i + 4 <= count; i += 4) { //four at a time:
+		__m128 xr = _mm_loadu_ps(x_re + i), xi = _mm_loadu_ps(x_im + i);
+		__m128 hr = _mm_loadu_ps(h_re + i), hi = _mm_loadu_ps(h_im + i);
+		_mm_storeu_ps(y_re + i, _mm_add_ps(_mm_loadu_ps(y_re + i), _mm_sub_ps(_mm_mul_ps(xr, hr), _mm_mul_ps(xi, hi))));
+		_mm_storeu_ps(y_im + i, _mm_add_ps(_mm_loadu_ps(y_im + i), _mm_add_ps(_mm_mul_ps(xr, hi), _mm_mul_ps(xi, hr))));
+	}
+	#elif defined(CONVOLVE_NEON)
+	for (; i + 4 <= count; i += 4) { //four at a time:
+		float32x4_t xr = vld1q_f32(x_re + i), xi = vld1q_f32(x_im + i);
+		float32x4_t hr = vld1q_f32(h_re + i), hi = vld1q_f32(h_im + i);
+		vst1q_f32(y_re + i, vmlsq_f32(vmlaq_f32(vld1q_f32(y_re + i), xr, hr), xi, hi));
+		vst1q_f32(y_im + i, vmlaq_f32(vmlaq_f32(vld1q_f32(y_im + i), xr, hi), xi, hr));
+	}
+	#endif
+
+	//remaining values one at a time:
+	for (; i < count; ++i) {
+		y_re[i] += x_re[i] * h_re[i] - x_im[i] * h_im[i];
+		y_im[i] += x_re[i] * h_im[i] + x_im[i] * h_re[i];
+	}
+}
+
+ConvolutionFilter::ConvolutionFilter(uint32_t block_, float const *left, float const *right, uint32_t length) : block(block_) {
+	assert(block > 0 && (block & (block - 1)) == 0 && block <= MAX_CONVOLUTION_BLOCK && "block is a power of two, in range");
+	uint32_t const n = 2 * block;
+	partitions = std::max(1U, (length + block - 1) / block);
+	spectra.assign(size_t(partitions) * 2 * n, 0.0f);
+
+	//(the inverse transform doesn't scale its output, so scale the filter instead)
+	float const scale = 1.0f / float(n);
+	for (uint32_t p = 0; p < partitions; ++p) {
+		float *re = &spectra[size_t(p) * 2 * n];
+		float *im = re + n;
+		//partition p, followed by block zeros (so each output sample only sees input from the last two frames):
+		for (uint32_t j = 0; j < block && p * block + j < length; ++j) {
+			re[j] = left[p * block + j] * scale;
+			im[j] = (right ? right[p * block + j] * scale : 0.0f);
+		}
+		fft_forward(re, im, n);
+	}
+}
+
+Convolver::Convolver(uint32_t block_, uint32_t max_partitions_) : block(block_), max_partitions(std::max(1U, max_partitions_)) {
+	assert(block > 0 && (block & (block - 1)) == 0 && block <= MAX_CONVOLUTION_BLOCK && "block is a power of two, in range");
+	uint32_t const n = 2 * block;
+	input.assign(2 * n, 0.0f);
+	history.assign(size_t(max_partitions) * 2 * n, 0.0f);
+	tail.assign(2 * n, 0.0f);
+	fading_tail.assign(2 * n, 0.0f);
+	work.assign(2 * 2 * n, 0.0f);
+	twiddles(); //(so the first process() call doesn't build the table)
+}
+
+void Convolver::reset() {
+	fill = 0;
+	newest = 0;
+	filter = nullptr;
+	fading = nullptr;
+	std::fill(input.begin(), input.end(), 0.0f);
+	std::fill(history.begin(), history.end(), 0.0f);
+}
+
+void Convolver::start_frame(ConvolutionFilter const &next) {
+	uint32_t const n = 2 * block;
+
+	//(a fresh convolver has no old output to fade from)
+	fading = (filter && filter != &next ? filter : nullptr);
+	filter = &next;
+	newest = (newest + 1) % max_partitions;
+
+	//the older frames' part of this frame's output:
+	auto sum_tail = [&](ConvolutionFilter const &f, std::vector< float > &sum) {
+		std::fill(sum.begin(), sum.end(), 0.0f);
+		uint32_t partitions = std::min(f.partitions, max_partitions);
+		for (uint32_t k = 1; k < partitions; ++k) {
+			float const *x = &history[size_t((newest + max_partitions - k) % max_partitions) * 2 * n];
+			float const *h = &f.spectra[size_t(k) * 2 * n];
+			complex_multiply_add(x, x + n, h, h + n, n, sum.data(), sum.data() + n);
+		}
+	};
+	sum_tail(*filter, tail);
+	if (fading) sum_tail(*fading, fading_tail);
+}
+
+void Convolver::process(ConvolutionFilter const &next, float const *in, uint32_t count, float *out) {
+	assert(next.block == block && "filter has the same partition size as the convolver");
+	if (fill + count > block) {
+		//(finish this frame, then go on to the next)
+		uint32_t first = block - fill;
+		process(next, in, first, out);
+		process(next, in + 2 * first, count - first, out + 2 * first);
+		return;
+	}
+	if (count == 0) return;
+	uint32_t const n = 2 * block;
+	if (fill == 0) start_frame(next);
+
+	//add the new samples to the current frame:
+	float *in_re = input.data();
+	float *in_im = in_re + n;
+	for (uint32_t j = 0; j < count; ++j) {
+		in_re[block + fill + j] = in[2 * j + 0];
+		in_im[block + fill + j] = in[2 * j + 1];
+	}
+
+	//transform the previous frame and the current one (so far) into the current frame's spot in history:
+	float *x = &history[size_t(newest) * 2 * n];
+	std::memcpy(x, input.data(), 2 * n * sizeof(float));
+	fft_forward(x, x + n, n);
+
+	//output is the older frames' part plus this frame times the first partition, transformed back:
+	auto output = [&](ConvolutionFilter const &f, std::vector< float > const &sum, float *y) {
+		std::memcpy(y, sum.data(), 2 * n * sizeof(float));
+		complex_multiply_add(x, x + n, f.spectra.data(), f.spectra.data() + n, n, y, y + n);
+		fft_inverse(y, y + n, n);
+	};
+	//(only the second half of the result -- the current frame -- is valid; the first half wraps around)
+	float *y = work.data();
+	output(*filter, tail, y);
+	float const *y_re = y + block + fill;
+	float const *y_im = y + n + block + fill;
+	if (!fading) {
+		for (uint32_t j = 0; j < count; ++j) {
+			out[2 * j + 0] += y_re[j];
+			out[2 * j + 1] += y_im[j];
+		}
+	} else {
+		float *z = work.data() + 2 * n;
+		output(*fading, fading_tail, z);
+		float const *z_re = z + block + fill;
+		float const *z_im = z + n + block + fill;
+		float const step = 1.0f / float(block);
+		for (uint32_t j = 0; j < count; ++j) {
+			float t = float(fill + j) * step;
+			out[2 * j + 0] += z_re[j] + t * (y_re[j] - z_re[j]);
+			out[2 * j + 1] += z_im[j] + t * (y_im[j] - z_im[j]);
+		}
+	}
+
+	fill += count;
+	if (fill == block) {
+		//frame is done; it becomes the previous frame:
+		fill = 0;
+		std::memcpy(in_re, in_re + block, block * sizeof(float));
+		std::memcpy(in_im, in_im + block, block * sizeof(float));
+		std::fill(in_re + block, in_re + n, 0.0f);
+		std::fill(in_im + block, in_im + n, 0.0f);
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+/*
+ * Uniformly partitioned FFT convolution, used by the mixer in Sound.cpp for
+ *  HRTF (binaural) rendering of 3D samples and for impulse-response reverb.
+ *
+ * A ConvolutionFilter splits an impulse response into partitions of 'block'
+ *  samples and transforms each (zero-padded to 2 * block points) up front.
+ * A Convolver transforms its input a frame ('block' samples) at a time into
+ *  a frequency-domain delay line; each output frame is the sum of the recent
+ *  input frames times the matching partitions, transformed back
+ *  (overlap-save). The older frames' part of the sum is computed once per
+ *  frame and the newest frame's on every call, so a frame may arrive in
+ *  several pieces and there is no added latency.
+ *
+ * Signals are interleaved stereo (LRLR...) treated as complex numbers
+ *  (left + i * right), so one complex transform handles both channels:
+ *  mono input (right == 0) convolved with a stereo response gives both ears
+ *  at once (HRTF); stereo input convolved with a mono response (right == 0)
+ *  filters each channel (reverb).
+ *
+ * The transforms and the complex multiply-accumulate use SSE (AVX for the
+ *  latter, if the compiler is allowed to use it) on x86-64, NEON on 64-bit
+ *  ARM, and plain loops elsewhere.
+ *
+ */
+
+#include <cstdint>
+#include <vector>
+
+//largest partition size (so transforms are at most 2 * MAX_CONVOLUTION_BLOCK points):
+constexpr uint32_t const MAX_CONVOLUTION_BLOCK = 4096;
+
+struct ConvolutionFilter {
+	//split 'length' samples of 'left' and 'right' responses (right may be null, for a mono response)
+	// into partitions of 'block' (a power of two) samples:
+	ConvolutionFilter(uint32_t block, float const *left, float const *right, uint32_t length);
+
+	uint32_t block;
+	uint32_t partitions;
+	//'partitions' spectra of 2 * block bins (real parts, then imaginary parts; in bit-reversed order, and scaled by 1 / (2 * block)):
+	std::vector< float > spectra;
+};
+
+struct Convolver {
+	//state for filtering by responses of up to 'max_partitions' partitions of 'block' samples
+	// (all allocated here, so process() never allocates):
+	Convolver(uint32_t block, uint32_t max_partitions);
+
+	//forget past input (as if it had been silent):
+	void reset();
+
+	//filter 'count' more interleaved stereo samples from 'in' by 'filter', adding the result into interleaved stereo 'out':
+	// a new filter takes effect at the start of the next frame (so right away if every call is a whole frame),
+	// crossfading from the old filter's output over that frame; partitions past max_partitions are ignored.
+	void process(ConvolutionFilter const &filter, float const *in, uint32_t count, float *out);
+
+	uint32_t block;
+	uint32_t max_partitions;
+	uint32_t fill = 0; //samples of the current frame so far
+	uint32_t newest = 0; //slot in 'history' of the current frame
+	ConvolutionFilter const *filter = nullptr; //filter for the current frame...
+	ConvolutionFilter const *fading = nullptr; //...and the one being crossfaded from (if changing)
+
+	//(each of these is 2 * block complex values, stored as real parts then imaginary parts)
+	std::vector< float > input; //the previous frame, then the current frame (zero past 'fill')
+	std::vector< float > history; //spectra of the last max_partitions frames (a ring)
+	std::vector< float > tail, fading_tail; //sums of older frames' spectra times the partitions of 'filter' (and 'fading')
+	std::vector< float > work; //(scratch: two outputs)
+
+private:
+	void start_frame(ConvolutionFilter const &next);
+};
@@ -0,0 +1,199 @@
+#include "gl_debug_output.hpp"
+
+#include <SDL.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//(from KHR_debug / ARB_debug_output)
+#define GL_DEBUG_OUTPUT                   0x92E0
+#define GL_DEBUG_OUTPUT_SYNCHRONOUS       0x8242
+#define GL_DEBUG_SOURCE_API               0x8246
+#define GL_DEBUG_SOURCE_WINDOW_SYSTEM     0x8247
+#define GL_DEBUG_SOURCE_SHADER_COMPILER   0x8248
+#define GL_DEBUG_SOURCE_THIRD_PARTY       0x8249
+#define GL_DEBUG_SOURCE_APPLICATION       0x824A
+#define GL_DEBUG_TYPE_ERROR               0x824C
+#define GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR 0x824D
+#define GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR  0x824E
+#define GL_DEBUG_TYPE_PORTABILITY         0x824F
+#define GL_DEBUG_TYPE_PERFORMANCE         0x8250
+#define GL_DEBUG_SEVERITY_HIGH            0x9146
+#define GL_DEBUG_SEVERITY_MEDIUM          0x9147
+#define GL_DEBUG_SEVERITY_LOW             0x9148
+#define GL_DEBUG_SEVERITY_NOTIFICATION    0x826B
+#define GL_CONTEXT_FLAG_DEBUG_BIT         0x00000002
+
+bool gl_debug_output_active = false;
+
+namespace {
+	//entry points (looked up at runtime, since they aren't part of OpenGL 3.3):
+	typedef void (APIENTRY *DebugProc)(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const *message, void const *user);
+	void (APIENTRY *DebugMessageCallback)(DebugProc callback, void const *user) = nullptr;
+	void (APIENTRY *DebugMessageControl)(GLenum source, GLenum type, GLenum severity, GLsizei count, GLuint const *ids, GLboolean enabled) = nullptr;
+	void (APIENTRY *ObjectLabel)(GLenum identifier, GLuint name, GLsizei length, GLchar const *label) = nullptr;
+
+	struct Message {
+		GLenum source = 0;
+		GLenum type = 0;
+		GLuint id = 0;
+		GLenum severity = 0;
+		std::string text;
+		uint32_t repeats = 1; //(the same message received again in a row is counted rather than queued)
+	};
+
+	//messages waiting to be printed by gl_debug_output_poll (the callback may run on a driver thread):
+	std::mutex pending_mutex;
+	std::vector< Message > pending;
+	uint32_t dropped = 0; //messages not queued because 'pending' was full
+	constexpr uint32_t const MAX_PENDING = 64;
+
+	bool synchronous = false; //set from GL_DEBUG_SYNC
+
+	char const *source_name(GLenum source) {
+		switch (source) {
+			case GL_DEBUG_SOURCE_API: return "api";
+			case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+			case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+			case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+			case GL_DEBUG_SOURCE_APPLICATION: return "application";
+			default: return "other";
+		}
+	}
+
+	char const *type_name(GLenum type) {
+		switch (type) {
+			case GL_DEBUG_TYPE_ERROR: return "error";
+			case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated behavior";
+			case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+			case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+			case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+			default: return "message";
+		}
+	}
+
+	char const *severity_name(GLenum severity) {
+		switch (severity) {
+			case GL_DEBUG_SEVERITY_HIGH: return "high";
+			case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+			case GL_DEBUG_SEVERITY_LOW: return "low";
+			default: return "notification";
+		}
+	}
+
+	void print(Message const &message, char const *where) {
+		//errors and high-severity messages are warnings; anything else (performance hints, etc) is a note:
+		bool warning = (message.type == GL_DEBUG_TYPE_ERROR || message.type == GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR || message.severity == GL_DEBUG_SEVERITY_HIGH);
+		std::cerr << (warning ? "WARNING: gl " : "NOTE: gl ") << type_name(message.type)
+		          << " (" << source_name(message.source) << ", " << severity_name(message.severity) << ", id " << message.id << "): "
+		          << message.text;
+		if (message.repeats > 1) std::cerr << " [x" << message.repeats << "]";
+		if (where) std::cerr << " -- noticed at " << where;
+		std::cerr << std::endl;
+	}
+
+	void APIENTRY callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const *text, void const *) {
+		Message message;
+		message.source = source;
+		message.type = type;
+		message.id = id;
+		message.severity = severity;
+		message.text = (length < 0 ? std::string(text) : std::string(text, length));
+		//(drivers often end messages with a newline)
+		while (!message.text.empty() && (message.text.back() == '\n' || message.text.back() == ' ')) message.text.pop_back();
+
+		if (synchronous) {
+			//called from inside the offending gl* call, so report right away:
+			print(message, nullptr);
+			return;
+		}
+
+		std::lock_guard< std::mutex > lock(pending_mutex);
+		if (!pending.empty()) {
+			Message &last = pending.back();
+			if (last.source == source && last.type == type && last.id == id && last.text == message.text) {
+				last.repeats += 1;
+				return;
+			}
+		}
+		if (pending.size() >= MAX_PENDING) {
+			dropped += 1;
+			return;
+		}
+		pending.emplace_back(std::move(message));
+	}
+}
+
+bool gl_debug_output_init() {
+	//KHR_debug (core in OpenGL 4.3, widely available as an extension before that) or its older ARB version:
+	bool khr = SDL_GL_ExtensionSupported("GL_KHR_debug");
+	if (khr) {
+		DebugMessageCallback = (decltype(DebugMessageCallback))SDL_GL_GetProcAddress("glDebugMessageCallback");
+		DebugMessageControl = (decltype(DebugMessageControl))SDL_GL_GetProcAddress("glDebugMessageControl");
+		ObjectLabel = (decltype(ObjectLabel))SDL_GL_GetProcAddress("glObjectLabel");
+	} else if (SDL_GL_ExtensionSupported("GL_ARB_debug_output")) {
+		DebugMessageCallback = (decltype(DebugMessageCallback))SDL_GL_GetProcAddress("glDebugMessageCallbackARB");
+		DebugMessageControl = (decltype(DebugMessageControl))SDL_GL_GetProcAddress("glDebugMessageControlARB");
+	}
+	if (!DebugMessageCallback) {
+		DebugMessageControl = nullptr;
+		ObjectLabel = nullptr;
+		return false;
+	}
+
+	//outside a debug context, drivers may report few (or no) errors through the callback, so leave GL_ERRORS() calling glGetError:
+	// (object labels are still set, for tools like RenderDoc)
+	GLint flags = 0;
+	glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+	if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT)) {
+		std::cerr << "NOTE: OpenGL context isn't a debug context, so not using its debug message callback." << std::endl;
+		DebugMessageCallback = nullptr;
+		DebugMessageControl = nullptr;
+		return false;
+	}
+
+	synchronous = (std::getenv("GL_DEBUG_SYNC") != nullptr);
+
+	if (khr) glEnable(GL_DEBUG_OUTPUT); //(ARB_debug_output is always on in debug contexts)
+	if (synchronous) glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	else glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+
+	//skip notifications (e.g., "buffer will use video memory"), which some drivers send constantly:
+	// (ARB_debug_output has no notification severity)
+	if (khr && DebugMessageControl) {
+		DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+	}
+
+	DebugMessageCallback(callback, nullptr);
+	gl_debug_output_active = true;
+	return true;
+}
+
+void gl_debug_output_poll(char const *where) {
+	if (!gl_debug_output_active) return;
+
+	std::vector< Message > messages;
+	uint32_t dropped_messages = 0;
+	{ //(swap out the queue so printing happens without holding the lock)
+		std::lock_guard< std::mutex > lock(pending_mutex);
+		if (pending.empty() && dropped == 0) return;
+		messages.swap(pending);
+		pending.reserve(messages.capacity());
+		dropped_messages = dropped;
+		dropped = 0;
+	}
+
+	for (auto const &message : messages) {
+		print(message, where);
+	}
+	if (dropped_messages) {
+		std::cerr << "WARNING: " << dropped_messages << " more gl debug messages were dropped." << std::endl;
+	}
+}
+
+void gl_label(GLenum identifier, GLuint name, char const *label) {
+	if (ObjectLabel) ObjectLabel(identifier, name, -1, label);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+/*
+ * Debug message callback (KHR_debug, or ARB_debug_output) for reporting OpenGL errors
+ *  without the CPU/GPU sync of calling glGetError.
+ *
+ * gl_debug_output_init() installs the callback if the context supports it and is
+ *  a debug context (it is created with SDL_GL_CONTEXT_DEBUG_FLAG, but drivers may
+ *  ignore that; outside a debug context, GL_ERRORS() keeps calling glGetError,
+ *  since the driver may not report errors otherwise). The driver may call it from
+ *  any thread and at any time after the offending call, so messages are queued and
+ *  printed later by gl_debug_output_poll() (which GL_ERRORS() also calls; see gl_errors.hpp).
+ *
+ * Set the GL_DEBUG_SYNC environment variable to have messages reported synchronously
+ *  instead (printed from inside the offending call, so a breakpoint in the callback
+ *  shows the call stack; slower).
+ *
+ * Objects named with gl_label() show up by name in messages (with KHR_debug).
+ *
+ */
+
+#include "GL.hpp"
+
+//(object types for gl_label; from KHR_debug, which is newer than the OpenGL 3.3 in GL.hpp)
+#ifndef GL_BUFFER
+#define GL_BUFFER 0x82E0
+#endif
+#ifndef GL_SHADER
+#define GL_SHADER 0x82E1
+#endif
+#ifndef GL_PROGRAM
+#define GL_PROGRAM 0x82E2
+#endif
+#ifndef GL_VERTEX_ARRAY
+#define GL_VERTEX_ARRAY 0x8074
+#endif
+
+//true once gl_debug_output_init() has installed the callback:
+extern bool gl_debug_output_active;
+
+//install the message callback, if KHR_debug or ARB_debug_output is available in a debug context; returns true if it was:
+bool gl_debug_output_init();
+
+//print (to std::cerr) any messages received since the last call; 'where' (if given) is mentioned as where they were noticed:
+void gl_debug_output_poll(char const *where = nullptr);
+
+//name an object (GL_BUFFER, GL_SHADER, GL_PROGRAM, GL_VERTEX_ARRAY, GL_TEXTURE, ...) in debug messages:
+// (does nothing without KHR_debug)
+void gl_label(GLenum identifier, GLuint name, char const *label);
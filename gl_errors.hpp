@@ -1,12 +1,25 @@
 #pragma once
 
 #include "GL.hpp"
+#include "gl_debug_output.hpp"
 #include <iostream>
 
 #define STR2(X) # X
 #define STR(X) STR2(X)
 
-inline void gl_errors(std::string const &where) {
+//GL_ERRORS() reports OpenGL errors (with the file and line it was called from):
+// - if a debug message callback is installed (see gl_debug_output.hpp), it prints any messages
+//   the driver has sent so far -- this doesn't wait for the GPU;
+// - otherwise, it calls glGetError, which does (so use it sparingly in per-frame code).
+//When GL_NO_ERRORS is defined (set GL_NO_ERRORS in Maekfile.js), GL_ERRORS() compiles to nothing;
+// messages from the callback are still printed once per frame (see main.cpp).
+
+inline void gl_errors(char const *where) {
+	if (gl_debug_output_active) {
+		gl_debug_output_poll(where);
+		return;
+	}
+
 	GLenum err = 0;
 	while ((err = glGetError()) != GL_NO_ERROR) {
 		#define CHECK( ERR ) \
@@ -27,5 +40,9 @@ inline void gl_errors(std::string const &where) {
 		#undef CHECK
 	}
 }
-#define GL_ERRORS() gl_errors(__FILE__  ":" STR(__LINE__) )
 
+#ifdef GL_NO_ERRORS
+#define GL_ERRORS() do { } while (0)
+#else
+#define GL_ERRORS() gl_errors(__FILE__  ":" STR(__LINE__) )
+#endif
@@ -0,0 +1,143 @@
+#include "ima_adpcm.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+//tables from the IMA ADPCM specification:
+static constexpr int16_t const step_table[89] = {
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+	19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+	130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+	337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+	876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+	2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+	5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static constexpr int8_t const index_table[16] = {
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+//the effect of every (step index, nibble) pair on the decoder state is precomputed, so decoding a sample is two lookups:
+struct DecodeTables {
+	constexpr DecodeTables() {
+		for (int32_t index = 0; index < 89; ++index) {
+			for (int32_t nibble = 0; nibble < 16; ++nibble) {
+				int32_t s = step_table[index];
+				int32_t d = s >> 3;
+				if (nibble & 4) d += s;
+				if (nibble & 2) d += s >> 1;
+				if (nibble & 1) d += s >> 2;
+				if (nibble & 8) d = -d;
+				diff[index][nibble] = d;
+				int32_t next = index + index_table[nibble];
+				next_index[index][nibble] = uint8_t(next < 0 ? 0 : (next > 88 ? 88 : next));
+			}
+		}
+	}
+	int32_t diff[89][16] = {};
+	uint8_t next_index[89][16] = {};
+};
+static constexpr DecodeTables const tables;
+
+//decoder state update (shared by encoder and decoder, so they stay in sync):
+static inline float decode_nibble(uint32_t nibble, int32_t *predictor, uint32_t *index) {
+	*predictor = std::max(-32768, std::min(32767, *predictor + tables.diff[*index][nibble]));
+	*index = tables.next_index[*index][nibble];
+	return float(*predictor) * (1.0f / 32768.0f);
+}
+
+void ima_adpcm_encode(float const *src, size_t count, std::vector< uint8_t > *blocks_) {
+	assert(blocks_);
+	auto &blocks = *blocks_;
+	size_t block_count = (count + IMA_ADPCM_BLOCK_SAMPLES - 1) / IMA_ADPCM_BLOCK_SAMPLES;
+	blocks.assign(block_count * IMA_ADPCM_BLOCK_BYTES, 0);
+
+	auto to_int16 = [](float f) -> int32_t {
+		return int32_t(std::max(-32768.0f, std::min(32767.0f, std::round(f * 32768.0f))));
+	};
+
+	//step index is carried over between blocks (since the signal's level usually is too);
+	// start it near the typical change between samples at the beginning of the signal, rather than adapting up from the smallest step:
+	uint32_t index = 0;
+	{
+		int32_t total = 0;
+		size_t n = std::min< size_t >(count, IMA_ADPCM_BLOCK_SAMPLES);
+		for (size_t i = 1; i < n; ++i) {
+			total += std::abs(to_int16(src[i]) - to_int16(src[i-1]));
+		}
+		int32_t typical = (n > 1 ? total / int32_t(n - 1) : 0);
+		while (index < 88 && step_table[index] < typical) ++index;
+	}
+	for (size_t b = 0; b < block_count; ++b) {
+		uint8_t *block = blocks.data() + b * IMA_ADPCM_BLOCK_BYTES;
+		size_t begin = b * IMA_ADPCM_BLOCK_SAMPLES;
+
+		//start each block exactly on its first sample, so error doesn't carry across blocks:
+		int32_t predictor = to_int16(src[begin]);
+		block[0] = uint8_t(predictor & 0xff);
+		block[1] = uint8_t((predictor >> 8) & 0xff);
+		block[2] = uint8_t(index);
+
+		for (uint32_t s = 0; s < IMA_ADPCM_BLOCK_SAMPLES; ++s) {
+			//(pad the last block by repeating the final sample)
+			int32_t target = to_int16(src[std::min(begin + s, count - 1)]);
+
+			//pick the nibble whose reconstruction best approximates target:
+			int32_t diff = target - predictor;
+			int32_t st = step_table[index];
+			uint8_t nibble = 0;
+			if (diff < 0) {
+				nibble = 8;
+				diff = -diff;
+			}
+			if (diff >= st) { nibble |= 4; diff -= st; }
+			st >>= 1;
+			if (diff >= st) { nibble |= 2; diff -= st; }
+			st >>= 1;
+			if (diff >= st) { nibble |= 1; }
+
+			decode_nibble(nibble, &predictor, &index);
+			block[4 + s / 2] |= uint8_t(nibble << ((s & 1) * 4));
+		}
+	}
+}
+
+void ima_adpcm_decode(uint8_t const *blocks, size_t first, uint32_t count, float *dst) {
+	size_t b = first / IMA_ADPCM_BLOCK_SAMPLES;
+	uint32_t skip = uint32_t(first % IMA_ADPCM_BLOCK_SAMPLES);
+	//n.b. each sample depends on the one before, so this part is inherently serial:
+	while (count > 0) {
+		uint8_t const *block = blocks + b * IMA_ADPCM_BLOCK_BYTES;
+		int32_t predictor = int16_t(uint16_t(block[0]) | (uint16_t(block[1]) << 8));
+		uint32_t index = std::min< uint32_t >(block[2], 88);
+		uint32_t end = std::min(IMA_ADPCM_BLOCK_SAMPLES, skip + count);
+
+		uint32_t s = 0;
+		//samples before 'skip' only update the decoder state:
+		for (; s < skip; ++s) {
+			decode_nibble((block[4 + s / 2] >> ((s & 1) * 4)) & 0xf, &predictor, &index);
+		}
+		//(if starting on an odd sample, do it separately so the main loop can take a byte at a time)
+		if ((s & 1) && s < end) {
+			*(dst++) = decode_nibble(block[4 + s / 2] >> 4, &predictor, &index);
+			++s;
+		}
+		for (; s + 2 <= end; s += 2) {
+			uint8_t byte = block[4 + s / 2];
+			dst[0] = decode_nibble(byte & 0xf, &predictor, &index);
+			dst[1] = decode_nibble(byte >> 4, &predictor, &index);
+			dst += 2;
+		}
+		if (s < end) {
+			*(dst++) = decode_nibble(block[4 + s / 2] & 0xf, &predictor, &index);
+		}
+
+		count -= end - skip;
+		skip = 0;
+		b += 1;
+	}
+}
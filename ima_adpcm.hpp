@@ -0,0 +1,19 @@
+#pragma once
+
+//IMA ADPCM (4 bits per sample) encoding for in-memory sample storage.
+//Samples are grouped into independent blocks -- each starting with the decoder state --
+// so decoding can begin at any block (e.g., when a voice loops or resumes mid-sample).
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+constexpr uint32_t const IMA_ADPCM_BLOCK_SAMPLES = 64;
+//block layout: int16 predictor (little-endian), uint8 step index, uint8 unused, then one nibble per sample (low nibble first):
+constexpr uint32_t const IMA_ADPCM_BLOCK_BYTES = 4 + IMA_ADPCM_BLOCK_SAMPLES / 2;
+
+//encode 'count' samples (in [-1,1]) into (count + IMA_ADPCM_BLOCK_SAMPLES - 1) / IMA_ADPCM_BLOCK_SAMPLES blocks:
+void ima_adpcm_encode(float const *src, size_t count, std::vector< uint8_t > *blocks);
+
+//decode samples [first, first + count) from 'blocks' into 'dst':
+void ima_adpcm_decode(uint8_t const *blocks, size_t first, uint32_t count, float *dst);
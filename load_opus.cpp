@@ -1,14 +1,123 @@
 #include "load_opus.hpp"
+#include "StartupProfile.hpp"
+#include "mix_kernels.hpp"
 
 #include <opusfile.h>
 
+#include <algorithm>
 #include <cassert>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <cmath>
 #include <stdexcept>
 #include <iostream>
+#include <thread>
 
-void load_opus(std::string const &filename, std::vector< float > *data_) {
+//long files are decoded in parallel, in segments of at least this many samples:
+static constexpr ogg_int64_t const MIN_SEGMENT = 5 * 48000;
+
+//decodes samples [begin, end) of an opened file into 'out':
+// (op_pcm_seek is sample-exact, so adjacent ranges decoded by different OggOpusFiles meet without gaps or overlaps)
+static void decode_range(OggOpusFile *op, std::string const &filename, ogg_int64_t begin, ogg_int64_t end, float *out) {
+	if (begin != 0) {
+		int err = op_pcm_seek(op, begin);
+		if (err != 0) {
+			throw std::runtime_error("opusfile error " + std::to_string(err) + " seeking to sample " + std::to_string(begin) + " of \"" + filename + "\".");
+		}
+	}
+
+	std::vector< float > pcm(2*5760); //(opusfile returns at most one packet -- 120ms -- per read)
+	for (ogg_int64_t at = begin; at < end; /* later */) {
+		int ret = op_read_float_stereo(op, pcm.data(), int(std::min< ogg_int64_t >(pcm.size(), 2 * (end - at))));
+		if (ret < 0) {
+			throw std::runtime_error("opusfile read error " + std::to_string(ret) + " reading \"" + filename + "\".");
+		} else if (ret == 0) {
+			throw std::runtime_error("\"" + filename + "\" ended at sample " + std::to_string(at) + " but claimed to be " + std::to_string(end) + " samples long.");
+		}
+		//positive return values are the number of samples read per channel; downmix to mono by averaging:
+		downmix_stereo_to_mono(pcm.data(), uint32_t(ret), out + (at - begin));
+		at += ret;
+	}
+}
+
+//shared by both versions of load_opus; reads samples (up to max_samples) from an opened file:
+// 'open_another' opens another OggOpusFile for the same data (so segments can be decoded in parallel).
+static void decode_opus(OggOpusFile *op, std::function< OggOpusFile *() > const &open_another, std::string const &filename, std::vector< float > *data_, size_t max_samples) {
+	assert(op);
+	assert(data_);
+	auto &data = *data_;
+
+	//(compressed size; returns a negative error code if unknown)
+	ogg_int64_t raw_size = op_raw_total(op, -1);
+	if (raw_size > 0) StartupProfile::note_bytes_read(size_t(raw_size));
+
+	//get length in samples:
+	ogg_int64_t length = op_pcm_total(op, -1);
+	if (length >= 0) {
+		if (uint64_t(length) > max_samples) length = ogg_int64_t(max_samples);
+		data.resize(size_t(length));
+
+		//split into segments, one per thread:
+		uint32_t segments = std::max(1U, std::min(std::thread::hardware_concurrency(), uint32_t(length / MIN_SEGMENT)));
+		if (segments == 1) {
+			decode_range(op, filename, 0, length, data.data());
+			return;
+		}
+
+		//thread s decodes samples [bounds[s], bounds[s+1]), each with its own OggOpusFile:
+		std::vector< ogg_int64_t > bounds(segments + 1);
+		for (uint32_t s = 0; s <= segments; ++s) {
+			bounds[s] = length * s / segments;
+		}
+		std::vector< std::exception_ptr > errors(segments);
+		std::vector< std::thread > threads;
+		for (uint32_t s = 1; s < segments; ++s) {
+			threads.emplace_back([&,s](){
+				try {
+					std::unique_ptr< OggOpusFile, decltype(&op_free) > segment_op(open_another(), op_free);
+					decode_range(segment_op.get(), filename, bounds[s], bounds[s+1], data.data() + bounds[s]);
+				} catch (...) {
+					errors[s] = std::current_exception();
+				}
+			});
+		}
+		//(this thread decodes the first segment using the already-open file)
+		try {
+			decode_range(op, filename, bounds[0], bounds[1], data.data());
+		} catch (...) {
+			errors[0] = std::current_exception();
+		}
+		for (auto &thread : threads) {
+			thread.join();
+		}
+		for (auto const &error : errors) {
+			if (error) std::rethrow_exception(error);
+		}
+		return;
+	}
+
+	//length unknown, so decode sequentially and grow 'data' as needed:
+	std::cerr << "WARNING: cannot estimate length of '" << filename << "', loading may be slow." << std::endl;
+	data.reserve(2*48000);
+
+	std::vector< float > pcm(2*5760);
+	while (data.size() < max_samples) {
+		int ret = op_read_float_stereo(op, pcm.data(), int(pcm.size()));
+		if (ret < 0) {
+			throw std::runtime_error("opusfile read error " + std::to_string(ret) + " reading \"" + filename + "\".");
+		} else if (ret == 0) {
+			break;
+		}
+		//positive return values are the number of samples read per channel; downmix into data:
+		size_t at = data.size();
+		ret = int(std::min(size_t(ret), max_samples - at));
+		data.resize(at + ret);
+		downmix_stereo_to_mono(pcm.data(), uint32_t(ret), data.data() + at);
+	}
+}
+
+void load_opus(std::string const &filename, std::vector< float > *data_, size_t max_samples) {
 	assert(data_);
 	auto &data = *data_;
 	data.clear();
@@ -25,30 +134,49 @@ void load_opus(std::string const &filename, std::vector< float > *data_) {
 		throw std::runtime_error("opusfile error " + std::to_string(err) + " opening \"" + filename + "\".");
 	}
 
-	//get length in samples:
-	ogg_int64_t length = op_pcm_total(op.get(), -1);
-	if (length >= 0) {
-		data.reserve(length);
-	} else {
-		std::cerr << "WARNING: cannot estimate length of '" << filename << "', loading may be slow." << std::endl;
-		length = 0;
-		data.reserve(2*48000);
+	auto open_another = [&filename]() -> OggOpusFile * {
+		int err = 0;
+		OggOpusFile *another = op_open_file(filename.c_str(), &err);
+		if (err != 0) {
+			if (another) op_free(another);
+			throw std::runtime_error("opusfile error " + std::to_string(err) + " re-opening \"" + filename + "\".");
+		}
+		return another;
+	};
+
+	decode_opus(op.get(), open_another, filename, &data, max_samples);
+
+	std::cout << " done." << std::endl;
+}
+
+void load_opus(ByteSpan const &bytes, std::string const &name, std::vector< float > *data_, size_t max_samples) {
+	assert(data_);
+	auto &data = *data_;
+	data.clear();
+
+	std::cout << "loading '" << name << "' (from memory)..."; std::cout.flush();
+
+	//n.b. opusfile reads directly from 'bytes' (no copy), so they must outlive 'op':
+	int err = 0;
+	std::unique_ptr< OggOpusFile, decltype(&op_free) > op(
+		op_open_memory(bytes.data, bytes.size, &err),
+		op_free
+	);
+	if (err != 0) {
+		throw std::runtime_error("opusfile error " + std::to_string(err) + " opening \"" + name + "\" from memory.");
 	}
 
-	std::vector< float > pcm(2*48000*2, 0.0f); //seems like reads are generally 960 samples so this is definitely overkill
-	for (;;) {
-		int ret = op_read_float_stereo(op.get(), pcm.data(), int(pcm.size()));
-		if (ret >= 0) {
-			//positive return values are the number of samples read per channel; copy into data:
-			data.reserve(data.size() + ret);
-			for (uint32_t i = 0; i < uint32_t(ret); ++i) {
-				data.emplace_back((pcm[2*i] + pcm[2*i+1]) * 0.5f); //downmix to mono by averaging
-			}
-			if (ret == 0) break;
-		} else {
-			throw std::runtime_error("opusfile read error " + std::to_string(ret) + " reading \"" + filename + "\".");
+	auto open_another = [&bytes, &name]() -> OggOpusFile * {
+		int err = 0;
+		OggOpusFile *another = op_open_memory(bytes.data, bytes.size, &err);
+		if (err != 0) {
+			if (another) op_free(another);
+			throw std::runtime_error("opusfile error " + std::to_string(err) + " re-opening \"" + name + "\" from memory.");
 		}
-	}
+		return another;
+	};
+
+	decode_opus(op.get(), open_another, name, &data, max_samples);
 
 	std::cout << " done." << std::endl;
 }
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "ByteSpan.hpp"
+
 #include <string>
 #include <vector>
 
 //Load an opus file as 48kHz floating-point mono; throws on error:
-void load_opus(std::string const &filename, std::vector< float > *data);
+//  (if 'max_samples' is given, stops after that many samples -- e.g., to load the start of a streamed file)
+void load_opus(std::string const &filename, std::vector< float > *data, size_t max_samples = -1);
+
+//Load opus file contents already in memory; 'name' is used in messages:
+void load_opus(ByteSpan const &bytes, std::string const &name, std::vector< float > *data, size_t max_samples = -1);
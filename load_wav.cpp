@@ -1,50 +1,220 @@
 #include "load_wav.hpp"
-
-#include <SDL.h>
+#include "StartupProfile.hpp"
+#include "resample.hpp"
+#include "mix_kernels.hpp"
 
 #include <iostream>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
 #include <algorithm>
 
 constexpr uint32_t AUDIO_RATE = 48000;
 
-void load_wav(std::string const &filename, std::vector< float > *data_) {
-	assert(data_);
-	auto &data = *data_;
-
-	SDL_AudioSpec audio_spec;
-	Uint8 *audio_buf = nullptr;
-	Uint32 audio_len = 0;
-
-	SDL_AudioSpec *have = SDL_LoadWAV(filename.c_str(), &audio_spec, &audio_buf, &audio_len);
-	if (!have) {
-		throw std::runtime_error("Failed to load WAV file '" + filename + "'; SDL says \"" + std::string(SDL_GetError()) + "\"");
-	}
-
-	//based on the SDL_AudioCVT example in the docs: https://wiki.libsdl.org/SDL_AudioCVT
-	SDL_AudioCVT cvt;
-	SDL_BuildAudioCVT(&cvt, have->format, have->channels, have->freq, AUDIO_F32SYS, 1, AUDIO_RATE);
-	if (cvt.needed) {
-		std::cout << "WAV file '" + filename + "' didn't load as " + std::to_string(AUDIO_RATE) + " Hz, float32, mono; converting." << std::endl;
-		cvt.len = audio_len;
-		cvt.buf = (Uint8 *)SDL_malloc(cvt.len * cvt.len_mult);
-		SDL_memcpy(cvt.buf, audio_buf, audio_len);
-		SDL_ConvertAudio(&cvt);
-		int final_size = cvt.len_cvt;
-		assert(final_size >= 0 && final_size <= cvt.len * cvt.len_mult && "Converted audio should fit in buffer.");
-		assert(final_size % 4 == 0 && "Converted audio should consist of 4-byte elements.");
-		data.assign(reinterpret_cast< float * >(cvt.buf), reinterpret_cast< float * >(cvt.buf + final_size));
-		SDL_free(cvt.buf);
-	} else {
-		data.assign(reinterpret_cast< float * >(audio_buf), reinterpret_cast< float * >(audio_buf + audio_len));
-	}
-	SDL_FreeWAV(audio_buf);
-
-	float min = 0.0f;
-	float max = 0.0f;
-	for (auto d : data) {
-		min = std::min(min, d);
-		max = std::max(max, d);
-	}
-	std::cout << "Range: " << min << ", " << max << std::endl;
+namespace {
+	//what a WAV file's 'fmt ' chunk says about its samples:
+	struct WavFormat {
+		bool is_float = false; //(otherwise integer PCM -- unsigned if 8 bits, signed otherwise)
+		uint32_t channels = 0;
+		uint32_t rate = 0;
+		uint32_t bits = 0; //(per sample per channel)
+		uint32_t frame_bytes = 0; //(all channels)
+		ByteSpan data; //contents of the 'data' chunk
+	};
+
+	//(WAV files are little-endian)
+	uint16_t u16(uint8_t const *b) { return uint16_t(b[0] | (b[1] << 8)); }
+	uint32_t u32(uint8_t const *b) { return uint32_t(b[0]) | (uint32_t(b[1]) << 8) | (uint32_t(b[2]) << 16) | (uint32_t(b[3]) << 24); }
+
+	//can samples in the file be used as-is? (only if this machine is little-endian, like the file)
+	bool native_byte_order() {
+		uint16_t one = 1;
+		uint8_t first;
+		std::memcpy(&first, &one, 1);
+		return first == 1;
+	}
+
+	//could the 'available' bytes at 'b' start with another chunk? (printable id, and a size that fits)
+	bool chunk_follows(uint8_t const *b, size_t available) {
+		if (available < 8) return false;
+		for (uint32_t i = 0; i < 4; ++i) {
+			if (b[i] < 0x20 || b[i] > 0x7e) return false;
+		}
+		return u32(b + 4) <= available - 8;
+	}
+
+	//find the format and samples in the chunks of a RIFF/WAVE file; throws on error:
+	WavFormat parse_wav(ByteSpan const &bytes, std::string const &name) {
+		uint8_t const *b = bytes.data;
+		if (bytes.size < 12 || std::memcmp(b, "RIFF", 4) != 0 || std::memcmp(b + 8, "WAVE", 4) != 0) {
+			throw std::runtime_error("WAV file '" + name + "' doesn't start with a RIFF/WAVE header.");
+		}
+		//(left unset -- like the data size, see below -- by programs that write WAV files as they record)
+		bool riff_size_unset = (u32(b + 4) == 0 || u32(b + 4) == 0xffffffff);
+
+		WavFormat format;
+		bool have_format = false, have_data = false;
+		for (size_t at = 12; at + 8 <= bytes.size; /* later */) {
+			uint8_t const *chunk = b + at;
+			size_t size = u32(chunk + 4);
+			size_t available = bytes.size - (at + 8);
+			if (std::memcmp(chunk, "data", 4) == 0) {
+				//programs that write WAV files as they record sometimes leave the size unset (0 or 0xffffffff) -- or
+				// stop before writing all they said they would -- so use the rest of the file for those:
+				// (though 0 is also the size of an empty 'data' chunk, so only if nothing else says otherwise)
+				bool unset = (size == 0 && (riff_size_unset || !chunk_follows(chunk + 8, available)));
+				if (unset || size == 0xffffffff || size > available) {
+					format.data = ByteSpan(chunk + 8, available);
+					have_data = true;
+					break;
+				}
+				format.data = ByteSpan(chunk + 8, size);
+				have_data = true;
+			} else if (size > available) {
+				throw std::runtime_error("WAV file '" + name + "' is cut short (in its '" + std::string(reinterpret_cast< char const * >(chunk), 4) + "' chunk).");
+			} else if (std::memcmp(chunk, "fmt ", 4) == 0) {
+				if (size < 16) throw std::runtime_error("WAV file '" + name + "' has a 'fmt ' chunk that is too small.");
+				uint16_t tag = u16(chunk + 8);
+				format.channels = u16(chunk + 10);
+				format.rate = u32(chunk + 12);
+				format.frame_bytes = u16(chunk + 20);
+				format.bits = u16(chunk + 22);
+				//WAVE_FORMAT_EXTENSIBLE keeps the actual format in the first two bytes of its sub-format GUID:
+				if (tag == 0xfffe && size >= 40) tag = u16(chunk + 8 + 24);
+				if (tag != 1 && tag != 3) {
+					throw std::runtime_error("WAV file '" + name + "' has format " + std::to_string(tag) + "; only integer PCM (1) and float (3) are supported.");
+				}
+				format.is_float = (tag == 3);
+				have_format = true;
+			}
+			at += 8 + size + (size & 1); //(chunks are padded to an even size)
+		}
+
+		if (!have_format || !have_data) {
+			throw std::runtime_error("WAV file '" + name + "' is missing its '" + (have_format ? "data" : "fmt ") + "' chunk.");
+		}
+		bool bits_ok = (format.is_float ? (format.bits == 32 || format.bits == 64)
+		                                : (format.bits == 8 || format.bits == 16 || format.bits == 24 || format.bits == 32));
+		if (!bits_ok || format.channels == 0 || format.rate == 0 || format.frame_bytes != format.channels * (format.bits / 8)) {
+			throw std::runtime_error("WAV file '" + name + "' has an unsupported format (" + std::to_string(format.channels) + " channels of "
+				+ std::to_string(format.bits) + "-bit " + (format.is_float ? "float" : "integer") + " samples at " + std::to_string(format.rate) + " Hz).");
+		}
+		return format;
+	}
+
+	//is the file already 48kHz float32 mono?
+	bool is_native(WavFormat const &format) {
+		return format.is_float && format.bits == 32 && format.channels == 1 && format.rate == AUDIO_RATE;
+	}
+
+	//one sample (of 'format') starting at 'b' as a float in [-1,1):
+	float decode_sample(WavFormat const &format, uint8_t const *b) {
+		if (format.is_float) {
+			if (format.bits == 32) {
+				uint32_t bits = u32(b);
+				float f;
+				std::memcpy(&f, &bits, sizeof(f));
+				return f;
+			} else {
+				uint64_t bits = uint64_t(u32(b)) | (uint64_t(u32(b + 4)) << 32);
+				double d;
+				std::memcpy(&d, &bits, sizeof(d));
+				return float(d);
+			}
+		}
+		switch (format.bits) {
+			case 8: return (float(b[0]) - 128.0f) * (1.0f / 128.0f);
+			case 16: return float(int16_t(u16(b))) * (1.0f / 32768.0f);
+			case 24: return float(int32_t((uint32_t(b[0]) << 8) | (uint32_t(b[1]) << 16) | (uint32_t(b[2]) << 24))) * (1.0f / 2147483648.0f); //(as the top 24 bits of 32)
+			default: return float(double(int32_t(u32(b))) * (1.0 / 2147483648.0));
+		}
+	}
+
+	//convert the file's samples to 48kHz float mono in a single pass (SIMD for the common formats):
+	void convert_wav(WavFormat const &format, std::string const &name, std::vector< float > *data_) {
+		assert(data_);
+		auto &data = *data_;
+
+		if (!is_native(format)) {
+			std::cout << "WAV file '" + name + "' isn't " + std::to_string(AUDIO_RATE) + " Hz, float32, mono; converting." << std::endl;
+		}
+
+		uint32_t frames = uint32_t(format.data.size / format.frame_bytes);
+		uint8_t const *src = format.data.data;
+		data.resize(frames);
+
+		//(in-place views need the samples aligned, as well as in this machine's byte order)
+		bool native = native_byte_order();
+		bool aligned_2 = (reinterpret_cast< uintptr_t >(src) % alignof(int16_t) == 0);
+		bool aligned_4 = (reinterpret_cast< uintptr_t >(src) % alignof(float) == 0);
+		if (format.is_float && format.bits == 32 && format.channels == 1 && native) {
+			std::memcpy(data.data(), src, frames * sizeof(float));
+		} else if (format.is_float && format.bits == 32 && format.channels == 2 && native && aligned_4) {
+			downmix_stereo_to_mono(reinterpret_cast< float const * >(src), frames, data.data());
+		} else if (!format.is_float && format.bits == 16 && format.channels == 1 && native && aligned_2) {
+			int16_to_float(reinterpret_cast< int16_t const * >(src), frames, data.data());
+		} else if (!format.is_float && format.bits == 16 && format.channels == 2 && native && aligned_2) {
+			int16_stereo_to_mono(reinterpret_cast< int16_t const * >(src), frames, data.data());
+		} else {
+			//anything else, a sample at a time (averaging channels):
+			uint32_t sample_bytes = format.bits / 8;
+			float scale = 1.0f / float(format.channels);
+			for (uint32_t f = 0; f < frames; ++f) {
+				uint8_t const *frame = src + size_t(f) * format.frame_bytes;
+				float sum = 0.0f;
+				for (uint32_t c = 0; c < format.channels; ++c) {
+					sum += decode_sample(format, frame + c * sample_bytes);
+				}
+				data[f] = sum * scale;
+			}
+		}
+
+		if (format.rate != AUDIO_RATE) {
+			std::vector< float > converted;
+			resample(data, format.rate, AUDIO_RATE, &converted);
+			data = std::move(converted);
+		}
+	}
+
+	//print the range of the samples (if asked to by the WAV_RANGE environment variable):
+	void report_range(std::string const &name, float const *samples, size_t count) {
+		static bool const enabled = (std::getenv("WAV_RANGE") != nullptr);
+		if (!enabled) return;
+		float min = 0.0f;
+		float max = 0.0f;
+		for (size_t i = 0; i < count; ++i) {
+			min = std::min(min, samples[i]);
+			max = std::max(max, samples[i]);
+		}
+		std::cout << "WAV file '" << name << "' range: " << min << ", " << max << std::endl;
+	}
+}
+
+void load_wav(std::string const &filename, std::vector< float > *data) {
+	MappedFile mapped(filename);
+	StartupProfile::note_bytes_read(mapped.bytes.size);
+	convert_wav(parse_wav(mapped.bytes, filename), filename, data);
+	report_range(filename, data->data(), data->size());
+}
+
+void load_wav(ByteSpan const &bytes, std::string const &name, std::vector< float > *data) {
+	convert_wav(parse_wav(bytes, name), name, data);
+	report_range(name, data->data(), data->size());
+}
+
+bool map_wav_in_place = true;
+
+std::shared_ptr< MappedFile const > map_wav(std::string const &filename, float const **samples, size_t *count) {
+	assert(samples && count);
+	if (!map_wav_in_place) return nullptr;
+	auto mapped = std::make_shared< MappedFile const >(filename);
+	WavFormat format = parse_wav(mapped->bytes, filename);
+	if (!is_native(format) || !native_byte_order() || reinterpret_cast< uintptr_t >(format.data.data) % alignof(float) != 0) {
+		return nullptr;
+	}
+	*samples = reinterpret_cast< float const * >(format.data.data);
+	*count = format.data.size / sizeof(float);
+	report_range(filename, *samples, *count);
+	return mapped;
 }
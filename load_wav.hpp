@@ -1,7 +1,26 @@
 #pragma once
 
+#include "ByteSpan.hpp"
+#include "MappedFile.hpp"
+
+#include <memory>
 #include <string>
 #include <vector>
 
+//WAV files are parsed directly (integer PCM of 8, 16, 24, or 32 bits, or 32- or 64-bit float; any number of channels),
+// mixed down to mono and resampled to 48kHz as needed. Set the WAV_RANGE environment variable to print each file's sample range.
+
 //Load a WAV file as 48kHz floating-point mono; throws on error:
 void load_wav(std::string const &filename, std::vector< float > *data);
+
+//Load WAV file contents already in memory; 'name' is used in messages:
+void load_wav(ByteSpan const &bytes, std::string const &name, std::vector< float > *data);
+
+//Map a WAV file that is already 48kHz float32 mono, so its samples can be used in place (no copy, and pages load as they are touched):
+// returns the mapping and points *samples / *count at the samples inside it; returns nullptr if the file needs
+// converting, or if map_wav_in_place is false (load it with load_wav instead). Throws on error.
+std::shared_ptr< MappedFile const > map_wav(std::string const &filename, float const **samples, size_t *count);
+
+//A mapped file must not be rewritten while it is in use (the audio thread would crash reading past a truncated end),
+// so main.cpp turns in-place mapping off when asset hot-reload is watching the files (see AssetWatch.hpp):
+extern bool map_wav_in_place;
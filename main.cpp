@@ -7,11 +7,25 @@
 //For asset loading:
 #include "Load.hpp"
 
+//For timing startup (unless STARTUP_PROFILE=0):
+#include "StartupProfile.hpp"
+
 //For sound init:
 #include "Sound.hpp"
 
+//For asset hot-reloading:
+#include "AssetWatch.hpp"
+#include "load_wav.hpp"
+#include "data_path.hpp"
+
 //GL.hpp will include a non-namespace-polluting set of opengl prototypes:
 #include "GL.hpp"
+//For skipping redundant state changes (and counting them per frame):
+#include "GLState.hpp"
+//For counting calls, uploads, and draws per frame (when built with GL_INSTRUMENT):
+#include "GLStats.hpp"
+//For reporting GL errors without waiting on the GPU:
+#include "gl_debug_output.hpp"
 
 //for screenshots:
 #include "load_save_png.hpp"
@@ -48,7 +62,10 @@ int main(int argc, char **argv) {
 	//------------  initialization ------------
 
 	//Initialize SDL library:
-	SDL_Init(SDL_INIT_VIDEO);
+	{
+		STARTUP_PROFILE_SCOPE("SDL_Init");
+		SDL_Init(SDL_INIT_VIDEO);
+	}
 
 	//Ask for an OpenGL context version 3.3, core profile, enable debug:
 	SDL_GL_ResetAttributes();
@@ -65,14 +82,18 @@ int main(int argc, char **argv) {
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
 
 	//create window:
-	SDL_Window *window = SDL_CreateWindow(
-		"gp23 game4: choice-based game", //TODO: remember to set a title for your game!
-		SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-		1280, 720, //TODO: modify window size if you'd like
-		SDL_WINDOW_OPENGL
-		| SDL_WINDOW_RESIZABLE //uncomment to allow resizing
-		| SDL_WINDOW_ALLOW_HIGHDPI //uncomment for full resolution on high-DPI screens
-	);
+	SDL_Window *window = nullptr;
+	{
+		STARTUP_PROFILE_SCOPE("SDL_CreateWindow");
+		window = SDL_CreateWindow(
+			"gp23 game4: choice-based game", //TODO: remember to set a title for your game!
+			SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+			1280, 720, //TODO: modify window size if you'd like
+			SDL_WINDOW_OPENGL
+			| SDL_WINDOW_RESIZABLE //uncomment to allow resizing
+			| SDL_WINDOW_ALLOW_HIGHDPI //uncomment for full resolution on high-DPI screens
+		);
+	}
 
 	//prevent exceedingly tiny windows when resizing:
 	SDL_SetWindowMinimumSize(window,100,100);
@@ -83,7 +104,11 @@ int main(int argc, char **argv) {
 	}
 
 	//Create OpenGL context:
-	SDL_GLContext context = SDL_GL_CreateContext(window);
+	SDL_GLContext context = nullptr;
+	{
+		STARTUP_PROFILE_SCOPE("SDL_GL_CreateContext");
+		context = SDL_GL_CreateContext(window);
+	}
 
 	if (!context) {
 		SDL_DestroyWindow(window);
@@ -92,7 +117,18 @@ int main(int argc, char **argv) {
 	}
 
 	//On windows, load OpenGL entrypoints: (does nothing on other platforms)
-	init_GL();
+	{
+		STARTUP_PROFILE_SCOPE("init_GL");
+		init_GL();
+	}
+
+	//(GLState's cache describes the state of the current context, so start it fresh for a new one)
+	GLState::invalidate();
+
+	//Report GL errors through a debug message callback (so GL_ERRORS() needn't call glGetError):
+	if (!gl_debug_output_init()) {
+		std::cerr << "NOTE: no debug message callback; GL_ERRORS() will call glGetError instead." << std::endl;
+	}
 
 	//Set VSYNC + Late Swap (prevents crazy FPS):
 	if (SDL_GL_SetSwapInterval(-1) != 0) {
@@ -103,19 +139,36 @@ int main(int argc, char **argv) {
 	}
 
 	//Set automatic SRGB encoding if framebuffer needs it:
-	glEnable(GL_FRAMEBUFFER_SRGB);
+	GLState::enable(GL_FRAMEBUFFER_SRGB);
 	
 	//Hide mouse cursor (note: showing can be useful for debugging):
 	//SDL_ShowCursor(SDL_DISABLE);
 
 	//------------ init sound --------------
-	Sound::init();
+	{
+		STARTUP_PROFILE_SCOPE("Sound::init");
+		Sound::init();
+	}
+
+	//------------ watch assets for changes (if ASSET_WATCH is set) --------------
+	AssetWatch::init(data_path(""));
+	//(files that may be rewritten can't be used in place -- see map_wav_in_place)
+	if (AssetWatch::watching()) map_wav_in_place = false;
 
 	//------------ load assets --------------
-	call_load_functions();
+	{
+		STARTUP_PROFILE_SCOPE("call_load_functions");
+		call_load_functions();
+	}
 
 	//------------ create game mode + make current --------------
-	Mode::set_current(std::make_shared< PlayMode >());
+	{
+		STARTUP_PROFILE_SCOPE("PlayMode construction");
+		Mode::set_current(std::make_shared< PlayMode >());
+	}
+
+	//(writes profile files unless STARTUP_PROFILE=0)
+	StartupProfile::finish();
 
 	//------------ main loop ------------
 
@@ -171,6 +224,9 @@ int main(int argc, char **argv) {
 			if (!Mode::current) break;
 		}
 
+		//reload any assets that changed on disk:
+		AssetWatch::poll();
+
 		{ //(2) call the current mode's "update" function to deal with elapsed time:
 			auto current_time = std::chrono::high_resolution_clock::now();
 			static auto previous_time = current_time;
@@ -185,9 +241,19 @@ int main(int argc, char **argv) {
 			if (!Mode::current) break;
 		}
 
+		//forward any audio commands that didn't fit in the command queue:
+		Sound::update();
+
 		{ //(3) call the current mode's "draw" function to produce output:
 		
 			Mode::current->draw(drawable_size);
+
+			//(prints redundant state change counts if GL_STATE_STATS is set, and call counts if GL_STATS is set)
+			GLState::end_frame();
+			GLStats::end_frame();
+
+			//print any GL debug messages from this frame (even if GL_ERRORS() is compiled out):
+			gl_debug_output_poll();
 		}
 
 		//Wait until the recently-drawn frame is shown before doing it all again:
@@ -196,6 +262,7 @@ int main(int argc, char **argv) {
 
 
 	//------------  teardown ------------
+	AssetWatch::shutdown();
 	Sound::shutdown();
 
 	SDL_GL_DeleteContext(context);
@@ -2,12 +2,14 @@
 
 #create GL.hpp / GL.cpp by parsing everything from glcorearb.h (why not the regsistry xml, hmmmm?) and selecting only things that are core through version 3_3.
 #get glcorearb.h from https://github.com/KhronosGroup/OpenGL-Registry/raw/master/api/GL/glcorearb.h
+#also generates counting wrappers for every entry point, compiled in only when GL_INSTRUMENT is defined (see GLStats.hpp)
 
 import re
 
 filtered = []
 lookups = []
 fps = []
+functions = [] #(return type, name, argument list) of every entry point, for instrumentation wrappers
 
 with open('glcorearb.h', 'r') as f:
 	in_version = None
@@ -76,6 +78,8 @@ with open('glcorearb.h', 'r') as f:
 			#check for function prototype lines:
 			m = re.match(r"GLAPI(.*)APIENTRY ([^\s]+) (.*)$", line)
 			if m != None:
+				if mode != "skip":
+					functions.append((m.group(1).strip(), m.group(2), m.group(3)))
 				if mode == "all_proto":
 					filtered.append(line)
 				elif mode == "win_pointer":
@@ -104,6 +108,54 @@ with open('glcorearb.h', 'r') as f:
 
 
 
+#instrumentation wrappers (compiled in when GL_INSTRUMENT is defined; see GLStats.hpp):
+
+#names of the parameters in an argument list like "(GLenum mode, const GLint *first);":
+def parameter_names(args):
+	args = args.strip()
+	assert args.startswith("(") and args.endswith(");")
+	args = args[1:-2].strip()
+	if args == "void":
+		return []
+	return [re.findall(r"\w+", arg)[-1] for arg in args.split(",")]
+
+#extra bookkeeping for entry points that upload data or draw:
+notes = {}
+for fn in ["glBufferData"]:
+	notes[fn] = "if (data) GLStats::note_upload(size_t(size));"
+for fn in ["glBufferSubData"]:
+	notes[fn] = "GLStats::note_upload(size_t(size));"
+for fn in ["glTexImage1D", "glTexSubImage1D"]:
+	notes[fn] = "GLStats::note_image_upload(width, 1, 1, format, type, pixels);"
+for fn in ["glTexImage2D", "glTexSubImage2D"]:
+	notes[fn] = "GLStats::note_image_upload(width, height, 1, format, type, pixels);"
+for fn in ["glTexImage3D", "glTexSubImage3D"]:
+	notes[fn] = "GLStats::note_image_upload(width, height, depth, format, type, pixels);"
+for fn in ["glCompressedTexImage1D", "glCompressedTexImage2D", "glCompressedTexImage3D", "glCompressedTexSubImage1D", "glCompressedTexSubImage2D", "glCompressedTexSubImage3D"]:
+	notes[fn] = "if (data) GLStats::note_upload(size_t(imageSize));"
+for fn in ["glDrawArrays", "glDrawElements", "glDrawRangeElements", "glDrawElementsBaseVertex", "glDrawRangeElementsBaseVertex"]:
+	notes[fn] = "GLStats::note_draw(mode, count, 1);"
+for fn in ["glDrawArraysInstanced", "glDrawElementsInstanced", "glDrawElementsInstancedBaseVertex"]:
+	notes[fn] = "GLStats::note_draw(mode, count, instancecount);"
+for fn in ["glMultiDrawArrays", "glMultiDrawElements", "glMultiDrawElementsBaseVertex"]:
+	notes[fn] = "for (GLsizei i = 0; i < drawcount; ++i) GLStats::note_draw(mode, count[i], 1);"
+
+call_enums = []
+wrappers = []
+redirects = []
+for (rt, fn, args) in functions:
+	names = parameter_names(args)
+	body = "GLStats::calls[GLStats::Call_" + fn + "] += 1; "
+	if fn in notes:
+		body += notes[fn] + " "
+	body += ("" if rt == "void" else "return ") + fn + "(" + ", ".join(names) + ");"
+	call_enums.append("Call_" + fn + ",")
+	wrappers.append("inline " + rt + " instrumented_" + fn + " " + args[:-1] + " { " + body + " }")
+	redirects.append("#define " + fn + " instrumented_" + fn)
+
+for fn in notes:
+	assert fn in [f[1] for f in functions], "no entry point named " + fn
+
 with open("GL.hpp", "w") as f:
 	print("""#pragma once
 
@@ -151,11 +203,45 @@ typedef signed   long  int     khronos_ssize_t;
 	print("\n".join(filtered), file=f)
 
 	print("""
-}""", file=f)
+}
+
+//------------------------------------------------
+//Call instrumentation, compiled in only when GL_INSTRUMENT is defined (see GLStats.hpp):
+// each gl* name above is redirected to an inline wrapper that counts the call
+// (and notes bytes uploaded and primitives drawn) before calling through.
+
+#ifdef GL_INSTRUMENT
+
+#include <stddef.h>
+
+namespace GLStats {
+	//one counter per entry point:
+	enum Call : uint32_t {""", file=f)
+	print("\t\t" + "\n\t\t".join(call_enums), file=f)
+	print("""		CallCount
+	};
+	extern char const * const call_names[CallCount];
+
+	//counts for the frame in progress (see GLStats.cpp):
+	extern uint32_t calls[CallCount];
+	void note_upload(size_t bytes);
+	void note_image_upload(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels);
+	void note_draw(GLenum mode, GLsizei count, GLsizei instances);
+}
+""", file=f)
+	print("\n".join(wrappers), file=f)
+	print("""
+//(GL.cpp defines GL_NO_WRAPPERS, since it needs the actual entry points)
+#ifndef GL_NO_WRAPPERS""", file=f)
+	print("\n".join(redirects), file=f)
+	print("""#endif
+
+#endif //GL_INSTRUMENT""", file=f)
 
 
 with open("GL.cpp", "w") as f:
-	print("""#include "GL.hpp"
+	print("""#define GL_NO_WRAPPERS //(see GL.hpp)
+#include "GL.hpp"
 
 #include <SDL.h>
 #include <iostream>
@@ -176,4 +262,10 @@ void init_GL() {""", file=f)
 	print("""}
 #ifdef _WIN32""", file=f)
 	print("\t" + "\n\t".join(fps),file=f)
-	print("""#endif""", file=f)
+	print("""#endif
+
+#ifdef GL_INSTRUMENT
+char const * const GLStats::call_names[GLStats::CallCount] = {""", file=f)
+	print("\t" + "\n\t".join('"' + fn + '",' for (rt, fn, args) in functions), file=f)
+	print("""};
+#endif""", file=f)
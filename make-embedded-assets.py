@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+
+#
+# Turns asset files into aligned constexpr byte arrays that get compiled
+#  directly into the executable (see EmbeddedAssets.hpp).
+#
+# Usage:
+#  python3 make-embedded-assets.py <output.cpp> <base-dir> [asset1] [asset2] [...]
+#
+# Each asset is given as a path relative to <base-dir>, and that relative
+#  path is the name used to look it up with EmbeddedAssets::find().
+# (Maekfile.js runs this script with <base-dir> set to 'dist'.)
+#
+
+import os
+import sys
+
+if len(sys.argv) < 3:
+	print("Usage:\n\tpython3 make-embedded-assets.py <output.cpp> <base-dir> [asset1] [asset2] [...]")
+	sys.exit(1)
+
+cppname = sys.argv[1]
+basedir = sys.argv[2]
+names = sys.argv[3:]
+
+#the generated file may live in a different directory than EmbeddedAssets.hpp:
+hpp = os.path.relpath('EmbeddedAssets.hpp', os.path.dirname(os.path.abspath(cppname))).replace('\\', '/')
+
+def cpp_string(s):
+	return '"' + s.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+with open(cppname, 'w') as f:
+	f.write('//automatically generated by make-embedded-assets.py\n')
+	f.write('#include "' + hpp + '"\n')
+	f.write('namespace {\n')
+	for i, name in enumerate(names):
+		with open(os.path.join(basedir, name), 'rb') as a:
+			data = a.read()
+		print("Embedding '" + name + "' (" + str(len(data)) + " bytes).")
+		#(zero-length arrays aren't allowed, so empty files get one byte of padding)
+		padded = data if len(data) > 0 else b'\0'
+		f.write('\t//' + name + ':\n')
+		f.write('\talignas(16) constexpr const uint8_t asset_' + str(i) + '_data[' + str(len(padded)) + '] = {\n')
+		for start in range(0, len(padded), 24):
+			f.write('\t\t' + ','.join(str(b) for b in padded[start:start+24]))
+			f.write(',\n' if start + 24 < len(padded) else '\n')
+		f.write('\t};\n')
+		f.write('\tconstexpr const size_t asset_' + str(i) + '_size = ' + str(len(data)) + ';\n')
+	f.write('\tconstexpr const uint32_t embedded_asset_count = ' + str(len(names)) + ';\n')
+	if len(names) > 0:
+		f.write('\tconst EmbeddedAssets::Asset embedded_asset_table[embedded_asset_count] = {\n')
+		for i, name in enumerate(names):
+			f.write('\t\t{ ' + cpp_string(name) + ', ByteSpan(asset_' + str(i) + '_data, asset_' + str(i) + '_size) }' + (',' if i + 1 < len(names) else '') + '\n')
+		f.write('\t};\n')
+	else:
+		f.write('\tconst EmbeddedAssets::Asset *embedded_asset_table = nullptr;\n')
+	f.write('}\n')
+	f.write('EmbeddedAssets EmbeddedAssets::embedded(embedded_asset_count, embedded_asset_table);\n')
@@ -0,0 +1,865 @@
+#include "mix_kernels.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define MIX_KERNELS_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MIX_KERNELS_NEON
+#endif
+
+//equal-power panning needs cos(a) and sin(a) for a = pi/4 * (pan + 1) in [0, pi/2].
+//Writing a = pi/4 + x (x = pi/4 * pan, so |x| <= pi/4, where short Taylor series are accurate):
+//  cos(a) = (cos(x) - sin(x)) / sqrt(2)
+//  sin(a) = (cos(x) + sin(x)) / sqrt(2)
+constexpr float const PI_4 = 0.785398163f;
+constexpr float const SQRT_1_2 = 0.707106781f;
+constexpr float const SIN_1 = -1.0f / 6.0f, SIN_2 = 1.0f / 120.0f, SIN_3 = -1.0f / 5040.0f;
+constexpr float const COS_1 = -1.0f / 2.0f, COS_2 = 1.0f / 24.0f, COS_3 = -1.0f / 720.0f, COS_4 = 1.0f / 40320.0f;
+
+static inline void pan_gains(float pan, float *left, float *right) {
+	float x = PI_4 * std::max(-1.0f, std::min(1.0f, pan));
+	float x2 = x * x;
+	float s = x * (1.0f + x2 * (SIN_1 + x2 * (SIN_2 + x2 * SIN_3)));
+	float c = 1.0f + x2 * (COS_1 + x2 * (COS_2 + x2 * (COS_3 + x2 * COS_4)));
+	*left = SQRT_1_2 * (c - s);
+	*right = SQRT_1_2 * (c + s);
+}
+
+#if defined(MIX_KERNELS_SSE)
+static inline void pan_gains(__m128 pan, __m128 *left, __m128 *right) {
+	__m128 x = _mm_mul_ps(_mm_set1_ps(PI_4), _mm_max_ps(_mm_set1_ps(-1.0f), _mm_min_ps(_mm_set1_ps(1.0f), pan)));
+	__m128 x2 = _mm_mul_ps(x, x);
+	__m128 s = _mm_add_ps(_mm_set1_ps(SIN_2), _mm_mul_ps(x2, _mm_set1_ps(SIN_3)));
+	s = _mm_add_ps(_mm_set1_ps(SIN_1), _mm_mul_ps(x2, s));
+	s = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(x2, s));
+	s = _mm_mul_ps(x, s);
+	__m128 c = _mm_add_ps(_mm_set1_ps(COS_3), _mm_mul_ps(x2, _mm_set1_ps(COS_4)));
+	c = _mm_add_ps(_mm_set1_ps(COS_2), _mm_mul_ps(x2, c));
+	c = _mm_add_ps(_mm_set1_ps(COS_1), _mm_mul_ps(x2, c));
+	c = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(x2, c));
+	*left = _mm_mul_ps(_mm_set1_ps(SQRT_1_2), _mm_sub_ps(c, s));
+	*right = _mm_mul_ps(_mm_set1_ps(SQRT_1_2), _mm_add_ps(c, s));
+}
+#elif defined(MIX_KERNELS_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define MIX_KERNELS_NEON_64 //(spatialize needs the division and square root only 64-bit ARM has)
+static inline void pan_gains(float32x4_t pan, float32x4_t *left, float32x4_t *right) {
+	float32x4_t x = vmulq_n_f32(vmaxq_f32(vdupq_n_f32(-1.0f), vminq_f32(vdupq_n_f32(1.0f), pan)), PI_4);
+	float32x4_t x2 = vmulq_f32(x, x);
+	float32x4_t s = vmlaq_n_f32(vdupq_n_f32(SIN_2), x2, SIN_3);
+	s = vmlaq_f32(vdupq_n_f32(SIN_1), x2, s);
+	s = vmlaq_f32(vdupq_n_f32(1.0f), x2, s);
+	s = vmulq_f32(x, s);
+	float32x4_t c = vmlaq_n_f32(vdupq_n_f32(COS_3), x2, COS_4);
+	c = vmlaq_f32(vdupq_n_f32(COS_2), x2, c);
+	c = vmlaq_f32(vdupq_n_f32(COS_1), x2, c);
+	c = vmlaq_f32(vdupq_n_f32(1.0f), x2, c);
+	*left = vmulq_n_f32(vsubq_f32(c, s), SQRT_1_2);
+	*right = vmulq_n_f32(vaddq_f32(c, s), SQRT_1_2);
+}
+#endif
+
+void mix_mono_to_stereo(float const *src, uint32_t count,
+	float left, float right, float left_step, float right_step,
+	float *dst) {
+
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE) && defined(__AVX__)
+	{ //eight samples at a time:
+		__m256 const index = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+		__m256 const l_step = _mm256_set1_ps(left_step);
+		__m256 const r_step = _mm256_set1_ps(right_step);
+		for (; i + 8 <= count; i += 8) {
+			__m256 base = _mm256_set1_ps(float(i));
+			__m256 l = _mm256_add_ps(_mm256_set1_ps(left), _mm256_mul_ps(_mm256_add_ps(base, index), l_step));
+			__m256 r = _mm256_add_ps(_mm256_set1_ps(right), _mm256_mul_ps(_mm256_add_ps(base, index), r_step));
+			__m256 s = _mm256_loadu_ps(src + i);
+			__m256 sl = _mm256_mul_ps(s, l); //l0 l1 l2 l3 | l4 l5 l6 l7
+			__m256 sr = _mm256_mul_ps(s, r); //r0 r1 r2 r3 | r4 r5 r6 r7
+			//interleave -- unpack works within 128-bit lanes, so fix up with a permute:
+			__m256 lo = _mm256_unpacklo_ps(sl, sr); //l0 r0 l1 r1 | l4 r4 l5 r5
+			__m256 hi = _mm256_unpackhi_ps(sl, sr); //l2 r2 l3 r3 | l6 r6 l7 r7
+			__m256 first = _mm256_permute2f128_ps(lo, hi, 0x20); //l0 r0 l1 r1 l2 r2 l3 r3
+			__m256 second = _mm256_permute2f128_ps(lo, hi, 0x31); //l4 r4 ... l7 r7
+			_mm256_storeu_ps(dst + 2*i, _mm256_add_ps(_mm256_loadu_ps(dst + 2*i), first));
+			_mm256_storeu_ps(dst + 2*i + 8, _mm256_add_ps(_mm256_loadu_ps(dst + 2*i + 8), second));
+		}
+	}
+	#endif
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //four samples at a time:
+		__m128 const index = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+		__m128 const l_step = _mm_set1_ps(left_step);
+		__m128 const r_step = _mm_set1_ps(right_step);
+		for (; i + 4 <= count; i += 4) {
+			__m128 base = _mm_add_ps(_mm_set1_ps(float(i)), index);
+			__m128 l = _mm_add_ps(_mm_set1_ps(left), _mm_mul_ps(base, l_step));
+			__m128 r = _mm_add_ps(_mm_set1_ps(right), _mm_mul_ps(base, r_step));
+			__m128 s = _mm_loadu_ps(src + i);
+			__m128 sl = _mm_mul_ps(s, l);
+			__m128 sr = _mm_mul_ps(s, r);
+			__m128 lo = _mm_unpacklo_ps(sl, sr); //l0 r0 l1 r1
+			__m128 hi = _mm_unpackhi_ps(sl, sr); //l2 r2 l3 r3
+			_mm_storeu_ps(dst + 2*i, _mm_add_ps(_mm_loadu_ps(dst + 2*i), lo));
+			_mm_storeu_ps(dst + 2*i + 4, _mm_add_ps(_mm_loadu_ps(dst + 2*i + 4), hi));
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //four samples at a time:
+		float const index_init[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+		float32x4_t const index = vld1q_f32(index_init);
+		for (; i + 4 <= count; i += 4) {
+			float32x4_t base = vaddq_f32(vdupq_n_f32(float(i)), index);
+			float32x4_t l = vmlaq_n_f32(vdupq_n_f32(left), base, left_step);
+			float32x4_t r = vmlaq_n_f32(vdupq_n_f32(right), base, right_step);
+			float32x4_t s = vld1q_f32(src + i);
+			float32x4x2_t lr = vld2q_f32(dst + 2*i); //de-interleaves
+			lr.val[0] = vmlaq_f32(lr.val[0], s, l);
+			lr.val[1] = vmlaq_f32(lr.val[1], s, r);
+			vst2q_f32(dst + 2*i, lr); //re-interleaves
+		}
+	}
+	#endif
+
+	//remaining samples one at a time:
+	for (; i < count; ++i) {
+		dst[2*i+0] += src[i] * (left + float(i) * left_step);
+		dst[2*i+1] += src[i] * (right + float(i) * right_step);
+	}
+}
+
+void mix_mono_to_channels(float const *src, uint32_t count, uint32_t channels,
+	float const *gains, float const *gain_steps,
+	float *dst) {
+	assert(channels % 2 == 0 && channels <= MAX_MIX_CHANNELS);
+	if (channels == 2) {
+		mix_mono_to_stereo(src, count, gains[0], gains[1], gain_steps[0], gain_steps[1], dst);
+		return;
+	}
+
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE) && defined(__AVX__)
+	if (channels == 8) { //a whole frame at a time:
+		__m256 const g = _mm256_loadu_ps(gains);
+		__m256 const step = _mm256_loadu_ps(gain_steps);
+		for (; i < count; ++i) {
+			__m256 gain = _mm256_add_ps(g, _mm256_mul_ps(_mm256_set1_ps(float(i)), step));
+			float *d = dst + 8*i;
+			_mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), _mm256_mul_ps(_mm256_set1_ps(src[i]), gain)));
+		}
+	}
+	#endif
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //four channels at a time (then the last two, if channels isn't a multiple of four):
+		for (; i < count; ++i) {
+			__m128 const s = _mm_set1_ps(src[i]);
+			__m128 const index = _mm_set1_ps(float(i));
+			float *d = dst + channels*i;
+			uint32_t c = 0;
+			for (; c + 4 <= channels; c += 4) {
+				__m128 gain = _mm_add_ps(_mm_loadu_ps(gains + c), _mm_mul_ps(index, _mm_loadu_ps(gain_steps + c)));
+				_mm_storeu_ps(d + c, _mm_add_ps(_mm_loadu_ps(d + c), _mm_mul_ps(s, gain)));
+			}
+			if (c < channels) {
+				__m128 g = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast< __m64 const * >(gains + c));
+				__m128 step = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast< __m64 const * >(gain_steps + c));
+				__m128 gain = _mm_add_ps(g, _mm_mul_ps(index, step));
+				__m128 sum = _mm_add_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast< __m64 const * >(d + c)), _mm_mul_ps(s, gain));
+				_mm_storel_pi(reinterpret_cast< __m64 * >(d + c), sum);
+			}
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //four channels at a time (then the last two, if channels isn't a multiple of four):
+		for (; i < count; ++i) {
+			float const index = float(i);
+			float *d = dst + channels*i;
+			uint32_t c = 0;
+			for (; c + 4 <= channels; c += 4) {
+				float32x4_t gain = vmlaq_n_f32(vld1q_f32(gains + c), vld1q_f32(gain_steps + c), index);
+				vst1q_f32(d + c, vmlaq_n_f32(vld1q_f32(d + c), gain, src[i]));
+			}
+			if (c < channels) {
+				float32x2_t gain = vmla_n_f32(vld1_f32(gains + c), vld1_f32(gain_steps + c), index);
+				vst1_f32(d + c, vmla_n_f32(vld1_f32(d + c), gain, src[i]));
+			}
+		}
+	}
+	#endif
+
+	//remaining samples one at a time:
+	for (; i < count; ++i) {
+		for (uint32_t c = 0; c < channels; ++c) {
+			dst[channels*i+c] += src[i] * (gains[c] + float(i) * gain_steps[c]);
+		}
+	}
+}
+
+void downmix_stereo_to_mono(float const *src, uint32_t count, float *dst) {
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE) && defined(__AVX__)
+	{ //eight samples at a time:
+		__m256 const half = _mm256_set1_ps(0.5f);
+		for (; i + 8 <= count; i += 8) {
+			__m256 a = _mm256_loadu_ps(src + 2*i); //l0 r0 l1 r1 | l2 r2 l3 r3
+			__m256 b = _mm256_loadu_ps(src + 2*i + 8); //l4 r4 l5 r5 | l6 r6 l7 r7
+			//shuffle works within 128-bit lanes, so first regroup the lanes:
+			__m256 lo = _mm256_permute2f128_ps(a, b, 0x20); //l0 r0 l1 r1 | l4 r4 l5 r5
+			__m256 hi = _mm256_permute2f128_ps(a, b, 0x31); //l2 r2 l3 r3 | l6 r6 l7 r7
+			__m256 l = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2,0,2,0)); //l0 l1 l2 l3 | l4 l5 l6 l7
+			__m256 r = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3,1,3,1)); //r0 r1 r2 r3 | r4 r5 r6 r7
+			__m256 sums = _mm256_add_ps(l, r);
+			_mm256_storeu_ps(dst + i, _mm256_mul_ps(sums, half));
+		}
+	}
+	#endif
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //four samples at a time:
+		__m128 const half = _mm_set1_ps(0.5f);
+		for (; i + 4 <= count; i += 4) {
+			__m128 a = _mm_loadu_ps(src + 2*i); //l0 r0 l1 r1
+			__m128 b = _mm_loadu_ps(src + 2*i + 4); //l2 r2 l3 r3
+			__m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0)); //l0 l1 l2 l3
+			__m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1)); //r0 r1 r2 r3
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_add_ps(l, r), half));
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //four samples at a time:
+		for (; i + 4 <= count; i += 4) {
+			float32x4x2_t lr = vld2q_f32(src + 2*i); //de-interleaves
+			vst1q_f32(dst + i, vmulq_n_f32(vaddq_f32(lr.val[0], lr.val[1]), 0.5f));
+		}
+	}
+	#endif
+
+	//remaining samples one at a time:
+	for (; i < count; ++i) {
+		dst[i] = (src[2*i+0] + src[2*i+1]) * 0.5f;
+	}
+}
+
+void int16_to_float(int16_t const *src, uint32_t count, float *dst) {
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //eight samples at a time:
+		__m128 const scale = _mm_set1_ps(1.0f / 32768.0f);
+		for (; i + 8 <= count; i += 8) {
+			__m128i s = _mm_loadu_si128(reinterpret_cast< __m128i const * >(src + i));
+			//sign-extend to 32 bits by placing each value in the high half and shifting down:
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+			_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //eight samples at a time:
+		for (; i + 8 <= count; i += 8) {
+			int16x8_t s = vld1q_s16(src + i);
+			vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), 1.0f / 32768.0f));
+			vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), 1.0f / 32768.0f));
+		}
+	}
+	#endif
+
+	//remaining samples one at a time:
+	for (; i < count; ++i) {
+		dst[i] = float(src[i]) * (1.0f / 32768.0f);
+	}
+}
+
+void int16_stereo_to_mono(int16_t const *src, uint32_t count, float *dst) {
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //eight frames at a time:
+		__m128 const scale = _mm_set1_ps(1.0f / 65536.0f);
+		__m128i const ones = _mm_set1_epi16(1);
+		for (; i + 8 <= count; i += 8) {
+			//(multiplying pairs by one and adding gives each frame's left + right as a 32-bit value)
+			__m128i lo = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast< __m128i const * >(src + 2 * i)), ones);
+			__m128i hi = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast< __m128i const * >(src + 2 * i + 8)), ones);
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+			_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //eight frames at a time:
+		for (; i + 8 <= count; i += 8) {
+			//(pairwise add-long gives each frame's left + right as a 32-bit value)
+			int32x4_t lo = vpaddlq_s16(vld1q_s16(src + 2 * i));
+			int32x4_t hi = vpaddlq_s16(vld1q_s16(src + 2 * i + 8));
+			vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(lo), 1.0f / 65536.0f));
+			vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(hi), 1.0f / 65536.0f));
+		}
+	}
+	#endif
+
+	//remaining frames one at a time:
+	for (; i < count; ++i) {
+		dst[i] = float(int32_t(src[2 * i]) + int32_t(src[2 * i + 1])) * (1.0f / 65536.0f);
+	}
+}
+
+void equal_power_pan(float const *pan, uint32_t count, float *left, float *right) {
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //four at a time:
+		for (; i + 4 <= count; i += 4) {
+			__m128 l, r;
+			pan_gains(_mm_loadu_ps(pan + i), &l, &r);
+			_mm_storeu_ps(left + i, l);
+			_mm_storeu_ps(right + i, r);
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON_64)
+	{ //four at a time:
+		for (; i + 4 <= count; i += 4) {
+			float32x4_t l, r;
+			pan_gains(vld1q_f32(pan + i), &l, &r);
+			vst1q_f32(left + i, l);
+			vst1q_f32(right + i, r);
+		}
+	}
+	#endif
+
+	//remaining values one at a time:
+	for (; i < count; ++i) {
+		pan_gains(pan[i], &left[i], &right[i]);
+	}
+}
+
+void spatialize(float const *x, float const *y, float const *z, float const *half_radius, uint32_t count,
+	float const listener[3], float const listener_right[3],
+	float *left, float *right) {
+
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //four at a time:
+		__m128 const lx = _mm_set1_ps(listener[0]), ly = _mm_set1_ps(listener[1]), lz = _mm_set1_ps(listener[2]);
+		__m128 const rx = _mm_set1_ps(listener_right[0]), ry = _mm_set1_ps(listener_right[1]), rz = _mm_set1_ps(listener_right[2]);
+		__m128 const one = _mm_set1_ps(1.0f);
+		for (; i + 4 <= count; i += 4) {
+			__m128 tx = _mm_sub_ps(_mm_loadu_ps(x + i), lx);
+			__m128 ty = _mm_sub_ps(_mm_loadu_ps(y + i), ly);
+			__m128 tz = _mm_sub_ps(_mm_loadu_ps(z + i), lz);
+			__m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz)));
+			__m128 away = _mm_cmpgt_ps(distance, _mm_setzero_ps()); //(all ones where distance > 0)
+			//(0 / 0 is NaN, so mask those lanes to zero before panning)
+			__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, tx), _mm_mul_ps(ry, ty)), _mm_mul_ps(rz, tz));
+			__m128 amount = _mm_and_ps(away, _mm_div_ps(dot, distance));
+			__m128 l, r;
+			pan_gains(amount, &l, &r);
+			__m128 attenuation = _mm_div_ps(one, _mm_add_ps(one, _mm_div_ps(distance, _mm_loadu_ps(half_radius + i))));
+			__m128 at_listener = _mm_andnot_ps(away, _mm_set1_ps(std::sqrt(2.0f)));
+			_mm_storeu_ps(left + i, _mm_or_ps(_mm_and_ps(away, _mm_mul_ps(l, attenuation)), at_listener));
+			_mm_storeu_ps(right + i, _mm_or_ps(_mm_and_ps(away, _mm_mul_ps(r, attenuation)), at_listener));
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON_64)
+	{ //four at a time:
+		for (; i + 4 <= count; i += 4) {
+			float32x4_t tx = vsubq_f32(vld1q_f32(x + i), vdupq_n_f32(listener[0]));
+			float32x4_t ty = vsubq_f32(vld1q_f32(y + i), vdupq_n_f32(listener[1]));
+			float32x4_t tz = vsubq_f32(vld1q_f32(z + i), vdupq_n_f32(listener[2]));
+			float32x4_t distance = vsqrtq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(tx, tx), ty, ty), tz, tz));
+			uint32x4_t away = vcgtq_f32(distance, vdupq_n_f32(0.0f));
+			float32x4_t dot = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(tx, listener_right[0]), ty, listener_right[1]), tz, listener_right[2]);
+			float32x4_t amount = vbslq_f32(away, vdivq_f32(dot, distance), vdupq_n_f32(0.0f));
+			float32x4_t l, r;
+			pan_gains(amount, &l, &r);
+			float32x4_t attenuation = vdivq_f32(vdupq_n_f32(1.0f), vaddq_f32(vdupq_n_f32(1.0f), vdivq_f32(distance, vld1q_f32(half_radius + i))));
+			vst1q_f32(left + i, vbslq_f32(away, vmulq_f32(l, attenuation), vdupq_n_f32(std::sqrt(2.0f))));
+			vst1q_f32(right + i, vbslq_f32(away, vmulq_f32(r, attenuation), vdupq_n_f32(std::sqrt(2.0f))));
+		}
+	}
+	#endif
+
+	//remaining sources one at a time:
+	for (; i < count; ++i) {
+		float tx = x[i] - listener[0];
+		float ty = y[i] - listener[1];
+		float tz = z[i] - listener[2];
+		float distance = std::sqrt(tx * tx + ty * ty + tz * tz);
+		if (distance == 0.0f) {
+			left[i] = right[i] = std::sqrt(2.0f);
+		} else {
+			pan_gains((listener_right[0] * tx + listener_right[1] * ty + listener_right[2] * tz) / distance, &left[i], &right[i]);
+			//(linear rather than squared distance attenuation -- squared is realistic if there are no walls,
+			// but linear sounds better; attenuation is 0.5 at distance == half_radius)
+			float attenuation = 1.0f / (1.0f + distance / half_radius[i]);
+			left[i] *= attenuation;
+			right[i] *= attenuation;
+		}
+	}
+}
+
+VBAPLayout vbap_layout(uint32_t channels, float const *azimuths) {
+	assert(channels <= MAX_MIX_CHANNELS);
+	VBAPLayout layout;
+	layout.channels = channels;
+
+	//speakers in clockwise order:
+	uint32_t order[MAX_MIX_CHANNELS];
+	for (uint32_t c = 0; c < channels; ++c) {
+		if (std::isnan(azimuths[c])) continue;
+		order[layout.speakers] = c;
+		layout.speakers += 1;
+	}
+	assert(layout.speakers >= 3);
+	auto wrapped = [&](uint32_t c) {
+		float a = std::fmod(azimuths[c], 360.0f);
+		return (a < 0.0f ? a + 360.0f : a);
+	};
+	for (uint32_t s = 1; s < layout.speakers; ++s) { //(insertion sort; there are only a few)
+		for (uint32_t t = s; t > 0 && wrapped(order[t]) < wrapped(order[t-1]); --t) {
+			std::swap(order[t], order[t-1]);
+		}
+	}
+
+	//each speaker and the next one around:
+	constexpr float const DEGREES = 3.14159265f / 180.0f;
+	for (uint32_t s = 0; s < layout.speakers; ++s) {
+		uint32_t a = order[s], b = order[(s + 1) % layout.speakers];
+		//(speaker directions as (right, forward) unit vectors)
+		float ax = std::sin(azimuths[a] * DEGREES), ay = std::cos(azimuths[a] * DEGREES);
+		float bx = std::sin(azimuths[b] * DEGREES), by = std::cos(azimuths[b] * DEGREES);
+		float det = ax * by - bx * ay;
+		assert(det < 0.0f && "neighboring speakers are less than 180 degrees apart"); //(clockwise turns are negative)
+		layout.pair_channels[layout.pairs][0] = a;
+		layout.pair_channels[layout.pairs][1] = b;
+		//gains (g_a, g_b) with g_a * (ax, ay) + g_b * (bx, by) == direction:
+		layout.pair_inverse[layout.pairs][0] = by / det;
+		layout.pair_inverse[layout.pairs][1] = -bx / det;
+		layout.pair_inverse[layout.pairs][2] = -ay / det;
+		layout.pair_inverse[layout.pairs][3] = ax / det;
+		layout.pairs += 1;
+	}
+	return layout;
+}
+
+void vbap_spatialize(float const *x, float const *y, float const *z, float const *half_radius, uint32_t count,
+	float const listener[3], float const listener_right[3], float const listener_up[3], VBAPLayout const &layout,
+	float *const *gains) {
+
+	//listener's forward direction (with up made perpendicular to right, in case they disagree):
+	float const *r = listener_right;
+	float up_dot = listener_up[0] * r[0] + listener_up[1] * r[1] + listener_up[2] * r[2];
+	float up[3] = { listener_up[0] - r[0] * up_dot, listener_up[1] - r[1] * up_dot, listener_up[2] - r[2] * up_dot };
+	float forward[3] = { up[1] * r[2] - up[2] * r[1], up[2] * r[0] - up[0] * r[2], up[0] * r[1] - up[1] * r[0] };
+	float forward_length = std::sqrt(forward[0] * forward[0] + forward[1] * forward[1] + forward[2] * forward[2]);
+	for (float &f : forward) f /= (forward_length > 0.0f ? forward_length : 1.0f);
+
+	//(each speaker's share of a sound from straight above or below)
+	float const spread = 1.0f / std::sqrt(float(layout.speakers));
+
+	for (uint32_t i = 0; i < count; ++i) {
+		for (uint32_t c = 0; c < layout.channels; ++c) {
+			gains[c][i] = 0.0f;
+		}
+
+		float tx = x[i] - listener[0];
+		float ty = y[i] - listener[1];
+		float tz = z[i] - listener[2];
+		float distance = std::sqrt(tx * tx + ty * ty + tz * tz);
+		if (distance == 0.0f) {
+			//(spatialize gives both speakers sqrt(2), so total power 4)
+			for (uint32_t p = 0; p < layout.pairs; ++p) {
+				gains[layout.pair_channels[p][0]][i] = 2.0f * spread;
+			}
+			continue;
+		}
+
+		//direction on the listener's horizontal plane, and how far it is from straight up or down:
+		float h_right = (r[0] * tx + r[1] * ty + r[2] * tz) / distance;
+		float h_forward = (forward[0] * tx + forward[1] * ty + forward[2] * tz) / distance;
+		float level = std::min(1.0f, std::sqrt(h_right * h_right + h_forward * h_forward));
+
+		//pan between the pair of speakers the direction falls between:
+		float g[MAX_MIX_CHANNELS] = {};
+		if (level > 0.0f) {
+			for (uint32_t p = 0; p < layout.pairs; ++p) {
+				float const *inverse = layout.pair_inverse[p];
+				float ga = inverse[0] * h_right + inverse[1] * h_forward;
+				float gb = inverse[2] * h_right + inverse[3] * h_forward;
+				if (ga < -1e-6f || gb < -1e-6f) continue;
+				ga = std::max(0.0f, ga);
+				gb = std::max(0.0f, gb);
+				float norm = level / std::sqrt(ga * ga + gb * gb);
+				g[layout.pair_channels[p][0]] = ga * norm;
+				g[layout.pair_channels[p][1]] = gb * norm;
+				break;
+			}
+		}
+
+		//blend toward every speaker equally as the direction leaves the plane, keeping unit power:
+		float power = 0.0f;
+		for (uint32_t p = 0; p < layout.pairs; ++p) {
+			uint32_t c = layout.pair_channels[p][0];
+			g[c] += (1.0f - level) * spread;
+			power += g[c] * g[c];
+		}
+		//(attenuation as in spatialize)
+		float scale = (1.0f / std::sqrt(power)) / (1.0f + distance / half_radius[i]);
+		for (uint32_t p = 0; p < layout.pairs; ++p) {
+			uint32_t c = layout.pair_channels[p][0];
+			gains[c][i] = g[c] * scale;
+		}
+	}
+}
+
+void mix_stereo(float const *src, uint32_t count, float gain, float gain_step, float *dst) {
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //two frames at a time:
+		__m128 const index = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+		__m128 const step = _mm_set1_ps(gain_step);
+		for (; i + 2 <= count; i += 2) {
+			__m128 g = _mm_add_ps(_mm_set1_ps(gain), _mm_mul_ps(_mm_add_ps(_mm_set1_ps(float(i)), index), step));
+			_mm_storeu_ps(dst + 2*i, _mm_add_ps(_mm_loadu_ps(dst + 2*i), _mm_mul_ps(_mm_loadu_ps(src + 2*i), g)));
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //four frames at a time:
+		float const index_init[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+		float32x4_t const index = vld1q_f32(index_init);
+		for (; i + 4 <= count; i += 4) {
+			float32x4_t g = vmlaq_n_f32(vdupq_n_f32(gain), vaddq_f32(vdupq_n_f32(float(i)), index), gain_step);
+			float32x4x2_t s = vld2q_f32(src + 2*i); //de-interleaves
+			float32x4x2_t d = vld2q_f32(dst + 2*i);
+			d.val[0] = vmlaq_f32(d.val[0], s.val[0], g);
+			d.val[1] = vmlaq_f32(d.val[1], s.val[1], g);
+			vst2q_f32(dst + 2*i, d); //re-interleaves
+		}
+	}
+	#endif
+
+	//remaining frames one at a time:
+	for (; i < count; ++i) {
+		float g = gain + float(i) * gain_step;
+		dst[2*i+0] += src[2*i+0] * g;
+		dst[2*i+1] += src[2*i+1] * g;
+	}
+}
+
+void mix_channels(float const *src, uint32_t count, uint32_t channels, float gain, float gain_step, float *dst) {
+	assert(channels % 2 == 0 && channels <= MAX_MIX_CHANNELS);
+	if (channels == 2) {
+		mix_stereo(src, count, gain, gain_step, dst);
+		return;
+	}
+
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //four channels at a time (then the last two, if channels isn't a multiple of four):
+		for (; i < count; ++i) {
+			__m128 const g = _mm_set1_ps(gain + float(i) * gain_step);
+			float const *s = src + channels*i;
+			float *d = dst + channels*i;
+			uint32_t c = 0;
+			for (; c + 4 <= channels; c += 4) {
+				_mm_storeu_ps(d + c, _mm_add_ps(_mm_loadu_ps(d + c), _mm_mul_ps(_mm_loadu_ps(s + c), g)));
+			}
+			if (c < channels) {
+				__m128 x = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast< __m64 const * >(s + c));
+				__m128 sum = _mm_add_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast< __m64 const * >(d + c)), _mm_mul_ps(x, g));
+				_mm_storel_pi(reinterpret_cast< __m64 * >(d + c), sum);
+			}
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //four channels at a time (then the last two, if channels isn't a multiple of four):
+		for (; i < count; ++i) {
+			float const g = gain + float(i) * gain_step;
+			float const *s = src + channels*i;
+			float *d = dst + channels*i;
+			uint32_t c = 0;
+			for (; c + 4 <= channels; c += 4) {
+				vst1q_f32(d + c, vmlaq_n_f32(vld1q_f32(d + c), vld1q_f32(s + c), g));
+			}
+			if (c < channels) {
+				vst1_f32(d + c, vmla_n_f32(vld1_f32(d + c), vld1_f32(s + c), g));
+			}
+		}
+	}
+	#endif
+
+	//remaining frames one at a time:
+	for (; i < count; ++i) {
+		float g = gain + float(i) * gain_step;
+		for (uint32_t c = 0; c < channels; ++c) {
+			dst[channels*i+c] += src[channels*i+c] * g;
+		}
+	}
+}
+
+void one_pole_low_pass(float *samples, uint32_t count, float coefficient, float *state) {
+	float y = *state;
+	for (uint32_t i = 0; i < count; ++i) {
+		y += coefficient * (samples[i] - y);
+		samples[i] = y;
+	}
+	//(a decaying filter eventually reaches denormal values, which are very slow on some processors)
+	if (std::abs(y) < 1e-15f) y = 0.0f;
+	*state = y;
+}
+
+float one_pole_coefficient(float cutoff, float rate) {
+	constexpr float const TWO_PI = 6.283185307f;
+	return 1.0f - std::exp(-TWO_PI * std::min(cutoff, 0.5f * rate) / rate);
+}
+
+//helper: the parts of the cookbook designs shared by the low- and high-pass filters:
+// (returns the denominator coefficients and sets *cos_w0 and *a0 for computing the numerator)
+static BiquadCoefficients biquad_denominator(float cutoff, float q, float rate, float *cos_w0, float *a0) {
+	constexpr float const TWO_PI = 6.283185307f;
+	float w0 = TWO_PI * std::max(1.0f, std::min(cutoff, 0.49f * rate)) / rate;
+	float alpha = std::sin(w0) / (2.0f * std::max(q, 0.01f));
+	*cos_w0 = std::cos(w0);
+	*a0 = 1.0f + alpha;
+
+	BiquadCoefficients ret;
+	ret.a1 = -2.0f * *cos_w0 / *a0;
+	ret.a2 = (1.0f - alpha) / *a0;
+	return ret;
+}
+
+BiquadCoefficients biquad_low_pass(float cutoff, float q, float rate) {
+	float cos_w0, a0;
+	BiquadCoefficients ret = biquad_denominator(cutoff, q, rate, &cos_w0, &a0);
+	ret.b1 = (1.0f - cos_w0) / a0;
+	ret.b0 = ret.b2 = 0.5f * ret.b1;
+	return ret;
+}
+
+BiquadCoefficients biquad_high_pass(float cutoff, float q, float rate) {
+	float cos_w0, a0;
+	BiquadCoefficients ret = biquad_denominator(cutoff, q, rate, &cos_w0, &a0);
+	ret.b1 = -(1.0f + cos_w0) / a0;
+	ret.b0 = ret.b2 = -0.5f * ret.b1;
+	return ret;
+}
+
+void biquad_stereo(BiquadCoefficients const &c, float state[4], uint32_t count, float *lr) {
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //left and right in the low two lanes:
+		__m128 const b0 = _mm_set1_ps(c.b0), b1 = _mm_set1_ps(c.b1), b2 = _mm_set1_ps(c.b2);
+		__m128 const a1 = _mm_set1_ps(c.a1), a2 = _mm_set1_ps(c.a2);
+		__m128 s1 = _mm_setr_ps(state[0], state[1], 0.0f, 0.0f);
+		__m128 s2 = _mm_setr_ps(state[2], state[3], 0.0f, 0.0f);
+		for (; i < count; ++i) {
+			__m128 x = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast< __m64 const * >(lr + 2*i));
+			__m128 y = _mm_add_ps(_mm_mul_ps(b0, x), s1);
+			s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), s2);
+			s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+			_mm_storel_pi(reinterpret_cast< __m64 * >(lr + 2*i), y);
+		}
+		float s[8];
+		_mm_storeu_ps(s, s1);
+		_mm_storeu_ps(s + 4, s2);
+		state[0] = s[0]; state[1] = s[1];
+		state[2] = s[4]; state[3] = s[5];
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //left and right in one two-lane vector:
+		float32x2_t s1 = vld1_f32(state);
+		float32x2_t s2 = vld1_f32(state + 2);
+		for (; i < count; ++i) {
+			float32x2_t x = vld1_f32(lr + 2*i);
+			float32x2_t y = vmla_n_f32(s1, x, c.b0);
+			s1 = vmls_n_f32(vmla_n_f32(s2, x, c.b1), y, c.a1);
+			s2 = vmls_n_f32(vmul_n_f32(x, c.b2), y, c.a2);
+			vst1_f32(lr + 2*i, y);
+		}
+		vst1_f32(state, s1);
+		vst1_f32(state + 2, s2);
+	}
+	#endif
+
+	//(no SIMD: one channel at a time)
+	if (i < count) {
+		for (uint32_t ch = 0; ch < 2; ++ch) {
+			float s1 = state[ch], s2 = state[2 + ch];
+			for (uint32_t j = i; j < count; ++j) {
+				float x = lr[2*j + ch];
+				float y = c.b0 * x + s1;
+				s1 = c.b1 * x - c.a1 * y + s2;
+				s2 = c.b2 * x - c.a2 * y;
+				lr[2*j + ch] = y;
+			}
+			state[ch] = s1;
+			state[2 + ch] = s2;
+		}
+	}
+
+	//(a decaying filter eventually reaches denormal values, which are very slow on some processors)
+	for (uint32_t k = 0; k < 4; ++k) {
+		if (std::abs(state[k]) < 1e-15f) state[k] = 0.0f;
+	}
+}
+
+void biquad_channels(BiquadCoefficients const &c, float *state, uint32_t count, uint32_t channels, float *samples) {
+	assert(channels % 2 == 0 && channels <= MAX_MIX_CHANNELS);
+	if (channels == 2) {
+		biquad_stereo(c, state, count, samples);
+		return;
+	}
+	float *s1_state = state;
+	float *s2_state = state + channels;
+
+	//(each channel is independent, so filter groups of channels through the whole block in turn)
+	uint32_t ch = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //four channels in parallel (then the last two, in the low two lanes):
+		__m128 const b0 = _mm_set1_ps(c.b0), b1 = _mm_set1_ps(c.b1), b2 = _mm_set1_ps(c.b2);
+		__m128 const a1 = _mm_set1_ps(c.a1), a2 = _mm_set1_ps(c.a2);
+		for (; ch < channels; ch += 4) {
+			bool pair = (ch + 4 > channels);
+			float s[8] = {};
+			std::copy(s1_state + ch, s1_state + ch + (pair ? 2 : 4), s);
+			std::copy(s2_state + ch, s2_state + ch + (pair ? 2 : 4), s + 4);
+			__m128 s1 = _mm_loadu_ps(s);
+			__m128 s2 = _mm_loadu_ps(s + 4);
+			for (uint32_t i = 0; i < count; ++i) {
+				float *frame = samples + channels*i + ch;
+				__m128 x = (pair ? _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast< __m64 const * >(frame)) : _mm_loadu_ps(frame));
+				__m128 y = _mm_add_ps(_mm_mul_ps(b0, x), s1);
+				s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), s2);
+				s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+				if (pair) _mm_storel_pi(reinterpret_cast< __m64 * >(frame), y);
+				else _mm_storeu_ps(frame, y);
+			}
+			_mm_storeu_ps(s, s1);
+			_mm_storeu_ps(s + 4, s2);
+			std::copy(s, s + (pair ? 2 : 4), s1_state + ch);
+			std::copy(s + 4, s + 4 + (pair ? 2 : 4), s2_state + ch);
+		}
+	}
+	#elif defined(MIX_KERNELS_NEON)
+	{ //two channels in parallel:
+		for (; ch < channels; ch += 2) {
+			float32x2_t s1 = vld1_f32(s1_state + ch);
+			float32x2_t s2 = vld1_f32(s2_state + ch);
+			for (uint32_t i = 0; i < count; ++i) {
+				float *frame = samples + channels*i + ch;
+				float32x2_t x = vld1_f32(frame);
+				float32x2_t y = vmla_n_f32(s1, x, c.b0);
+				s1 = vmls_n_f32(vmla_n_f32(s2, x, c.b1), y, c.a1);
+				s2 = vmls_n_f32(vmul_n_f32(x, c.b2), y, c.a2);
+				vst1_f32(frame, y);
+			}
+			vst1_f32(s1_state + ch, s1);
+			vst1_f32(s2_state + ch, s2);
+		}
+	}
+	#endif
+
+	//(no SIMD: one channel at a time)
+	for (; ch < channels; ++ch) {
+		float s1 = s1_state[ch], s2 = s2_state[ch];
+		for (uint32_t i = 0; i < count; ++i) {
+			float x = samples[channels*i + ch];
+			float y = c.b0 * x + s1;
+			s1 = c.b1 * x - c.a1 * y + s2;
+			s2 = c.b2 * x - c.a2 * y;
+			samples[channels*i + ch] = y;
+		}
+		s1_state[ch] = s1;
+		s2_state[ch] = s2;
+	}
+
+	//(a decaying filter eventually reaches denormal values, which are very slow on some processors)
+	for (uint32_t k = 0; k < 2 * channels; ++k) {
+		if (std::abs(state[k]) < 1e-15f) state[k] = 0.0f;
+	}
+}
+
+void fdn_reverb(FDNReverb &reverb, float wet, uint32_t count, float *lr) {
+	uint32_t const mask = reverb.rows - 1;
+	uint32_t position = reverb.position;
+	float const dry = 1.0f - wet;
+	//(a tiny constant added to the feedback keeps the decaying tail out of slow denormal values)
+	constexpr float const GUARD = 1e-18f;
+
+	uint32_t i = 0;
+
+	#if defined(MIX_KERNELS_SSE)
+	{ //the four lines in parallel:
+		__m128 const gain = _mm_loadu_ps(reverb.gain);
+		__m128 const damping = _mm_set1_ps(reverb.damping);
+		__m128 const undamped = _mm_set1_ps(1.0f - reverb.damping);
+		__m128 const half = _mm_set1_ps(0.5f);
+		__m128 const signs_1 = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+		__m128 const signs_2 = _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f);
+		__m128 const guard = _mm_set1_ps(GUARD);
+		__m128 filter = _mm_loadu_ps(reverb.filter);
+		for (; i < count; ++i) {
+			float const *lines = reverb.lines;
+			__m128 delayed = _mm_setr_ps(
+				lines[((position - reverb.length[0]) & mask) * 4 + 0],
+				lines[((position - reverb.length[1]) & mask) * 4 + 1],
+				lines[((position - reverb.length[2]) & mask) * 4 + 2],
+				lines[((position - reverb.length[3]) & mask) * 4 + 3]
+			);
+			filter = _mm_add_ps(_mm_mul_ps(delayed, undamped), _mm_mul_ps(filter, damping));
+
+			//Hadamard matrix (scaled by 1/2, so it is orthonormal) as two butterfly stages:
+			__m128 g = _mm_mul_ps(filter, gain); //a b c d
+			__m128 h = _mm_add_ps(_mm_shuffle_ps(g, g, _MM_SHUFFLE(2,2,0,0)), _mm_mul_ps(_mm_shuffle_ps(g, g, _MM_SHUFFLE(3,3,1,1)), signs_1)); //a+b a-b c+d c-d
+			h = _mm_add_ps(_mm_shuffle_ps(h, h, _MM_SHUFFLE(1,0,1,0)), _mm_mul_ps(_mm_shuffle_ps(h, h, _MM_SHUFFLE(3,2,3,2)), signs_2));
+			h = _mm_mul_ps(h, half);
+
+			__m128 in = _mm_setr_ps(lr[2*i+0], lr[2*i+0], lr[2*i+1], lr[2*i+1]);
+			_mm_storeu_ps(reverb.lines + position * 4, _mm_add_ps(_mm_add_ps(h, _mm_mul_ps(in, half)), guard));
+			position = (position + 1) & mask;
+
+			float f[4];
+			_mm_storeu_ps(f, filter);
+			lr[2*i+0] = dry * lr[2*i+0] + wet * 0.5f * (f[0] + f[2]);
+			lr[2*i+1] = dry * lr[2*i+1] + wet * 0.5f * (f[1] + f[3]);
+		}
+		_mm_storeu_ps(reverb.filter, filter);
+	}
+	#endif
+
+	//(no SIMD: one line at a time)
+	for (; i < count; ++i) {
+		float *f = reverb.filter;
+		float g[4];
+		for (uint32_t k = 0; k < 4; ++k) {
+			float delayed = reverb.lines[((position - reverb.length[k]) & mask) * 4 + k];
+			f[k] = delayed * (1.0f - reverb.damping) + f[k] * reverb.damping;
+			g[k] = f[k] * reverb.gain[k];
+		}
+		float *row = reverb.lines + position * 4;
+		row[0] = 0.5f * (g[0] + g[1] + g[2] + g[3]) + 0.5f * lr[2*i+0] + GUARD;
+		row[1] = 0.5f * (g[0] - g[1] + g[2] - g[3]) + 0.5f * lr[2*i+0] + GUARD;
+		row[2] = 0.5f * (g[0] + g[1] - g[2] - g[3]) + 0.5f * lr[2*i+1] + GUARD;
+		row[3] = 0.5f * (g[0] - g[1] - g[2] + g[3]) + 0.5f * lr[2*i+1] + GUARD;
+		position = (position + 1) & mask;
+
+		lr[2*i+0] = dry * lr[2*i+0] + wet * 0.5f * (f[0] + f[2]);
+		lr[2*i+1] = dry * lr[2*i+1] + wet * 0.5f * (f[1] + f[3]);
+	}
+
+	reverb.position = position;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+/*
+ * Block-processing kernels used by the audio mixer in Sound.cpp.
+ *
+ * Uses SSE on x86-64 (AVX if the compiler is allowed to use it), NEON on
+ *  64-bit ARM, and plain loops elsewhere; all versions produce the same
+ *  results up to floating-point rounding.
+ *
+ */
+
+#include <cstdint>
+
+//add 'count' mono samples from 'src' into interleaved stereo (LRLRLR...) 'dst',
+// scaled by gains that start at (left, right) and change by (left_step, right_step) every sample:
+//  dst[2*i+0] += src[i] * (left + i * left_step)
+//  dst[2*i+1] += src[i] * (right + i * right_step)
+void mix_mono_to_stereo(float const *src, uint32_t count,
+	float left, float right, float left_step, float right_step,
+	float *dst);
+
+//most interleaved channels the multichannel kernels below handle (7.1 output):
+constexpr uint32_t const MAX_MIX_CHANNELS = 8;
+
+//add 'count' mono samples from 'src' into 'dst' of 'channels' interleaved channels (an even number, at most MAX_MIX_CHANNELS),
+// scaled by per-channel gains that start at 'gains' and change by 'gain_steps' every sample:
+//  dst[channels*i+c] += src[i] * (gains[c] + i * gain_steps[c])
+// (for two channels, this is mix_mono_to_stereo)
+void mix_mono_to_channels(float const *src, uint32_t count, uint32_t channels,
+	float const *gains, float const *gain_steps,
+	float *dst);
+
+//average interleaved stereo (LRLRLR...) 'src' down to 'count' mono samples in 'dst':
+//  dst[i] = 0.5 * (src[2*i+0] + src[2*i+1])
+void downmix_stereo_to_mono(float const *src, uint32_t count, float *dst);
+
+//convert 'count' 16-bit samples from 'src' to floating-point samples in [-1,1) in 'dst':
+//  dst[i] = src[i] / 32768
+void int16_to_float(int16_t const *src, uint32_t count, float *dst);
+
+//...the same, averaging 'count' interleaved stereo 16-bit frames down to mono:
+//  dst[i] = (src[2*i+0] + src[2*i+1]) / 65536
+void int16_stereo_to_mono(int16_t const *src, uint32_t count, float *dst);
+
+//equal-power panning gains for 'count' pan amounts (-1 == hard left, 1 == hard right; clamped to that range):
+//  left[i] = cos(pi/4 * (pan[i] + 1))
+//  right[i] = sin(pi/4 * (pan[i] + 1))
+// (sin and cos are approximated by polynomials accurate to about 1e-6)
+void equal_power_pan(float const *pan, uint32_t count, float *left, float *right);
+
+//panning gains for 'count' sources at (x[i], y[i], z[i]) heard by a listener at 'listener' whose right is
+// the unit vector 'listener_right' -- pans by direction (as equal_power_pan) and attenuates by distance:
+//  left[i], right[i] = equal_power_pan(dot(listener_right, to) / |to|) / (1 + |to| / half_radius[i])
+//   where to = (x[i], y[i], z[i]) - listener
+// (a source exactly at the listener gets gains of sqrt(2))
+void spatialize(float const *x, float const *y, float const *z, float const *half_radius, uint32_t count,
+	float const listener[3], float const listener_right[3],
+	float *left, float *right);
+
+//panning gains for 'count' sources (as spatialize) over the speakers of 'layout' by vector-base amplitude panning (after Pulkki):
+// each source's direction, flattened onto the listener's horizontal plane, is panned between the two neighboring speakers
+// on either side of it, with gains that sum to unit power; directions out of the plane (above or below) spread toward
+// all speakers equally. Gains are then attenuated by distance (as spatialize).
+//'gains[c]' receives the 'count' gains for output channel c (channels without a speaker direction, like LFE, get 0).
+// (a source exactly at the listener gets the same total power as spatialize gives it, spread over every speaker)
+// (a plain loop on every platform -- it runs once per voice per control period, not once per sample)
+struct VBAPLayout {
+	uint32_t channels = 0; //number of output channels (including ones with no speaker direction)
+	uint32_t speakers = 0; //number of channels with a speaker direction
+	uint32_t pairs = 0; //neighboring speakers (by azimuth), each with the inverse of the matrix of their direction vectors:
+	uint32_t pair_channels[MAX_MIX_CHANNELS][2];
+	float pair_inverse[MAX_MIX_CHANNELS][4];
+};
+//layout for speakers at 'azimuths' (one per output channel; degrees clockwise from straight ahead, so 90 is to the right;
+// NaN for a channel with no direction); needs at least three speakers, no two more than 180 degrees apart:
+VBAPLayout vbap_layout(uint32_t channels, float const *azimuths);
+void vbap_spatialize(float const *x, float const *y, float const *z, float const *half_radius, uint32_t count,
+	float const listener[3], float const listener_right[3], float const listener_up[3], VBAPLayout const &layout,
+	float *const *gains);
+
+//add interleaved stereo 'src' into interleaved stereo 'dst', scaled by a gain that starts at 'gain' and changes by 'gain_step' every sample:
+//  dst[2*i+0] += src[2*i+0] * (gain + i * gain_step)
+//  dst[2*i+1] += src[2*i+1] * (gain + i * gain_step)
+void mix_stereo(float const *src, uint32_t count, float gain, float gain_step, float *dst);
+
+//...the same, for 'channels' interleaved channels (an even number, at most MAX_MIX_CHANNELS):
+//  dst[channels*i+c] += src[channels*i+c] * (gain + i * gain_step)
+// (for two channels, this is mix_stereo)
+void mix_channels(float const *src, uint32_t count, uint32_t channels, float gain, float gain_step, float *dst);
+
+//one-pole low-pass filter 'count' mono samples in place (coefficient in (0,1]: 1 passes everything),
+// with '*state' (zero to start) carried over between calls:
+//  *state += coefficient * (samples[i] - *state); samples[i] = *state
+// (each output depends on the previous one, so this is a plain loop on every platform)
+void one_pole_low_pass(float *samples, uint32_t count, float coefficient, float *state);
+//coefficient for a one-pole low-pass with a -3dB 'cutoff' (Hz) at sampling rate 'rate':
+float one_pole_coefficient(float cutoff, float rate);
+
+//biquad filter coefficients (Robert Bristow-Johnson's "Audio EQ Cookbook" designs, normalized so a0 == 1):
+struct BiquadCoefficients {
+	float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+	float a1 = 0.0f, a2 = 0.0f;
+};
+//12dB/octave low-pass and high-pass with a -3dB 'cutoff' (Hz) at sampling rate 'rate' ('q' of 0.7071 has no resonant peak):
+BiquadCoefficients biquad_low_pass(float cutoff, float q, float rate);
+BiquadCoefficients biquad_high_pass(float cutoff, float q, float rate);
+
+//run interleaved stereo 'lr' through a biquad filter in place (transposed direct form II; left and right in parallel),
+// with 'state' (four floats, zero to start) carried over between calls:
+//  y = b0 * x + s1; s1 = b1 * x - a1 * y + s2; s2 = b2 * x - a2 * y
+void biquad_stereo(BiquadCoefficients const &coefficients, float state[4], uint32_t count, float *lr);
+
+//...the same, for 'count' frames of 'channels' interleaved channels (an even number, at most MAX_MIX_CHANNELS),
+// with 'state' (2 * channels floats: every channel's s1, then every channel's s2) -- so, for two channels, this is biquad_stereo:
+void biquad_channels(BiquadCoefficients const &coefficients, float *state, uint32_t count, uint32_t channels, float *samples);
+
+//feedback delay network reverb (after Jot): four delay lines, each low-pass filtered (by 'damping' in [0,1) -- more is darker),
+// scaled by 'gain' (which sets the decay time), mixed by a 4x4 Hadamard matrix, and fed back along with the input.
+//The four lines are processed in parallel (one per SIMD lane), so 'lines' interleaves them:
+// it is a ring of 'rows' (a power of two) rows of four floats, and 'position' is the next row to write.
+//The left input feeds lines 0 and 1 and the right lines 2 and 3; the left output comes from lines 0 and 2 and the right from 1 and 3.
+struct FDNReverb {
+	float *lines = nullptr;
+	uint32_t rows = 0;
+	uint32_t position = 0;
+	uint32_t length[4] = {1, 1, 1, 1}; //(each at most rows)
+	float gain[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	float damping = 0.0f;
+	float filter[4] = {0.0f, 0.0f, 0.0f, 0.0f}; //(low-pass state)
+};
+//run interleaved stereo 'lr' through 'reverb' in place, keeping 1 - 'wet' of the dry signal:
+//  lr = (1 - wet) * lr + wet * reverb(lr)
+void fdn_reverb(FDNReverb &reverb, float wet, uint32_t count, float *lr);
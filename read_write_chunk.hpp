@@ -1,5 +1,7 @@
 #pragma once
 
+#include "StartupProfile.hpp"
+
 #include <iostream>
 #include <vector>
 #include <stdexcept>
@@ -38,6 +40,8 @@ void read_chunk(std::istream &from, std::string const &magic, std::vector< T > *
 	if (!from.read(reinterpret_cast< char * >(&to[0]), to.size() * sizeof(T))) {
 		throw std::runtime_error("Failed to read chunk data.");
 	}
+
+	StartupProfile::note_bytes_read(sizeof(header) + header.size);
 }
 
 
@@ -0,0 +1,478 @@
+#include "Sound.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//This file renders a scripted timeline of Sound:: calls with the offline mixer (no audio device needed)
+// and reports how long each block took to mix:
+// $ ./render-audio [--block samples] [--channels count] <timeline.txt> [out.wav]
+//('--block' sets the number of samples mixed per block; see Sound::set_block_samples)
+//('--channels' mixes 2 (the default), 4, 6 (5.1), or 8 (7.1) output channels; see Sound::set_output_channels)
+//Timelines are text, one command per line ('#' starts a comment); times are in seconds:
+//  sample <name> <file> [float|int16|adpcm|stream [bus]] -- load a '.wav' or '.opus' file (relative to the timeline)
+//  bus <name> [parent]                          -- add a bus (see Sound::add_bus) for samples to play on
+//  effect <bus> lowpass|highpass <frequency> [q] -- add an effect to a bus
+//  effect <bus> reverb [room_size [decay [damping [wet]]]]
+//  effect <bus> convolution <ir.wav> [wet]        -- (impulse-response reverb; see Sound::ImpulseResponse)
+//  send <bus> <to_bus> <level>                  -- see Sound::set_bus_send
+//  distance_low_pass <half_cutoff_distance>     -- see Sound::set_distance_low_pass
+//  hrtf <file> [max_voices [cpu_fraction]]      -- render 3D samples binaurally (see Sound::load_hrtf and Sound::set_hrtf_budget;
+//                                                  the listener is at the origin, facing +y with +z up; stereo output only)
+//  <time> play <sample> <id> [volume [pan]]     -- start playing (or looping) a sample;
+//  <time> loop <sample> <id> [volume [pan]]     --  'id' names the playback for later commands
+//  <time> play_3D <sample> <id> <volume> <x> <y> <z> [half_volume_radius]
+//  <time> loop_3D <sample> <id> <volume> <x> <y> <z> [half_volume_radius]
+//  <time> set_position <id> <x> <y> <z> [ramp]
+//  <time> set_rate <id> <rate> [ramp]
+//  <time> stop <id> [ramp]
+//  <time> end                                   -- stop rendering (otherwise, renders until everything has stopped)
+//Playback starts at exactly its time (see Sound::play_at); other commands take effect at the start of the first block
+// at or after their time (just as with the audio callback).
+//Output is the same on every run; with streamed samples, though, block times include waiting for the decoder thread.
+
+//same as Sound.cpp:
+constexpr uint32_t const AUDIO_RATE = 48000;
+
+struct Event {
+	double time = 0.0;
+	std::string command;
+	std::string sample, id;
+	std::vector< float > args;
+	uint32_t line = 0;
+};
+
+struct Timeline {
+	std::map< std::string, std::unique_ptr< Sound::Sample > > samples;
+	std::map< std::string, uint32_t > buses = { { "master", Sound::MASTER_BUS } };
+	std::map< std::string, uint32_t > sample_buses; //(bus each sample plays on, if not the master bus)
+	std::map< uint32_t, std::vector< Sound::Effect > > effects;
+	std::vector< std::unique_ptr< Sound::ImpulseResponse > > impulse_responses; //(used by 'effects')
+	bool has_hrtf = false;
+	std::vector< Event > events; //(sorted by time)
+	bool has_end = false;
+	double end = 0.0;
+};
+
+Timeline load_timeline(std::string const &filename) {
+	std::ifstream file(filename, std::ios::binary);
+	if (!file) throw std::runtime_error("Failed to open timeline '" + filename + "'.");
+
+	//sample files are found relative to the timeline:
+	std::string dir = filename.substr(0, filename.find_last_of("/\\") + 1);
+
+	Timeline timeline;
+	std::string line;
+	uint32_t line_number = 0;
+	while (std::getline(file, line)) {
+		line_number += 1;
+		line = line.substr(0, line.find('#'));
+		std::istringstream str(line);
+		auto error = [&](std::string const &message) {
+			return std::runtime_error(filename + ":" + std::to_string(line_number) + ": " + message);
+		};
+
+		std::string first;
+		if (!(str >> first)) continue; //(blank line)
+
+		//helper: read the name of a bus that has already been added:
+		auto read_bus = [&](std::istream &from) {
+			std::string name;
+			if (!(from >> name)) throw error("expecting a bus name.");
+			auto f = timeline.buses.find(name);
+			if (f == timeline.buses.end()) throw error("bus '" + name + "' hasn't been added (with a 'bus' line) yet.");
+			return f->second;
+		};
+
+		if (first == "sample") {
+			std::string name, path, encoding = "float";
+			if (!(str >> name >> path)) throw error("expecting 'sample <name> <file> [encoding [bus]]'.");
+			str >> encoding;
+			if (timeline.samples.count(name)) throw error("sample '" + name + "' is already defined.");
+			if (path[0] != '/') path = dir + path;
+
+			std::unique_ptr< Sound::Sample > sample;
+			if (encoding == "stream") {
+				sample = std::make_unique< Sound::Sample >(path, Sound::Sample::Stream());
+			} else {
+				Sound::Sample::Encoding enc;
+				if (encoding == "float") enc = Sound::Sample::Float;
+				else if (encoding == "int16") enc = Sound::Sample::Int16;
+				else if (encoding == "adpcm") enc = Sound::Sample::ADPCM;
+				else throw error("unknown encoding '" + encoding + "' (expecting float, int16, adpcm, or stream).");
+				sample = std::make_unique< Sound::Sample >(path, enc);
+			}
+			std::string extra;
+			if (str >> extra) {
+				std::istringstream bus(extra);
+				timeline.sample_buses[name] = read_bus(bus);
+			}
+			timeline.samples.emplace(name, std::move(sample));
+			continue;
+		} else if (first == "bus") {
+			std::string name;
+			if (!(str >> name)) throw error("expecting 'bus <name> [parent]'.");
+			if (timeline.buses.count(name)) throw error("bus '" + name + "' is already defined.");
+			uint32_t parent = Sound::MASTER_BUS;
+			std::string extra;
+			if (str >> extra) {
+				std::istringstream bus(extra);
+				parent = read_bus(bus);
+			}
+			timeline.buses.emplace(name, Sound::add_bus(parent));
+			continue;
+		} else if (first == "effect") {
+			uint32_t bus = read_bus(str);
+			std::string type, path;
+			str >> type;
+			if (type == "convolution" && !(str >> path)) throw error("expecting 'effect <bus> convolution <ir.wav> [wet]'.");
+			std::vector< float > values;
+			for (float value; str >> value; ) {
+				values.emplace_back(value);
+			}
+			if (type == "lowpass" || type == "highpass") {
+				if (values.size() < 1 || values.size() > 2) throw error("expecting 'effect <bus> " + type + " <frequency> [q]'.");
+				float q = (values.size() > 1 ? values[1] : 0.7071f);
+				timeline.effects[bus].emplace_back(type == "lowpass" ? Sound::Effect::low_pass(values[0], q) : Sound::Effect::high_pass(values[0], q));
+			} else if (type == "reverb") {
+				if (values.size() > 4) throw error("expecting 'effect <bus> reverb [room_size [decay [damping [wet]]]]'.");
+				Sound::Effect effect = Sound::Effect::reverb();
+				float *parameters[4] = { &effect.room_size, &effect.decay, &effect.damping, &effect.wet };
+				for (uint32_t i = 0; i < values.size(); ++i) {
+					*parameters[i] = values[i];
+				}
+				timeline.effects[bus].emplace_back(effect);
+			} else if (type == "convolution") {
+				if (values.size() > 1) throw error("expecting 'effect <bus> convolution <ir.wav> [wet]'.");
+				if (path[0] != '/') path = dir + path;
+				timeline.impulse_responses.emplace_back(std::make_unique< Sound::ImpulseResponse >(path));
+				timeline.effects[bus].emplace_back(Sound::Effect::convolution(*timeline.impulse_responses.back(), values.empty() ? 1.0f : values[0]));
+			} else {
+				throw error("expecting 'effect <bus> lowpass|highpass|reverb|convolution ...'.");
+			}
+			continue;
+		} else if (first == "send") {
+			uint32_t bus = read_bus(str);
+			uint32_t to = read_bus(str);
+			float level;
+			if (!(str >> level)) throw error("expecting 'send <bus> <to_bus> <level>'.");
+			Sound::set_bus_send(bus, to, level);
+			continue;
+		} else if (first == "distance_low_pass") {
+			float distance;
+			if (!(str >> distance)) throw error("expecting 'distance_low_pass <half_cutoff_distance>'.");
+			Sound::set_distance_low_pass(distance);
+			continue;
+		} else if (first == "hrtf") {
+			std::string path;
+			if (!(str >> path)) throw error("expecting 'hrtf <file> [max_voices [cpu_fraction]]'.");
+			if (path[0] != '/') path = dir + path;
+			uint32_t max_voices = 16;
+			float cpu_fraction = 1.0f;
+			if (str >> max_voices) str >> cpu_fraction;
+			Sound::load_hrtf(path);
+			Sound::set_hrtf_budget(max_voices, cpu_fraction);
+			timeline.has_hrtf = true;
+			continue;
+		}
+
+		Event event;
+		event.line = line_number;
+		try {
+			event.time = std::stod(first);
+		} catch (std::exception &) {
+			throw error("expecting 'sample' or a time, got '" + first + "'.");
+		}
+		if (!(event.time >= 0.0)) throw error("time must not be negative.");
+		if (!(str >> event.command)) throw error("expecting a command after the time.");
+
+		//command arguments -- names, then numbers (the first 'required' of which must be present):
+		uint32_t required = 0;
+		uint32_t allowed = 0;
+		if (event.command == "play" || event.command == "loop") {
+			if (!(str >> event.sample >> event.id)) throw error("expecting '" + event.command + " <sample> <id> [volume [pan]]'.");
+			event.args = { 1.0f, 0.0f };
+			allowed = 2;
+		} else if (event.command == "play_3D" || event.command == "loop_3D") {
+			if (!(str >> event.sample >> event.id)) throw error("expecting '" + event.command + " <sample> <id> <volume> <x> <y> <z> [half_volume_radius]'.");
+			event.args = { 1.0f, 0.0f, 0.0f, 0.0f, std::numeric_limits< float >::infinity() };
+			required = 4;
+			allowed = 5;
+		} else if (event.command == "set_position") {
+			if (!(str >> event.id)) throw error("expecting 'set_position <id> <x> <y> <z> [ramp]'.");
+			event.args = { 0.0f, 0.0f, 0.0f, 1.0f / 60.0f };
+			required = 3;
+			allowed = 4;
+		} else if (event.command == "set_rate") {
+			if (!(str >> event.id)) throw error("expecting 'set_rate <id> <rate> [ramp]'.");
+			event.args = { 1.0f, 1.0f / 60.0f };
+			required = 1;
+			allowed = 2;
+		} else if (event.command == "stop") {
+			if (!(str >> event.id)) throw error("expecting 'stop <id> [ramp]'.");
+			event.args = { 1.0f / 60.0f };
+			allowed = 1;
+		} else if (event.command == "end") {
+			if (!timeline.has_end || event.time < timeline.end) timeline.end = event.time;
+			timeline.has_end = true;
+			continue;
+		} else {
+			throw error("unknown command '" + event.command + "'.");
+		}
+		if (!event.sample.empty() && !timeline.samples.count(event.sample)) {
+			throw error("sample '" + event.sample + "' hasn't been defined (with a 'sample' line) yet.");
+		}
+		uint32_t given = 0;
+		for (float value; given < allowed && (str >> value); ++given) {
+			event.args[given] = value;
+		}
+		str.clear(); //(reading numbers stops at the end of the line or at something that isn't a number)
+		std::string extra;
+		if (given < required || (str >> extra)) {
+			throw error("wrong arguments for '" + event.command + "'.");
+		}
+
+		timeline.events.emplace_back(event);
+	}
+
+	for (auto const &bus_effects : timeline.effects) {
+		Sound::set_bus_effects(bus_effects.first, bus_effects.second);
+	}
+
+	std::stable_sort(timeline.events.begin(), timeline.events.end(), [](Event const &a, Event const &b) {
+		return a.time < b.time;
+	});
+
+	//without an 'end', every loop needs a later 'stop' (or rendering would never finish):
+	if (!timeline.has_end) {
+		std::map< std::string, Event const * > looping;
+		for (auto const &event : timeline.events) {
+			if (event.command == "loop" || event.command == "loop_3D") looping[event.id] = &event;
+			else if (event.command == "stop") looping.erase(event.id);
+		}
+		if (!looping.empty()) {
+			Event const &event = *looping.begin()->second;
+			throw std::runtime_error(filename + ":" + std::to_string(event.line) + ": '" + event.id + "' loops forever; add a 'stop' or an 'end'.");
+		}
+	}
+
+	return timeline;
+}
+
+void write_wav(std::string const &filename, std::vector< float > const &samples, uint32_t channels) {
+	std::ofstream out(filename, std::ios::binary);
+	auto u32 = [&](uint32_t v) {
+		char b[4] = { char(v), char(v >> 8), char(v >> 16), char(v >> 24) };
+		out.write(b, 4);
+	};
+	auto u16 = [&](uint16_t v) {
+		char b[2] = { char(v), char(v >> 8) };
+		out.write(b, 2);
+	};
+	uint32_t data_bytes = uint32_t(samples.size() * sizeof(float));
+
+	//32-bit float (WAVE_FORMAT_IEEE_FLOAT), so the file holds exactly what the mixer produced;
+	// more than two channels need WAVE_FORMAT_EXTENSIBLE, to say which speaker each is for:
+	bool extensible = (channels > 2);
+	uint32_t fmt_bytes = (extensible ? 40 : 18);
+	out.write("RIFF", 4); u32(4 + (8 + fmt_bytes) + (8 + 4) + (8 + data_bytes)); out.write("WAVE", 4);
+	out.write("fmt ", 4); u32(fmt_bytes);
+	u16(extensible ? 0xfffe : 3); //format: extensible or IEEE float
+	u16(uint16_t(channels)); //channels
+	u32(AUDIO_RATE); //frames per second
+	u32(AUDIO_RATE * channels * sizeof(float)); //bytes per second
+	u16(uint16_t(channels * sizeof(float))); //bytes per frame
+	u16(32); //bits per sample
+	if (extensible) {
+		u16(22); //(extension size)
+		u16(32); //valid bits per sample
+		//speakers (in the same order as Sound::set_output_channels):
+		// front left/right (0x3), center (0x4), LFE (0x8), back left/right (0x30), side left/right (0x600)
+		u32(channels == 4 ? 0x33 : (channels == 6 ? 0x3f : 0x63f));
+		//sub-format: KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
+		char const guid[16] = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, char(0x80), 0x00, 0x00, char(0xaa), 0x00, 0x38, char(0x9b), 0x71 };
+		out.write(guid, 16);
+	} else {
+		u16(0); //(no extension)
+	}
+	out.write("fact", 4); u32(4); u32(uint32_t(samples.size() / channels));
+	out.write("data", 4); u32(data_bytes);
+	for (float s : samples) {
+		uint32_t bits;
+		static_assert(sizeof(bits) == sizeof(s), "float is 32 bits");
+		std::memcpy(&bits, &s, sizeof(bits));
+		u32(bits);
+	}
+	if (!out) throw std::runtime_error("Failed to write '" + filename + "'.");
+}
+
+int main(int argc, char **argv) {
+	uint32_t block_samples = Sound::DEFAULT_BLOCK_SAMPLES;
+	uint32_t channels = 2;
+	std::vector< std::string > args;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--block" && i + 1 < argc) {
+			block_samples = uint32_t(std::atoi(argv[i+1]));
+			i += 1;
+		} else if (arg == "--channels" && i + 1 < argc) {
+			channels = uint32_t(std::atoi(argv[i+1]));
+			i += 1;
+		} else {
+			args.emplace_back(arg);
+		}
+	}
+	if (args.size() < 1 || args.size() > 2 || block_samples < Sound::MIN_BLOCK_SAMPLES || block_samples > Sound::MAX_BLOCK_SAMPLES
+	 || !(channels == 2 || channels == 4 || channels == 6 || channels == 8)) {
+		std::cerr << "Usage:\n\t./render-audio [--block samples] [--channels count] <timeline.txt> [out.wav]\n"
+		          << "\t(block size from " << Sound::MIN_BLOCK_SAMPLES << " to " << Sound::MAX_BLOCK_SAMPLES << "; default " << Sound::DEFAULT_BLOCK_SAMPLES << ")\n"
+		          << "\t(channels 2, 4, 6, or 8; default 2)" << std::endl;
+		return 1;
+	}
+	std::string timeline_file = args[0];
+	std::string wav_file = (args.size() > 1 ? args[1] : "");
+
+	try {
+		Sound::init_offline(channels);
+
+		Timeline timeline = load_timeline(timeline_file);
+
+		std::map< std::string, std::shared_ptr< Sound::PlayingSample > > playing; //(most recent playback with each id)
+		std::vector< std::shared_ptr< Sound::PlayingSample > > started; //(every playback, to know when all have finished)
+
+		//plays are scheduled during the block before the one they start in; other commands wait (in order) until their time:
+		struct Waiting {
+			Event const *event;
+			std::shared_ptr< Sound::PlayingSample > handle;
+		};
+		std::vector< Waiting > waiting;
+		uint32_t next_waiting = 0;
+
+		auto run = [&](Event const &event) {
+			auto const &a = event.args;
+			if (event.command == "play" || event.command == "loop" || event.command == "play_3D" || event.command == "loop_3D") {
+				Sound::Sample const &sample = *timeline.samples.at(event.sample);
+				uint64_t when = uint64_t(std::llround(event.time * AUDIO_RATE));
+				std::shared_ptr< Sound::PlayingSample > handle;
+				if (event.command == "play") handle = Sound::play_at(sample, when, a[0], a[1]);
+				else if (event.command == "loop") handle = Sound::loop_at(sample, when, a[0], a[1]);
+				else if (event.command == "play_3D") handle = Sound::play_3D_at(sample, when, a[0], glm::vec3(a[1], a[2], a[3]), a[4]);
+				else handle = Sound::loop_3D_at(sample, when, a[0], glm::vec3(a[1], a[2], a[3]), a[4]);
+				auto bus = timeline.sample_buses.find(event.sample);
+				if (bus != timeline.sample_buses.end()) handle->set_bus(bus->second);
+				playing[event.id] = handle;
+				started.emplace_back(handle);
+			} else {
+				auto f = playing.find(event.id);
+				if (f == playing.end()) {
+					std::cerr << "WARNING: " << timeline_file << ":" << event.line << ": '" << event.id << "' hasn't been played; ignoring '" << event.command << "'." << std::endl;
+					return;
+				}
+				waiting.emplace_back(Waiting{ &event, f->second });
+			}
+		};
+		auto send = [&](Waiting const &w) {
+			auto const &a = w.event->args;
+			if (w.event->command == "set_position") w.handle->set_position(glm::vec3(a[0], a[1], a[2]), a[3]);
+			else if (w.event->command == "set_rate") w.handle->set_rate(a[0], a[1]);
+			else if (w.event->command == "stop") w.handle->stop(a[0]);
+		};
+
+		std::vector< float > output;
+		std::vector< float > block(channels * block_samples);
+		std::vector< double > block_times;
+		auto render_start = std::chrono::steady_clock::now();
+
+		uint32_t next_event = 0;
+		for (uint64_t frame = 0; /* until done */; frame += block_samples) {
+			double time = double(frame) / AUDIO_RATE;
+			//(commands sent now are applied at the start of the next render(), just as they would be by the audio callback)
+			while (next_event < timeline.events.size() && timeline.events[next_event].time * AUDIO_RATE < double(frame + block_samples)) {
+				run(timeline.events[next_event]);
+				next_event += 1;
+			}
+			while (next_waiting < waiting.size() && waiting[next_waiting].event->time <= time) {
+				send(waiting[next_waiting]);
+				next_waiting += 1;
+			}
+			Sound::update();
+
+			if (timeline.has_end) {
+				if (time >= timeline.end) break;
+			} else if (next_event == timeline.events.size() && next_waiting == waiting.size()) {
+				bool all_stopped = true;
+				for (auto const &handle : started) {
+					if (!handle->stopped()) all_stopped = false;
+				}
+				if (all_stopped) break;
+			}
+
+			auto before = std::chrono::steady_clock::now();
+			Sound::render(block.data(), block_samples);
+			auto after = std::chrono::steady_clock::now();
+			block_times.emplace_back(std::chrono::duration< double >(after - before).count());
+
+			output.insert(output.end(), block.begin(), block.end());
+		}
+
+		double render_seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - render_start).count();
+		double audio_seconds = double(output.size() / channels) / AUDIO_RATE;
+
+		if (!wav_file.empty()) {
+			write_wav(wav_file, output, channels);
+			std::cout << "Wrote " << audio_seconds << " seconds of audio to '" << wav_file << "'." << std::endl;
+		}
+
+		std::cout << "Rendered " << block_times.size() << " blocks (" << audio_seconds << " seconds) in " << render_seconds
+		          << " seconds (" << (audio_seconds / render_seconds) << "x real time)." << std::endl;
+		if (!block_times.empty()) {
+			double block_seconds = double(block_samples) / AUDIO_RATE;
+			std::sort(block_times.begin(), block_times.end());
+			auto report = [&](std::string const &name, double time) {
+				std::cout << "  " << name << ": " << (time * 1e6) << " us (" << (100.0 * time / block_seconds) << "% of a "
+				          << (block_seconds * 1e3) << " ms block)" << std::endl;
+			};
+			std::cout << "Mixing time per block:" << std::endl;
+			for (double percentile : { 50.0, 90.0, 99.0, 99.9 }) {
+				size_t index = std::min(block_times.size() - 1, size_t(percentile / 100.0 * block_times.size()));
+				std::ostringstream name;
+				name << "p" << percentile;
+				report(name.str(), block_times[index]);
+			}
+			report("max", block_times.back());
+		}
+
+		Sound::Stats stats = Sound::get_stats();
+		std::cout << "Peak output level " << stats.peak << (stats.peak > 1.0f ? " (clipped!)" : "") << "; at most "
+		          << stats.max_active_voices << " samples playing (" << stats.max_real_voices << " mixed) at once." << std::endl;
+		if (timeline.buses.size() > 1 || !timeline.effects.empty()) {
+			std::cout << "Bus effects and mixing time per block:" << std::endl;
+			for (auto const &bus : timeline.buses) {
+				std::cout << "  " << bus.first << ": " << stats.bus_microseconds[bus.second] << " us" << std::endl;
+			}
+		}
+		if (timeline.has_hrtf) {
+			std::cout << "At most " << stats.max_hrtf_voices << " samples rendered binaurally at once, taking " << stats.hrtf_microseconds << " us per block." << std::endl;
+		}
+
+		Sound::shutdown();
+	} catch (std::exception &e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		Sound::shutdown();
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,167 @@
+#include "resample.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define RESAMPLE_SSE
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RESAMPLE_NEON
+#endif
+
+//zeroth-order modified Bessel function of the first kind (for the Kaiser window):
+static double bessel_i0(double x) {
+	double sum = 1.0;
+	double term = 1.0;
+	for (uint32_t k = 1; k < 64; ++k) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+		if (term < sum * 1e-12) break;
+	}
+	return sum;
+}
+
+ResampleFilter::ResampleFilter(uint32_t taps_, uint32_t phases_, float cutoff, float beta) : taps(taps_), phases(phases_) {
+	assert(taps > 0 && taps % 8 == 0 && "kernels process taps eight at a time");
+	assert(phases > 0);
+	coefficients.resize(size_t(phases + 1) * taps);
+
+	constexpr double const PI = 3.14159265358979323846;
+	double const half = double(taps) / 2.0;
+	double const window_scale = 1.0 / bessel_i0(beta);
+	for (uint32_t p = 0; p <= phases; ++p) {
+		double t = double(p) / double(phases);
+		float *row = &coefficients[size_t(p) * taps];
+		double total = 0.0;
+		for (uint32_t k = 0; k < taps; ++k) {
+			//distance (in input samples) from this tap to the output position:
+			double x = double(k) - (half - 1.0) - t;
+			double sinc = (x == 0.0 ? 1.0 : std::sin(2.0 * PI * cutoff * x) / (2.0 * PI * cutoff * x));
+			double r = std::max(0.0, 1.0 - (x / half) * (x / half));
+			double value = 2.0 * cutoff * sinc * bessel_i0(beta * std::sqrt(r)) * window_scale;
+			row[k] = float(value);
+			total += value;
+		}
+		//normalize so each phase passes DC at unit gain (otherwise gain would ripple with position):
+		for (uint32_t k = 0; k < taps; ++k) {
+			row[k] = float(row[k] / total);
+		}
+	}
+}
+
+double resample_block(ResampleFilter const &filter, float const *src, double position, float rate, float rate_step, uint32_t count, float *dst) {
+	uint32_t const taps = filter.taps;
+	float const phases = float(filter.phases);
+
+	for (uint32_t j = 0; j < count; ++j) {
+		size_t base = size_t(position);
+		float phase = float(position - double(base)) * phases;
+		uint32_t p = std::min(uint32_t(phase), filter.phases - 1);
+		float u = phase - float(p); //(interpolation weight between phases p and p+1)
+
+		float const *s = src + base;
+		float const *h0 = &filter.coefficients[size_t(p) * taps];
+		float const *h1 = h0 + taps;
+
+		float sum;
+		#if defined(RESAMPLE_SSE) && defined(__AVX__)
+		{ //eight taps at a time:
+			__m256 const w = _mm256_set1_ps(u);
+			__m256 acc = _mm256_setzero_ps();
+			for (uint32_t k = 0; k < taps; k += 8) {
+				__m256 a = _mm256_loadu_ps(h0 + k);
+				__m256 c = _mm256_add_ps(a, _mm256_mul_ps(w, _mm256_sub_ps(_mm256_loadu_ps(h1 + k), a)));
+				acc = _mm256_add_ps(acc, _mm256_mul_ps(c, _mm256_loadu_ps(s + k)));
+			}
+			__m128 v = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+			v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+			v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+			sum = _mm_cvtss_f32(v);
+		}
+		#elif defined(RESAMPLE_SSE)
+		{ //four taps at a time (two accumulators, to hide add latency):
+			__m128 const w = _mm_set1_ps(u);
+			__m128 acc0 = _mm_setzero_ps();
+			__m128 acc1 = _mm_setzero_ps();
+			for (uint32_t k = 0; k < taps; k += 8) {
+				__m128 a0 = _mm_loadu_ps(h0 + k);
+				__m128 a1 = _mm_loadu_ps(h0 + k + 4);
+				__m128 c0 = _mm_add_ps(a0, _mm_mul_ps(w, _mm_sub_ps(_mm_loadu_ps(h1 + k), a0)));
+				__m128 c1 = _mm_add_ps(a1, _mm_mul_ps(w, _mm_sub_ps(_mm_loadu_ps(h1 + k + 4), a1)));
+				acc0 = _mm_add_ps(acc0, _mm_mul_ps(c0, _mm_loadu_ps(s + k)));
+				acc1 = _mm_add_ps(acc1, _mm_mul_ps(c1, _mm_loadu_ps(s + k + 4)));
+			}
+			__m128 v = _mm_add_ps(acc0, acc1);
+			v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+			v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+			sum = _mm_cvtss_f32(v);
+		}
+		#elif defined(RESAMPLE_NEON)
+		{ //four taps at a time:
+			float32x4_t acc0 = vdupq_n_f32(0.0f);
+			float32x4_t acc1 = vdupq_n_f32(0.0f);
+			for (uint32_t k = 0; k < taps; k += 8) {
+				float32x4_t a0 = vld1q_f32(h0 + k);
+				float32x4_t a1 = vld1q_f32(h0 + k + 4);
+				float32x4_t c0 = vmlaq_n_f32(a0, vsubq_f32(vld1q_f32(h1 + k), a0), u);
+				float32x4_t c1 = vmlaq_n_f32(a1, vsubq_f32(vld1q_f32(h1 + k + 4), a1), u);
+				acc0 = vmlaq_f32(acc0, c0, vld1q_f32(s + k));
+				acc1 = vmlaq_f32(acc1, c1, vld1q_f32(s + k + 4));
+			}
+			sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+		}
+		#else
+		sum = 0.0f;
+		for (uint32_t k = 0; k < taps; ++k) {
+			sum += (h0[k] + u * (h1[k] - h0[k])) * s[k];
+		}
+		#endif
+		dst[j] = sum;
+
+		position += rate;
+		rate += rate_step;
+	}
+	return position;
+}
+
+double resample_position(double position, float rate, float rate_step, uint32_t count) {
+	//(must match the updates in resample_block)
+	for (uint32_t j = 0; j < count; ++j) {
+		position += rate;
+		rate += rate_step;
+	}
+	return position;
+}
+
+void resample(std::vector< float > const &in, uint32_t in_rate, uint32_t out_rate, std::vector< float > *out_) {
+	assert(out_);
+	auto &out = *out_;
+	assert(in_rate > 0 && out_rate > 0);
+
+	//96 taps with a Kaiser window (beta = 9) gives ~90dB stopband attenuation with a transition band of ~0.06 cycles/sample;
+	// center the transition band just below the lower of the two Nyquist frequencies:
+	constexpr uint32_t const TAPS = 96;
+	float nyquist = 0.5f * std::min(1.0f, float(out_rate) / float(in_rate));
+	ResampleFilter filter(TAPS, 512, nyquist - 0.03f * std::min(1.0f, float(out_rate) / float(in_rate)), 9.0f);
+
+	//pad with silence so the filter can be centered on every input sample:
+	std::vector< float > padded(TAPS / 2 - 1, 0.0f);
+	padded.insert(padded.end(), in.begin(), in.end());
+	padded.resize(padded.size() + TAPS / 2 + 2, 0.0f);
+
+	uint64_t count = (uint64_t(in.size()) * out_rate + in_rate - 1) / in_rate;
+	out.resize(size_t(count));
+
+	//work in chunks, restarting each chunk at its exact (rational) position, so rounding in 'rate' can't accumulate:
+	constexpr uint64_t const CHUNK = 4096;
+	float rate = float(double(in_rate) / double(out_rate));
+	for (uint64_t begin = 0; begin < count; begin += CHUNK) {
+		uint64_t numerator = begin * in_rate;
+		uint64_t base = numerator / out_rate;
+		double position = double(numerator % out_rate) / double(out_rate);
+		resample_block(filter, padded.data() + base, position, rate, 0.0f, uint32_t(std::min(CHUNK, count - begin)), out.data() + begin);
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+/*
+ * Windowed-sinc polyphase resampling, used by load_wav (to convert files to
+ *  48kHz) and by the mixer in Sound.cpp (for per-voice playback rate).
+ *
+ * A ResampleFilter tabulates a Kaiser-windowed sinc lowpass at 'phases'
+ *  fractional offsets; resample_block() interpolates linearly between adjacent
+ *  phases, so any (even continuously changing) rate can be used.
+ * The block kernel uses SSE (or AVX) on x86-64, NEON on 64-bit ARM, and plain
+ *  loops elsewhere.
+ *
+ */
+
+#include <cstdint>
+#include <vector>
+
+struct ResampleFilter {
+	//taps: filter length (a multiple of 8); phases: number of fractional offsets tabulated;
+	//cutoff: cutoff (half-amplitude) frequency in cycles per input sample (0.5 is Nyquist; scale by 1 / rate when decimating);
+	//beta: Kaiser window shape (higher == more stopband attenuation, wider transition band)
+	ResampleFilter(uint32_t taps, uint32_t phases, float cutoff, float beta);
+
+	uint32_t taps;
+	uint32_t phases;
+	//(phases + 1) rows of 'taps' coefficients; row p is the filter for a fractional position of p / phases:
+	std::vector< float > coefficients;
+};
+
+//compute 'count' output samples from 'src', starting at fractional position 'position' and
+// advancing by 'rate' input samples per output sample (with 'rate' changing by 'rate_step' every sample):
+//  dst[j] = (band-limited) src at position p_j + (taps/2 - 1), where p_0 = position, p_{j+1} = p_j + rate_j
+// (so src must hold at least floor(p_{count-1}) + taps samples); returns p_count -- the position after the last sample.
+double resample_block(ResampleFilter const &filter, float const *src, double position, float rate, float rate_step, uint32_t count, float *dst);
+
+//the position resample_block() would return (exactly), without computing any samples:
+// (handy for figuring out how much of 'src' a block will need before filling it)
+double resample_position(double position, float rate, float rate_step, uint32_t count);
+
+//resample a whole signal from 'in_rate' to 'out_rate' (e.g., when loading a file) with a high-quality filter:
+// (the signal is treated as silent outside of 'in')
+void resample(std::vector< float > const &in, uint32_t in_rate, uint32_t out_rate, std::vector< float > *out);
@@ -2,6 +2,9 @@
 #include "ShowSceneMode.hpp"
 #include "Load.hpp"
 #include "GL.hpp"
+#include "GLState.hpp"
+#include "GLStats.hpp"
+#include "gl_debug_output.hpp"
 #include "load_save_png.hpp"
 #include "ShowSceneProgram.hpp"
 
@@ -68,6 +71,12 @@ int main(int argc, char **argv) {
 	//On windows, load OpenGL entrypoints: (does nothing on other platforms)
 	init_GL();
 
+	//(GLState's cache describes the state of the current context, so start it fresh for a new one)
+	GLState::invalidate();
+
+	//Report GL errors through a debug message callback, if possible:
+	gl_debug_output_init();
+
 	//Set VSYNC + Late Swap (prevents crazy FPS):
 	if (SDL_GL_SetSwapInterval(-1) != 0) {
 		std::cerr << "NOTE: couldn't set vsync + late swap tearing (" << SDL_GetError() << ")." << std::endl;
@@ -214,6 +223,9 @@ int main(int argc, char **argv) {
 		{ //(3) call the current mode's "draw" function to produce output:
 		
 			Mode::current->draw(drawable_size);
+			GLState::end_frame();
+			GLStats::end_frame();
+			gl_debug_output_poll();
 		}
 
 		//Wait until the recently-drawn frame is shown before doing it all again: